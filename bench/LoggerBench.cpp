@@ -0,0 +1,303 @@
+// LoggerManager 처리량/지연 벤치마크
+//
+// 프로파일별 임시 INI를 만들어 LoggerManager를 초기화한 뒤 여러 스레드에서 로깅하고
+// messages/sec, bytes/sec, 호출당 지연(p50/p99/p99.9/max)을 표와 JSON으로 출력한다.
+//
+// 사용법:
+//   j2_logger_bench [--threads 1,4,16] [--messages 100000] [--msg-size 128]
+//                   [--levels trace:40,debug:20,info:25,warn:10,error:4,critical:1]
+//                   [--profiles files,console,all_only,alerts_only,utc,tz]
+//                   [--async] [--dir bench_logs] [--json result.json]
+//
+// 프로파일
+//   files       : all.log + alerts.log, 콘솔 off (기본)
+//   console     : files + 콘솔 on
+//   all_only    : all.log만
+//   alerts_only : alerts.log만
+//   utc         : files + TIME_MODE=utc
+//   tz          : files + %Z 플래그가 들어간 패턴
+
+#include "j2/LoggerManager.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<unsigned> threads{1, 4};
+    std::size_t messages = 100000;      // 스레드당
+    std::size_t msgSize  = 128;
+    std::string levels   = "trace:40,debug:20,info:25,warn:10,error:4,critical:1";
+    std::vector<std::string> profiles{"files"};
+    bool async = false;
+    std::string dir = "bench_logs";
+    std::string json;
+};
+
+struct Result {
+    std::string profile;
+    unsigned threads = 0;
+    std::size_t messages = 0;
+    std::size_t payloadBytes = 0;
+    std::uintmax_t fileBytes = 0;
+    double seconds = 0.0;
+    std::uint64_t p50 = 0, p99 = 0, p999 = 0, max = 0;  // ns
+};
+
+std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, sep)) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+spdlog::level::level_enum levelFromName(const std::string& s) {
+    auto lv = spdlog::level::from_str(s);
+    return lv == spdlog::level::off ? spdlog::level::info : lv;
+}
+
+// "trace:40,info:60" → 가중치만큼 레벨을 반복한 추첨 테이블
+std::vector<spdlog::level::level_enum> buildLevelMix(const std::string& spec) {
+    std::vector<spdlog::level::level_enum> table;
+    for (const auto& part : split(spec, ',')) {
+        auto kv = split(part, ':');
+        if (kv.empty()) continue;
+        unsigned weight = kv.size() > 1 ? static_cast<unsigned>(std::strtoul(kv[1].c_str(), nullptr, 10)) : 1;
+        table.insert(table.end(), weight, levelFromName(kv[0]));
+    }
+    if (table.empty()) table.push_back(spdlog::level::info);
+    return table;
+}
+
+bool parseArgs(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : std::string(); };
+        if (a == "--threads") {
+            o.threads.clear();
+            for (const auto& t : split(next(), ','))
+                o.threads.push_back(static_cast<unsigned>(std::strtoul(t.c_str(), nullptr, 10)));
+        } else if (a == "--messages") {
+            o.messages = std::strtoull(next().c_str(), nullptr, 10);
+        } else if (a == "--msg-size") {
+            o.msgSize = std::strtoull(next().c_str(), nullptr, 10);
+        } else if (a == "--levels") {
+            o.levels = next();
+        } else if (a == "--profiles") {
+            o.profiles = split(next(), ',');
+        } else if (a == "--async") {
+            o.async = true;
+        } else if (a == "--dir") {
+            o.dir = next();
+        } else if (a == "--json") {
+            o.json = next();
+        } else {
+            std::cerr << "unknown option: " << a << "\n";
+            return false;
+        }
+    }
+    return !o.threads.empty() && !o.profiles.empty();
+}
+
+// 프로파일별 INI 작성(자동 리로드/디스크 감시 off)
+std::string writeIni(const Options& o, const std::string& profile, const std::string& runDir) {
+    bool console = (profile == "console");
+    bool all     = (profile != "alerts_only");
+    bool alerts  = (profile != "all_only");
+    bool utc     = (profile == "utc");
+    std::string pattern = (profile == "tz")
+        ? "[%Y-%m-%d %H:%M:%S.%e %Z] [%l] [%t] %v"
+        : "[%Y-%m-%d %H:%M:%S.%e] [%l] [%t] %v";
+
+    std::filesystem::create_directories(runDir);
+    std::string path = runDir + "/bench.ini";
+    std::ofstream ini(path, std::ios::trunc);
+    ini << "[Log]\n"
+        << "AUTO_RELOAD_SEC=0\n"
+        << "ASYNC_MODE=" << (o.async ? "true" : "false") << "\n"
+        << "ENABLE_CONSOLE_LOG=" << (console ? "true" : "false") << "\n"
+        << "ENABLE_FILE_LOG_ALL=" << (all ? "true" : "false") << "\n"
+        << "ENABLE_FILE_LOG_ALERTS=" << (alerts ? "true" : "false") << "\n"
+        << "ALL_PATH=" << runDir << "/all.log\n"
+        << "ALERTS_PATH=" << runDir << "/alerts.log\n"
+        << "ALL_MAX_SIZE=100MB\nALL_MAX_FILES=5\n"
+        << "ALERT_MAX_SIZE=100MB\nALERT_MAX_FILES=10\n"
+        << "TIME_MODE=" << (utc ? "utc" : "local") << "\n"
+        << "CONSOLE_LEVEL=trace\nALL_FILE_LEVEL=trace\nALERTS_FILE_LEVEL=warn\n"
+        << "LOGGER_LEVEL=trace\nFLUSH_ON_LEVEL=warn\nFLUSH_EVERY_SEC=1\n"
+        << "PATTERN_CONSOLE=" << pattern << "\n"
+        << "PATTERN_FILE=" << pattern << "\n"
+        << "DISK_GUARD_ENABLE=false\n";
+    return path;
+}
+
+std::uintmax_t dirBytes(const std::string& dir) {
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for (const auto& e : std::filesystem::directory_iterator(dir, ec)) {
+        if (e.is_regular_file(ec) && e.path().extension() == ".log") total += e.file_size(ec);
+    }
+    return total;
+}
+
+std::uint64_t percentile(std::vector<std::uint64_t>& v, double p) {
+    if (v.empty()) return 0;
+    std::size_t idx = static_cast<std::size_t>(p * static_cast<double>(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(idx), v.end());
+    return v[idx];
+}
+
+Result runOne(const Options& o, const std::string& profile, unsigned threads) {
+    std::string runDir = o.dir + "/" + profile + "_t" + std::to_string(threads);
+    std::error_code ec;
+    std::filesystem::remove_all(runDir, ec);
+    std::string ini = writeIni(o, profile, runDir);
+    std::string name = "j2_bench_" + profile + "_" + std::to_string(threads);
+
+    Result r;
+    r.profile  = profile;
+    r.threads  = threads;
+    r.messages = o.messages * threads;
+
+    const auto mix = buildLevelMix(o.levels);
+    const std::string payload(o.msgSize, 'x');
+    std::vector<std::vector<std::uint64_t>> lat(threads);
+
+    {
+        j2::LoggerManager mgr;
+        if (!mgr.init(ini, "Log", name)) {
+            std::cerr << "init failed for profile " << profile << "\n";
+            return r;
+        }
+        auto logger = mgr.getLogger();
+
+        std::atomic<bool> go{false};
+        std::vector<std::thread> ts;
+        for (unsigned t = 0; t < threads; ++t) {
+            ts.emplace_back([&, t]() {
+                auto& mine = lat[t];
+                mine.reserve(o.messages);
+                std::mt19937 rng(1234u + t);
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                for (std::size_t i = 0; i < o.messages; ++i) {
+                    auto lv = mix[rng() % mix.size()];
+                    auto t0 = std::chrono::steady_clock::now();
+                    logger->log(lv, "{} {}", i, payload);
+                    auto t1 = std::chrono::steady_clock::now();
+                    mine.push_back(static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+                }
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& th : ts) th.join();
+        logger->flush();
+        auto end = std::chrono::steady_clock::now();
+        r.seconds = std::chrono::duration<double>(end - start).count();
+    }
+    spdlog::drop(name);
+
+    std::vector<std::uint64_t> all;
+    all.reserve(r.messages);
+    for (auto& v : lat) all.insert(all.end(), v.begin(), v.end());
+    r.payloadBytes = r.messages * o.msgSize;
+    r.fileBytes    = dirBytes(runDir);
+    r.max  = all.empty() ? 0 : *std::max_element(all.begin(), all.end());
+    r.p50  = percentile(all, 0.50);
+    r.p99  = percentile(all, 0.99);
+    r.p999 = percentile(all, 0.999);
+    return r;
+}
+
+void printTable(const std::vector<Result>& rs) {
+    std::printf("\n%-12s %7s %12s %12s %12s %10s %10s %10s %10s\n",
+                "profile", "threads", "msgs/s", "MB/s(payl)", "MB/s(file)",
+                "p50(ns)", "p99(ns)", "p99.9(ns)", "max(ns)");
+    for (const auto& r : rs) {
+        double s = r.seconds > 0 ? r.seconds : 1e-9;
+        std::printf("%-12s %7u %12.0f %12.2f %12.2f %10llu %10llu %10llu %10llu\n",
+                    r.profile.c_str(), r.threads,
+                    static_cast<double>(r.messages) / s,
+                    static_cast<double>(r.payloadBytes) / s / (1024.0 * 1024.0),
+                    static_cast<double>(r.fileBytes) / s / (1024.0 * 1024.0),
+                    static_cast<unsigned long long>(r.p50),
+                    static_cast<unsigned long long>(r.p99),
+                    static_cast<unsigned long long>(r.p999),
+                    static_cast<unsigned long long>(r.max));
+    }
+}
+
+std::string toJson(const Options& o, const std::vector<Result>& rs) {
+    std::ostringstream js;
+    js << "{\n  \"messages_per_thread\": " << o.messages
+       << ",\n  \"msg_size\": " << o.msgSize
+       << ",\n  \"levels\": \"" << o.levels << "\""
+       << ",\n  \"async\": " << (o.async ? "true" : "false")
+       << ",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < rs.size(); ++i) {
+        const auto& r = rs[i];
+        double s = r.seconds > 0 ? r.seconds : 1e-9;
+        js << "    {\"profile\": \"" << r.profile << "\""
+           << ", \"threads\": " << r.threads
+           << ", \"messages\": " << r.messages
+           << ", \"seconds\": " << r.seconds
+           << ", \"messages_per_sec\": " << static_cast<double>(r.messages) / s
+           << ", \"payload_bytes_per_sec\": " << static_cast<double>(r.payloadBytes) / s
+           << ", \"file_bytes_per_sec\": " << static_cast<double>(r.fileBytes) / s
+           << ", \"latency_ns\": {\"p50\": " << r.p50 << ", \"p99\": " << r.p99
+           << ", \"p99_9\": " << r.p999 << ", \"max\": " << r.max << "}}"
+           << (i + 1 < rs.size() ? ",\n" : "\n");
+    }
+    js << "  ]\n}\n";
+    return js.str();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    if (!parseArgs(argc, argv, o)) {
+        std::cerr << "usage: j2_logger_bench [--threads 1,4] [--messages N] [--msg-size B]"
+                     " [--levels trace:40,...] [--profiles files,console,...] [--async]"
+                     " [--dir DIR] [--json FILE]\n";
+        return 2;
+    }
+
+    std::vector<Result> results;
+    for (const auto& p : o.profiles) {
+        for (unsigned t : o.threads) {
+            results.push_back(runOne(o, p, t));
+        }
+    }
+
+    printTable(results);
+
+    std::string js = toJson(o, results);
+    if (o.json.empty()) {
+        std::cout << "\n" << js;
+    } else {
+        std::ofstream(o.json, std::ios::trunc) << js;
+        std::cout << "\nJSON written to " << o.json << "\n";
+    }
+    return 0;
+}
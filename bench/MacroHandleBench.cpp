@@ -0,0 +1,97 @@
+// 매크로 로거 조회 비용 마이크로벤치마크
+//  - legacy : 매 호출마다 spdlog::get(hname) (레지스트리 mutex + 해시 조회)
+//  - cached : thread_local LoggerHandle + 세대 번호 확인
+// 1~64 스레드에서 레벨로 걸러지는 호출(filtered)과 실제 싱크까지 가는 호출(enabled)을 비교한다.
+//
+// 사용법: j2_macro_bench [calls_per_thread]
+
+#define hname "j2_macro_bench"
+#include "src/macro.hpp"
+
+#include <spdlog/sinks/null_sink.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 기존 macro.hpp 확장 형태 그대로
+#define LEGACY_HD(...) SPDLOG_LOGGER_DEBUG(spdlog::get(hname), __VA_ARGS__)
+#define LEGACY_HI(...) SPDLOG_LOGGER_INFO (spdlog::get(hname), __VA_ARGS__)
+
+enum class Mode { legacy_filtered, cached_filtered, legacy_enabled, cached_enabled };
+
+const char* modeName(Mode m) {
+    switch (m) {
+    case Mode::legacy_filtered: return "legacy  filtered";
+    case Mode::cached_filtered: return "cached  filtered";
+    case Mode::legacy_enabled:  return "legacy  enabled ";
+    case Mode::cached_enabled:  return "cached  enabled ";
+    }
+    return "?";
+}
+
+void worker(Mode mode, std::size_t calls) {
+    for (std::size_t i = 0; i < calls; ++i) {
+        switch (mode) {
+        case Mode::legacy_filtered: LEGACY_HD("debug {}", i); break;
+        case Mode::cached_filtered: hd("debug {}", i);        break;
+        case Mode::legacy_enabled:  LEGACY_HI("info {}", i);  break;
+        case Mode::cached_enabled:  hi("info {}", i);         break;
+        }
+    }
+}
+
+double runOnce(Mode mode, unsigned threads, std::size_t calls) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> ts;
+    ts.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        ts.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            worker(mode, calls);
+        });
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : ts) t.join();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    std::size_t calls = 200000;
+    if (argc > 1) calls = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+
+    // null_sink_st: 싱크 자체 락을 제외하고 로거 조회/레벨 검사 비용만 측정
+    auto sink = std::make_shared<spdlog::sinks::null_sink_st>();
+    auto logger = std::make_shared<spdlog::logger>(hname, sink);
+    logger->set_level(spdlog::level::info);  // debug는 filtered, info는 enabled
+    spdlog::register_logger(logger);
+    j2::bumpLoggerGeneration();
+
+    const unsigned threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    const Mode modes[] = {Mode::legacy_filtered, Mode::cached_filtered,
+                          Mode::legacy_enabled,  Mode::cached_enabled};
+
+    std::printf("calls/thread=%zu  hw_threads=%u\n", calls, std::thread::hardware_concurrency());
+    std::printf("%-18s %8s %14s %12s\n", "mode", "threads", "Mcalls/s", "ns/call");
+    for (Mode m : modes) {
+        for (unsigned th : threadCounts) {
+            double sec = runOnce(m, th, calls);
+            double total = static_cast<double>(calls) * th;
+            std::printf("%-18s %8u %14.2f %12.2f\n", modeName(m), th,
+                        total / sec / 1e6, sec * 1e9 / static_cast<double>(calls));
+        }
+    }
+
+    spdlog::drop(hname);
+    j2::bumpLoggerGeneration();
+    return 0;
+}
@@ -0,0 +1,448 @@
+// 리로드/디스크 감시 전환 중 로깅 지연 급증과 유실/중복 검출용 부하 도구
+//
+// 여러 생산자 스레드가 일련번호가 붙은 메시지를 기록하는 동안 INI를 계속 고쳐 쓰고
+// (alerts on/off, ALL 경로, 회전 크기, 패턴, TIME_MODE, ALL on/off) reloadIfChanged()를 호출하며,
+// 가짜 공간 조회(setDiskSpaceProvider)로 디스크 등급 warn → low → critical → ok 전환을 일으킨다.
+// 전환마다 창(window) 안/직후의 최악 호출 지연과 ALL 파일의 유실/중복/예상 밖 기록을 표로 출력한다.
+//
+// 사용법:
+//   j2_reload_stress [--threads 8] [--seconds 10] [--hold-ms 100] [--msg-size 64]
+//                    [--disk-ms 20] [--async] [--dir stress_logs]
+//
+// 판정(스레드별 일련번호 기준)
+//   - 전환 시작 전에 끝난 호출은 이전 상태, 전환 완료 뒤에 시작한 호출은 새 상태로 판정
+//     (전환 중 걸친 호출은 최대 1회만 확인)
+//   - ALL 기록 상태 = ENABLE_FILE_LOG_ALL && 디스크 등급 ok(warn은 info 메시지를 거르고 low 이상은 분리)
+//   - 기록 상태인데 없으면 lost, 2회 이상이면 dup, 기록하지 않을 상태인데 있으면 unexpected
+//   - --async: 리로드도 큐를 비우지 않으므로 모든 전환에서 직전 전환 이후 호출 전체를 걸친 호출로 봄(큐에 남은 메시지)
+//   - lost/dup이 있으면 종료 코드 1
+
+#include "j2/LoggerManager.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    unsigned threads = 8;
+    unsigned seconds = 10;
+    unsigned holdMs = 100;          // 전환 사이 안정 구간
+    std::size_t msgSize = 64;
+    unsigned diskMs = 20;           // DISK_GUARD_INTERVAL_MS
+    bool async = false;
+    std::string dir = "stress_logs";
+};
+
+// INI로 바꾸는 설정 + 가짜 디스크 잔여율
+struct State {
+    bool allOn = true;
+    bool alertsOn = true;
+    bool pathB = false;
+    bool smallFiles = false;
+    bool patternB = false;
+    bool utc = false;
+    double freePct = 50.0;
+
+    bool allWritable() const { return allOn && freePct >= 10.0; }
+};
+
+struct Step {
+    const char* name;
+    void (*apply)(State&);
+    bool disk;                      // 가짜 디스크 등급 변경(감시 스레드 반영을 기다림)
+};
+
+// 한 바퀴 돌면 기준 상태로 돌아오는 전환 순서
+// (ALL off 동안 alerts를 켜 둠: 싱크가 모두 빠지면 콘솔 대체 싱크가 붙어 출력이 섞임)
+const Step kSteps[] = {
+    {"alerts off",     [](State& s) { s.alertsOn = false; },   false},
+    {"all path b",     [](State& s) { s.pathB = true; },       false},
+    {"max size 256KB", [](State& s) { s.smallFiles = true; },  false},
+    {"pattern b",      [](State& s) { s.patternB = true; },    false},
+    {"time mode utc",  [](State& s) { s.utc = true; },         false},
+    {"disk warn",      [](State& s) { s.freePct = 8.0; },      true},
+    {"disk low",       [](State& s) { s.freePct = 3.0; },      true},
+    {"disk critical",  [](State& s) { s.freePct = 0.5; },      true},
+    {"disk ok",        [](State& s) { s.freePct = 50.0; },     true},
+    {"alerts on",      [](State& s) { s.alertsOn = true; },    false},
+    {"all off",        [](State& s) { s.allOn = false; },      false},
+    {"all on",         [](State& s) { s.allOn = true; },       false},
+    {"all path a",     [](State& s) { s.pathB = false; },      false},
+    {"max size 64MB",  [](State& s) { s.smallFiles = false; }, false},
+    {"pattern a",      [](State& s) { s.patternB = false; },   false},
+    {"time mode local",[](State& s) { s.utc = false; },        false},
+};
+constexpr std::size_t kStepCount = sizeof(kSteps) / sizeof(kSteps[0]);
+constexpr std::size_t kMaxWindows = 1 << 16;
+
+// 전환 1회: 시작/완료 시점의 스레드별 완료 일련번호(그 사이에 걸친 호출은 판정 보류)
+struct Window {
+    std::size_t step = 0;
+    std::vector<std::uint64_t> begin, end;
+    bool writableAfter = true;
+    double ms = 0.0;
+};
+
+// 지연 히스토그램: 2의 거듭제곱마다 4칸(ns)
+class Histogram {
+public:
+    void add(std::uint64_t ns) {
+        ++buckets_[index(ns)];
+        ++count_;
+        max_ = std::max(max_, ns);
+    }
+    void merge(const Histogram& o) {
+        for (std::size_t i = 0; i < kBuckets; ++i) buckets_[i] += o.buckets_[i];
+        count_ += o.count_;
+        max_ = std::max(max_, o.max_);
+    }
+    std::uint64_t percentile(double p) const {
+        const std::uint64_t want = static_cast<std::uint64_t>(p * static_cast<double>(count_));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += buckets_[i];
+            if (seen > want) return upper(i);
+        }
+        return max_;
+    }
+    std::uint64_t max() const { return max_; }
+    std::uint64_t count() const { return count_; }
+
+private:
+    static constexpr std::size_t kBuckets = 64 * 4;
+    static std::size_t index(std::uint64_t ns) {
+        if (ns < 4) return static_cast<std::size_t>(ns);
+        unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(ns));
+        return msb * 4 + static_cast<std::size_t>((ns >> (msb - 2)) & 3u);
+    }
+    static std::uint64_t upper(std::size_t i) {
+        if (i < 4) return i;
+        const unsigned msb = static_cast<unsigned>(i / 4);
+        return (std::uint64_t{4} + (i % 4) + 1) << (msb - 2);
+    }
+    std::uint64_t buckets_[kBuckets] = {};
+    std::uint64_t count_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+void atomicMax(std::atomic<std::uint64_t>& a, std::uint64_t v) {
+    std::uint64_t cur = a.load(std::memory_order_relaxed);
+    while (v > cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
+bool parseArgs(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : std::string(); };
+        if (a == "--threads")       o.threads = static_cast<unsigned>(std::strtoul(next().c_str(), nullptr, 10));
+        else if (a == "--seconds")  o.seconds = static_cast<unsigned>(std::strtoul(next().c_str(), nullptr, 10));
+        else if (a == "--hold-ms")  o.holdMs = static_cast<unsigned>(std::strtoul(next().c_str(), nullptr, 10));
+        else if (a == "--msg-size") o.msgSize = std::strtoull(next().c_str(), nullptr, 10);
+        else if (a == "--disk-ms")  o.diskMs = static_cast<unsigned>(std::strtoul(next().c_str(), nullptr, 10));
+        else if (a == "--async")    o.async = true;
+        else if (a == "--dir")      o.dir = next();
+        else {
+            std::cerr << "unknown option: " << a << "\n";
+            return false;
+        }
+    }
+    return o.threads > 0 && o.seconds > 0;
+}
+
+// 설정 배포처럼 임시 파일 + rename, mtime은 매번 다른 값으로(같은 초 안의 연속 변경도 감지)
+void writeIni(const Options& o, const State& s, const std::string& path, unsigned generation) {
+    const char* pattern = s.patternB ? "%Y-%m-%dT%H:%M:%S.%f %L %t | %v"
+                                     : "[%Y-%m-%d %H:%M:%S.%e] [%l] [%t] %v";
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream ini(tmp, std::ios::trunc);
+        ini << "[Log]\n"
+            << "AUTO_RELOAD_SEC=0\n"
+            << "ASYNC_MODE=" << (o.async ? "true" : "false") << "\n"
+            << "ENABLE_CONSOLE_LOG=false\n"
+            << "ENABLE_FILE_LOG_ALL=" << (s.allOn ? "true" : "false") << "\n"
+            << "ENABLE_FILE_LOG_ALERTS=" << (s.alertsOn ? "true" : "false") << "\n"
+            << "ALL_PATH=" << o.dir << (s.pathB ? "/all_b.log" : "/all_a.log") << "\n"
+            << "ALERTS_PATH=" << o.dir << "/alerts.log\n"
+            << "ALL_MAX_SIZE=" << (s.smallFiles ? "256KB" : "64MB") << "\n"
+            << "ALL_MAX_FILES=100000\n"
+            << "ALERT_MAX_SIZE=64MB\nALERT_MAX_FILES=10\n"
+            << "ROTATE_NAMING=index\n"
+            << "TIME_MODE=" << (s.utc ? "utc" : "local") << "\n"
+            << "CONSOLE_LEVEL=trace\nALL_FILE_LEVEL=trace\nALERTS_FILE_LEVEL=warn\n"
+            << "LOGGER_LEVEL=trace\nFLUSH_ON_LEVEL=critical\nFLUSH_EVERY_SEC=1\n"
+            << "PATTERN_CONSOLE=" << pattern << "\n"
+            << "PATTERN_FILE=" << pattern << "\n"
+            << "DISK_GUARD_ENABLE=true\n"
+            << "DISK_GUARD_INTERVAL_MS=" << o.diskMs << "\n"
+            << "DISK_TIME_TO_FULL_SEC=0\n"
+            << "UDP_ALERT_IP=127.0.0.1\nUDP_ALERT_PORT=9\nUDP_ALERT_INTERVAL_SEC=1\n";
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    std::filesystem::last_write_time(
+        path, std::filesystem::file_time_type::clock::now() + std::chrono::seconds(generation), ec);
+}
+
+bool tierMatches(const j2::LoggerManager::DiskState& st, double freePct) {
+    using Tier = j2::DiskGuard::Tier;
+    const Tier want = freePct < 1.0 ? Tier::critical : freePct < 5.0 ? Tier::low
+                    : freePct < 10.0 ? Tier::warn : Tier::ok;
+    return st.all == want;
+}
+
+// "S t=<thread> n=<seq>" 줄을 세어 스레드별 일련번호 출현 횟수로(심볼릭 링크는 건너뜀)
+std::vector<std::vector<std::uint8_t>> countLines(const std::string& dir, const std::vector<std::uint64_t>& total,
+                                                  std::size_t& files, std::uint64_t& stray) {
+    std::vector<std::vector<std::uint8_t>> seen(total.size());
+    for (std::size_t t = 0; t < total.size(); ++t) seen[t].assign(total[t], 0);
+    files = 0;
+    stray = 0;
+
+    std::error_code ec;
+    for (const auto& e : std::filesystem::directory_iterator(dir, ec)) {
+        const std::string name = e.path().filename().string();
+        if (name.compare(0, 4, "all_") != 0 || e.is_symlink(ec) || e.path().extension() != ".log") continue;
+        ++files;
+        std::ifstream in(e.path(), std::ios::binary);
+        std::string line;
+        while (std::getline(in, line)) {
+            const std::size_t at = line.find("S t=");
+            if (at == std::string::npos) continue;
+            char* endp = nullptr;
+            const unsigned long t = std::strtoul(line.c_str() + at + 4, &endp, 10);
+            if (!endp || std::strncmp(endp, " n=", 3) != 0) continue;
+            const unsigned long long n = std::strtoull(endp + 3, nullptr, 10);
+            if (t >= seen.size() || n >= seen[t].size()) {
+                ++stray;
+                continue;
+            }
+            if (seen[t][n] < 255) ++seen[t][n];
+        }
+    }
+    return seen;
+}
+
+struct Tally {
+    std::size_t count = 0;
+    double maxMs = 0.0;
+    std::uint64_t inWindowNs = 0;
+    std::uint64_t afterNs = 0;
+    std::uint64_t lost = 0, dup = 0, unexpected = 0;
+};
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    if (!parseArgs(argc, argv, o)) {
+        std::cerr << "usage: j2_reload_stress [--threads N] [--seconds S] [--hold-ms MS] [--msg-size B]"
+                     " [--disk-ms MS] [--async] [--dir DIR]\n";
+        return 2;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(o.dir, ec);
+    std::filesystem::create_directories(o.dir, ec);
+    const std::string iniPath = o.dir + "/stress.ini";
+    const std::string name = "j2_reload_stress";
+
+    State state;
+    unsigned generation = 0;
+    writeIni(o, state, iniPath, generation++);
+
+    auto freePct = std::make_shared<std::atomic<double>>(state.freePct);
+    std::vector<Window> windows;
+    windows.reserve(kMaxWindows);
+    // phase: 2k+1 = 전환 k 진행 중, 2k+2 = 전환 k 이후 안정 구간(0: 첫 전환 전)
+    std::atomic<std::uint64_t> phase{0};
+    std::unique_ptr<std::atomic<std::uint64_t>[]> phaseMax(new std::atomic<std::uint64_t>[2 * kMaxWindows + 2]);
+    for (std::size_t i = 0; i < 2 * kMaxWindows + 2; ++i) phaseMax[i].store(0);
+
+    std::vector<std::unique_ptr<std::atomic<std::uint64_t>>> done;   // 스레드별 완료한 호출 수
+    for (unsigned t = 0; t < o.threads; ++t) done.push_back(std::make_unique<std::atomic<std::uint64_t>>(0));
+    std::vector<Histogram> hist(o.threads);
+    std::size_t asyncDropped = 0;
+    double runSeconds = 0.0;
+
+    {
+        j2::LoggerManager mgr;
+        mgr.setDiskSpaceProvider([freePct](const std::string&) {
+            j2::DiskGuard::SpaceInfo si;
+            si.capacity = 100ull * 1024 * 1024 * 1024;
+            si.available = static_cast<unsigned long long>(static_cast<double>(si.capacity) * freePct->load() / 100.0);
+            si.ok = true;
+            return si;
+        });
+        if (!mgr.init(iniPath, "Log", name)) {
+            std::cerr << "init failed\n";
+            return 2;
+        }
+        auto logger = mgr.getLogger();
+
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> producers;
+        const std::string payload(o.msgSize, 'x');
+        for (unsigned t = 0; t < o.threads; ++t) {
+            producers.emplace_back([&, t]() {
+                auto& mine = *done[t];
+                auto& h = hist[t];
+                for (std::uint64_t n = 0; !stop.load(std::memory_order_relaxed); ++n) {
+                    const std::uint64_t ph0 = phase.load(std::memory_order_acquire);
+                    const auto t0 = Clock::now();
+                    logger->info("S t={} n={} {}", t, n, payload);
+                    const auto t1 = Clock::now();
+                    const std::uint64_t ph1 = phase.load(std::memory_order_acquire);
+                    mine.store(n + 1, std::memory_order_release);
+
+                    const auto ns = static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+                    h.add(ns);
+                    // 전환에 걸친 호출은 그 전환(홀수 phase)으로, 아니면 안정 구간으로
+                    const std::uint64_t ph = (ph0 % 2 == 1 || ph1 == ph0) ? ph0 : ph0 + 1;
+                    atomicMax(phaseMax[std::min<std::uint64_t>(ph, 2 * kMaxWindows + 1)], ns);
+                    if ((n & 63) == 63) logger->warn("W t={} n={}", t, n);   // alerts 경로도 부하
+                }
+            });
+        }
+
+        auto snapshot = [&]() {
+            std::vector<std::uint64_t> v(o.threads);
+            for (unsigned t = 0; t < o.threads; ++t) v[t] = done[t]->load(std::memory_order_acquire);
+            return v;
+        };
+
+        const auto start = Clock::now();
+        const auto deadline = start + std::chrono::seconds(o.seconds);
+        std::this_thread::sleep_for(std::chrono::milliseconds(o.holdMs));
+        // 시간이 끝나도 기준 상태(한 바퀴 끝)까지는 진행
+        for (std::size_t i = 0; windows.size() < kMaxWindows && (Clock::now() < deadline || i % kStepCount != 0); ++i) {
+            const Step& step = kSteps[i % kStepCount];
+            Window w;
+            w.step = i % kStepCount;
+            w.begin = snapshot();
+            if (o.async) {
+                // 리로드/디스크 전환 모두 큐를 기다리지 않으므로 큐에 남은 이전 호출도 새 상태로 처리될 수 있음
+                w.begin = windows.empty() ? std::vector<std::uint64_t>(o.threads, 0) : windows.back().end;
+            }
+            phase.fetch_add(1, std::memory_order_acq_rel);
+            const auto w0 = Clock::now();
+
+            step.apply(state);
+            if (step.disk) {
+                freePct->store(state.freePct);
+                const auto limit = Clock::now() + std::chrono::seconds(2);
+                while (!tierMatches(mgr.diskState(), state.freePct) && Clock::now() < limit) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                mgr.reloadIfChanged();   // mu_ 통과 = 등급에 맞춘 싱크 교체 완료
+            } else {
+                writeIni(o, state, iniPath, generation++);
+                mgr.reloadIfChanged();
+            }
+
+            w.ms = std::chrono::duration<double, std::milli>(Clock::now() - w0).count();
+            w.writableAfter = state.allWritable();
+            phase.fetch_add(1, std::memory_order_acq_rel);
+            w.end = snapshot();
+            windows.push_back(std::move(w));
+            std::this_thread::sleep_for(std::chrono::milliseconds(o.holdMs));
+        }
+
+        stop.store(true);
+        for (auto& th : producers) th.join();
+        runSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        logger->flush();
+        asyncDropped = mgr.asyncDroppedCount();
+    }
+    spdlog::drop(name);
+
+    // 판정
+    const std::vector<std::uint64_t> total = [&]() {
+        std::vector<std::uint64_t> v;
+        for (auto& d : done) v.push_back(d->load());
+        return v;
+    }();
+    std::size_t files = 0;
+    std::uint64_t stray = 0;
+    auto seen = countLines(o.dir, total, files, stray);
+
+    std::vector<Tally> tally(kStepCount);
+    Tally start;   // 첫 전환 전
+    for (std::size_t k = 0; k < windows.size(); ++k) {
+        Tally& ty = tally[windows[k].step];
+        ++ty.count;
+        ty.maxMs = std::max(ty.maxMs, windows[k].ms);
+        ty.inWindowNs = std::max(ty.inWindowNs, phaseMax[2 * k + 1].load());
+        ty.afterNs = std::max(ty.afterNs, phaseMax[2 * k + 2].load());
+    }
+    start.afterNs = phaseMax[0].load();
+
+    std::uint64_t lostAll = 0, dupAll = 0, unexpectedAll = 0;
+    for (unsigned t = 0; t < o.threads; ++t) {
+        std::size_t k = 0;   // 다음 전환
+        for (std::uint64_t n = 0; n < total[t]; ++n) {
+            while (k < windows.size() && n > windows[k].end[t]) ++k;   // 전환 k 완료 뒤 시작한 호출
+            const std::uint8_t c = seen[t][n];
+            Tally& ty = k == 0 ? start : tally[windows[k - 1].step];
+            if (k < windows.size() && n >= windows[k].begin[t]) {
+                // 전환 k에 걸친 호출: 어느 상태로 처리되든 최대 1회
+                if (c > 1) { ++tally[windows[k].step].dup; ++dupAll; }
+                continue;
+            }
+            const bool writable = k == 0 ? true : windows[k - 1].writableAfter;
+            if (c > 1) { ++ty.dup; ++dupAll; }
+            if (writable && c == 0) { ++ty.lost; ++lostAll; }
+            if (!writable && c > 0) { ++ty.unexpected; ++unexpectedAll; }
+        }
+    }
+
+    Histogram h;
+    for (const auto& x : hist) h.merge(x);
+
+    std::printf("\n%-16s %6s %12s %16s %16s %8s %6s %10s\n", "transition", "count", "max_ms",
+                "worst_in(us)", "worst_after(us)", "lost", "dup", "unexpected");
+    std::printf("%-16s %6s %12s %16s %16.1f %8llu %6llu %10llu\n", "(start)", "-", "-", "-",
+                static_cast<double>(start.afterNs) / 1000.0, static_cast<unsigned long long>(start.lost),
+                static_cast<unsigned long long>(start.dup), static_cast<unsigned long long>(start.unexpected));
+    for (std::size_t s = 0; s < kStepCount; ++s) {
+        const Tally& ty = tally[s];
+        if (ty.count == 0) continue;
+        std::printf("%-16s %6zu %12.2f %16.1f %16.1f %8llu %6llu %10llu\n", kSteps[s].name, ty.count, ty.maxMs,
+                    static_cast<double>(ty.inWindowNs) / 1000.0, static_cast<double>(ty.afterNs) / 1000.0,
+                    static_cast<unsigned long long>(ty.lost), static_cast<unsigned long long>(ty.dup),
+                    static_cast<unsigned long long>(ty.unexpected));
+    }
+
+    std::uint64_t messages = 0;
+    for (auto v : total) messages += v;
+    std::printf("\nthreads %u, transitions %zu, messages %llu in %.1fs (%.0f msgs/s), files %zu\n", o.threads,
+                windows.size(), static_cast<unsigned long long>(messages), runSeconds,
+                static_cast<double>(messages) / (runSeconds > 0 ? runSeconds : 1e-9), files);
+    std::printf("latency ns: p50 %llu, p99 %llu, p99.9 %llu, max %llu\n",
+                static_cast<unsigned long long>(h.percentile(0.50)),
+                static_cast<unsigned long long>(h.percentile(0.99)),
+                static_cast<unsigned long long>(h.percentile(0.999)), static_cast<unsigned long long>(h.max()));
+    std::printf("lost %llu, dup %llu, unexpected %llu, unparsable %llu, async dropped %zu\n",
+                static_cast<unsigned long long>(lostAll), static_cast<unsigned long long>(dupAll),
+                static_cast<unsigned long long>(unexpectedAll), static_cast<unsigned long long>(stray),
+                asyncDropped);
+    return (lostAll > 0 || dupAll > 0) ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <spdlog/logger.h>
+#include <spdlog/details/os.h>
+#include "j2/BinaryLog.hpp"
+#include "j2/SnapshotDistSink.hpp"
+
+// BACKTRACE_DEPTH: 로거 레벨에 걸러진 매크로 레코드를 포맷 없이 스레드별 링에 보관하고,
+// 트리거 레벨 이상이 기록될 때 그 스레드의 링만 포맷해 파일 싱크에 쏟아냄
+namespace j2 {
+namespace backtrace {
+
+// 로거별 대상(LoggerManager가 구성 변경 시 새 객체로 교체 등록, 매크로 핸들이 세대별로 캐시)
+// 쏟아낸 줄은 logger(레벨 trace, ASYNC_MODE면 같은 큐)를 거쳐 sinks로: all 파일, alerts(DedupSink 포함), shm.
+// sinks는 자식 레벨을 무시하고 역할별 SinkStats로 계측. 교체되면 LoggerManager가 비움(캐시된 대상은 싱크를 놓음)
+struct Target {
+    std::uint64_t id = 0;                     // 링 항목 구분용(등록마다 새 값)
+    std::size_t depth = 0;                    // 스레드당 보관 레코드 수
+    spdlog::level::level_enum trigger = spdlog::level::err;
+    std::string loggerName;
+    std::shared_ptr<sinks::SnapshotDistSink> sinks;
+    std::shared_ptr<spdlog::logger> logger;   // 단일 싱크 = sinks
+};
+
+void registerTarget(const std::string& logger, std::shared_ptr<Target> t);
+void unregisterTarget(const std::string& logger);
+std::shared_ptr<Target> findTarget(const std::string& logger);
+std::uint64_t nextTargetId();
+
+// 스레드별 링: 항목 = 시각/레벨/위치 + [u32 포맷 길이][포맷][인자(binlog 인코딩)]
+class Ring {
+public:
+    struct Entry {
+        std::uint64_t target = 0;
+        std::int64_t ns = 0;
+        spdlog::level::level_enum level = spdlog::level::trace;
+        spdlog::source_loc loc;
+        std::uint8_t argc = 0;
+        spdlog::memory_buf_t data;
+    };
+
+    // 다음에 채울 항목(가장 오래된 것을 덮어씀)
+    Entry& next(std::size_t depth) {
+        if (entries_.size() != depth) {
+            entries_.clear();
+            entries_.resize(depth);
+            head_ = 0;
+            size_ = 0;
+        }
+        Entry& e = entries_[head_];
+        head_ = (head_ + 1) % depth;
+        if (size_ < depth) ++size_;
+        return e;
+    }
+
+    // target의 항목을 오래된 순으로 포맷해 target.logger로 기록(앞뒤 표시 줄은 lvl)하고 비움
+    std::size_t dump(const Target& target, spdlog::level::level_enum lvl);
+
+    static Ring& local() {
+        static thread_local Ring ring;
+        return ring;
+    }
+
+private:
+    std::vector<Entry> entries_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    spdlog::memory_buf_t text_;
+};
+
+// 포맷/싱크 기록 없이 원시 형태로 보관
+template <typename... Args>
+inline void capture(const Target& target, spdlog::level::level_enum lvl, const spdlog::source_loc& loc,
+                    spdlog::format_string_t<Args...> fmt, Args&&... args) {
+    static_assert(sizeof...(Args) <= binlog::kMaxArgs, "too many log arguments");
+    auto& e = Ring::local().next(target.depth);
+    e.target = target.id;
+    e.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+    e.level = lvl;
+    e.loc = loc;
+    e.argc = static_cast<std::uint8_t>(sizeof...(Args));
+    e.data.clear();
+    fmt::string_view f(fmt);
+    binlog::detail::put<std::uint32_t>(e.data, static_cast<std::uint32_t>(f.size()));
+    e.data.append(f.data(), f.data() + f.size());
+    (binlog::detail::putArg(e.data, args), ...);
+}
+
+// 트리거 레벨 이상이면 이 스레드의 링을 먼저 기록(트리거 레코드 자체는 호출자가 평소대로 기록)
+inline void onEmit(const Target& target, spdlog::level::level_enum lvl) {
+    if (lvl >= target.trigger) Ring::local().dump(target, lvl);
+}
+
+} // namespace backtrace
+} // namespace j2
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <spdlog/logger.h>
+#include <spdlog/details/os.h>
+#include "j2/RotatingFileSink.hpp"
+
+// FILE_FORMAT=binary: 패턴/인자 텍스트 포맷 없이 레코드를 그대로 기록하는 ALL 파일 형식
+// (텍스트 복원은 j2_log_decode 도구가 PATTERN_FILE로 수행)
+namespace j2 {
+namespace binlog {
+
+// 파일 레이아웃(리틀 엔디언, 레코드 = 1바이트 종류 + 본문)
+//  SESSION: "J2BL" u16 version, u16 len + 로거 이름        ─ 파일을 열 때마다 1회(사전 초기화)
+//  SITE   : u32 id, u32 line, u16 len + file, u16 len + func, u32 len + 포맷 문자열
+//  EVENT  : i64 ns, u8 level, u64 tid, u32 site id, u8 argc, 인자...
+//  TEXT   : i64 ns, u8 level, u64 tid, u32 len + 이미 포맷된 메시지(매크로 외 경로)
+enum Record : std::uint8_t { kSession = 1, kSite = 2, kEvent = 3, kText = 4 };
+
+// 인자: 1바이트 태그 + 값(문자열은 u32 길이 + 바이트)
+enum Arg : std::uint8_t { kI64 = 1, kU64 = 2, kF64 = 3, kBool = 4, kChar = 5, kStr = 6, kPtr = 7 };
+
+constexpr char          kMagic[4] = {'J', '2', 'B', 'L'};
+constexpr std::uint16_t kVersion  = 1;
+constexpr std::size_t   kMaxArgs  = 255;
+
+// 호출 지점(포맷 문자열 + 소스 위치) 사전: 프로세스 전역 id 부여
+struct SiteInfo {
+    std::string fmt;
+    std::string file;
+    std::string func;
+    std::uint32_t line = 0;
+};
+std::uint32_t siteId(fmt::string_view fmt, const spdlog::source_loc& loc);
+SiteInfo siteInfo(std::uint32_t id);
+
+// 매크로 호출 지점별 thread_local 캐시(포맷 문자열 포인터가 같으면 사전 조회 생략)
+struct CallSite {
+    const char* fmt = nullptr;
+    std::size_t len = 0;
+    std::uint32_t id = 0;
+};
+
+namespace detail {
+
+inline spdlog::memory_buf_t& tlsBuffer() {
+    static thread_local spdlog::memory_buf_t buf;
+    return buf;
+}
+
+template <typename T>
+inline void put(spdlog::memory_buf_t& b, T v) {
+    const char* p = reinterpret_cast<const char*>(&v);
+    b.append(p, p + sizeof(T));
+}
+
+inline void putStr(spdlog::memory_buf_t& b, const char* s, std::size_t n) {
+    put<std::uint8_t>(b, kStr);
+    put<std::uint32_t>(b, static_cast<std::uint32_t>(n));
+    b.append(s, s + n);
+}
+
+// 기본형/문자열은 값 그대로, 그 밖의 타입은 "{}" 로 미리 문자열화(호환용, 비용 발생)
+template <typename T>
+inline void putArg(spdlog::memory_buf_t& b, const T& v) {
+    using D = std::decay_t<T>;
+    if constexpr (std::is_same_v<D, bool>) {
+        put<std::uint8_t>(b, kBool);
+        put<std::uint8_t>(b, v ? 1 : 0);
+    } else if constexpr (std::is_same_v<D, char>) {
+        put<std::uint8_t>(b, kChar);
+        put<char>(b, v);
+    } else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>) {
+        put<std::uint8_t>(b, kI64);
+        put<std::int64_t>(b, static_cast<std::int64_t>(v));
+    } else if constexpr (std::is_integral_v<D>) {
+        put<std::uint8_t>(b, kU64);
+        put<std::uint64_t>(b, static_cast<std::uint64_t>(v));
+    } else if constexpr (std::is_floating_point_v<D>) {
+        put<std::uint8_t>(b, kF64);
+        put<double>(b, static_cast<double>(v));
+    } else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>) {
+        if (v) putStr(b, v, std::strlen(v));
+        else   putStr(b, "(null)", 6);
+    } else if constexpr (std::is_convertible_v<const D&, fmt::string_view>) {
+        fmt::string_view sv(v);
+        putStr(b, sv.data(), sv.size());
+    } else if constexpr (std::is_pointer_v<D>) {
+        put<std::uint8_t>(b, kPtr);
+        put<std::uint64_t>(b, static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(v)));
+    } else {
+        std::string s = fmt::format("{}", v);
+        putStr(b, s.data(), s.size());
+    }
+}
+
+} // namespace detail
+
+// ALL 파일(binary) 싱크: 회전/압축/보존은 RotatingFileSink와 동일
+// - record(): 매크로 경로. 인자를 스레드별 버퍼에 직렬화한 뒤 락 안에서는 write만 수행
+// - sink_it_(): getLogger() 등 일반 경로로 들어온 메시지는 TEXT 레코드로 기록
+class BinaryFileSink final : public j2::sinks::RotatingFileSink {
+public:
+    BinaryFileSink(std::string base_filename,
+                   std::size_t max_size,
+                   std::size_t max_files,
+                   std::shared_ptr<j2::sinks::RotationWorker> worker,
+                   j2::sinks::RotateCompress compress,
+                   std::string loggerName,
+                   j2::sinks::RotatePolicy policy = {},
+                   j2::sinks::FileIoBackend io = j2::sinks::FileIoBackend::stdio);
+
+    template <typename... Args>
+    void record(CallSite& site, spdlog::level::level_enum lvl, const spdlog::source_loc& loc,
+                fmt::string_view fmt, const Args&... args) {
+        static_assert(sizeof...(Args) <= kMaxArgs, "too many log arguments");
+        if (site.fmt != fmt.data() || site.len != fmt.size()) {
+            site.id  = siteId(fmt, loc);
+            site.fmt = fmt.data();
+            site.len = fmt.size();
+        }
+
+        auto& buf = detail::tlsBuffer();
+        buf.clear();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::system_clock::now().time_since_epoch()).count();
+        detail::put<std::uint8_t>(buf, kEvent);
+        detail::put<std::int64_t>(buf, static_cast<std::int64_t>(ns));
+        detail::put<std::uint8_t>(buf, static_cast<std::uint8_t>(lvl));
+        detail::put<std::uint64_t>(buf, static_cast<std::uint64_t>(spdlog::details::os::thread_id()));
+        detail::put<std::uint32_t>(buf, site.id);
+        detail::put<std::uint8_t>(buf, static_cast<std::uint8_t>(sizeof...(Args)));
+        (detail::putArg(buf, args), ...);
+
+        writeEvent(site.id, buf);
+    }
+
+    // TEXT 레코드는 포맷하지 않고 원문을 기록하므로 포맷 공유 대상이 아님(키는 항상 0)
+    void setSharedFormatter(std::unique_ptr<spdlog::formatter> f, std::size_t) override { set_formatter(std::move(f)); }
+
+    std::uint64_t directMessages() const noexcept override { return events_.load(std::memory_order_relaxed); }
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void onFileOpened_() override;
+
+private:
+    void writeEvent(std::uint32_t id, const spdlog::memory_buf_t& rec);
+    void writeSession_();
+
+    std::string loggerName_;
+    std::vector<bool> emitted_;     // 현재 파일에 SITE 레코드를 이미 쓴 id
+    spdlog::memory_buf_t scratch_;  // mutex_ 보호
+    std::atomic<std::uint64_t> events_{0};  // record()로 기록한 EVENT 수
+};
+
+// 매크로가 쓰는 로거별 바이너리 경로(LoggerManager가 구성 변경 시 새 객체로 교체 등록)
+struct Channel {
+    std::shared_ptr<BinaryFileSink> sink;
+    std::shared_ptr<spdlog::logger> text;  // ALL 파일을 뺀 나머지 싱크(콘솔/alerts)용 로거
+    spdlog::level::level_enum textMin = spdlog::level::off;
+    spdlog::level::level_enum flushOn = spdlog::level::off;
+    std::shared_ptr<FlushScheduler> commit;   // 있으면 flushOn 이상은 직접 flush 대신 그룹 커밋 대기
+};
+
+void registerChannel(const std::string& logger, std::shared_ptr<Channel> ch);
+void unregisterChannel(const std::string& logger);
+std::shared_ptr<Channel> findChannel(const std::string& logger);
+
+// 인자를 한 번만 평가: ALL 파일은 바이너리로, 텍스트가 필요한 싱크가 있으면 텍스트 로거로.
+// 바이너리 기록은 호출 스레드에서 수행하므로 ASYNC_MODE에서는 채널을 등록하지 않음
+template <typename... Args>
+inline void dispatch(Channel& ch, CallSite& site, spdlog::level::level_enum lvl,
+                     const spdlog::source_loc& loc,
+                     spdlog::format_string_t<Args...> fmt, Args&&... args) {
+    bool flush = false;
+    if (ch.sink->should_log(lvl)) {
+        ch.sink->record(site, lvl, loc, fmt::string_view(fmt), args...);
+        flush = lvl >= ch.flushOn;
+    }
+    if (lvl >= ch.textMin) {
+        // 텍스트 분배 싱크도 같은 기준으로 그룹 커밋을 기다리므로 한 번만
+        ch.text->log(loc, lvl, fmt, std::forward<Args>(args)...);
+        if (flush && !ch.commit) ch.sink->flush();
+    } else if (flush) {
+        if (ch.commit) ch.commit->commitAndWait();
+        else           ch.sink->flush();
+    }
+}
+
+} // namespace binlog
+} // namespace j2
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// INI 파일 변경 감시 스레드(Linux: inotify, 그 외: 폴링)
+namespace j2 {
+
+class ConfigWatcher {
+public:
+    enum class Event { changed, tick };
+    enum class Backend { automatic, poll };
+
+    // changed: 파일 변경 감지(디바운스 후 1회), tick: 주기 타이머
+    using Callback = std::function<void(Event)>;
+
+    ConfigWatcher() = default;
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    bool start(const std::string& path,
+               std::chrono::milliseconds interval,
+               std::chrono::milliseconds debounce,
+               Backend backend,
+               Callback cb);
+    void stop();  // 대기 중이어도 즉시 깨워서 종료
+    void setInterval(std::chrono::milliseconds interval);
+
+    bool running() const { return running_; }
+    bool eventDriven() const { return eventDriven_; }
+
+private:
+    void runPoll();
+#ifdef __linux__
+    bool openInotify();
+    void closeInotify();
+    void runInotify();
+    int inotifyFd_ = -1;
+    int wakeFd_    = -1;
+#endif
+
+    std::string dir_;
+    std::string file_;
+    std::atomic<long long> intervalMs_{60000};
+    std::chrono::milliseconds debounce_{200};
+    Callback cb_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> eventDriven_{false};
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::thread thread_;
+};
+
+} // namespace j2
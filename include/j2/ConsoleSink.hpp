@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <spdlog/sinks/sink.h>
+#include "j2/SinkStats.hpp"
+
+// CONSOLE_BATCHED: 로깅 스레드는 버퍼에 붙이기만 하고 백그라운드 스레드가 큰 묶음으로 stdout에 기록
+// (느린 파이프/SSH/컨테이너 로그 드라이버가 서비스 전체를 터미널 속도로 늦추지 않게 함)
+namespace j2 {
+namespace sinks {
+
+// CONSOLE_COLOR: auto는 stdout이 색상 터미널일 때만 ANSI 색상(파이프/파일이면 색상 처리 생략)
+enum class ConsoleColor { automatic, always, never };
+
+// - 대기 버퍼가 backlogBytes를 넘기면 새 메시지를 버리고 세며, 다음 묶음 끝에 버린 수를 한 줄로 남김
+//   (기록 중인 묶음 1개는 별도라 최대 메모리는 약 2배)
+// - 기록 스레드는 묶음마다 fwrite + fflush, 깨우기는 버퍼가 비어 있다가 채워질 때만
+// - flush(): 호출 시점까지 붙인 내용이 기록되길 잠깐 기다림. stdout이 막혀 시간이 지나면 반환하고,
+//   기록이 다시 진행될 때까지 이후 flush는 기다리지 않음(FLUSH_ON_LEVEL 대기가 막히지 않게)
+// - 소멸 시 남은 내용을 모두 기록
+class BatchedConsoleSink final : public spdlog::sinks::sink, public SinkCounters {
+public:
+    struct Options {
+        std::size_t backlogBytes = 1024 * 1024;   // CONSOLE_BACKLOG
+        ConsoleColor color = ConsoleColor::automatic;
+
+        bool operator==(const Options& o) const { return backlogBytes == o.backlogBytes && color == o.color; }
+        bool operator!=(const Options& o) const { return !(*this == o); }
+    };
+
+    explicit BatchedConsoleSink(Options opt, std::FILE* out = stdout);
+    ~BatchedConsoleSink() override;
+
+    BatchedConsoleSink(const BatchedConsoleSink&) = delete;
+    BatchedConsoleSink& operator=(const BatchedConsoleSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+    bool colored() const { return colored_; }
+
+    std::uint64_t bytesWritten() const noexcept override { return bytes_.load(std::memory_order_relaxed); }
+    std::uint64_t droppedCount() const noexcept override { return dropped_.load(std::memory_order_relaxed); }
+
+    // CONSOLE_COLOR 값: "auto"/"always"/"never"(알 수 없으면 def)
+    static ConsoleColor parseColor(const std::string& s, ConsoleColor def);
+    // ConsoleColor::automatic이면 out이 색상 터미널인지 확인(Windows는 VT 처리 활성화 시도)
+    static bool shouldColor(ConsoleColor mode, std::FILE* out);
+
+private:
+    void run_();
+
+    Options opt_;
+    std::FILE* out_;
+    bool colored_;
+    const std::size_t reserveBytes_;      // 대기/묶음 버퍼 초기 용량(기록 스레드가 락 없이 읽음)
+
+    std::mutex mu_;
+    std::condition_variable wake_;        // 기록 스레드 깨우기
+    std::condition_variable written_;     // flush 대기자 깨우기
+    std::unique_ptr<spdlog::formatter> formatter_;   // mu_ 보호
+    spdlog::memory_buf_t formatted_;      // mu_ 보호(레코드 1개)
+    std::string pending_;                 // mu_ 보호: 다음 묶음
+    std::uint64_t appendedBytes_ = 0;     // mu_ 보호: 지금까지 붙인 바이트
+    std::uint64_t writtenBytes_ = 0;      // mu_ 보호: 기록 스레드가 끝낸 위치
+    std::uint64_t droppedNotice_ = 0;     // mu_ 보호: 다음 묶음 끝에 알릴 버린 수
+    bool stalled_ = false;                // mu_ 보호: flush 대기 시간 초과 후 기록 진행 전
+    bool stop_ = false;
+
+    std::atomic<std::uint64_t> bytes_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::thread thread_;
+};
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <spdlog/sinks/sink.h>
+#include "j2/FlushScheduler.hpp"
+
+// ALERTS_DEDUP_WINDOW_MS: 같은 메시지 반복을 창(window) 안에서 접어 한 줄 요약으로 기록
+namespace j2 {
+namespace sinks {
+
+// - 레벨 + 본문(payload) 해시로 메시지를 구분(로거 이름/스레드/시각은 무시)
+// - 창 안의 반복은 대상 싱크로 보내지 않고 세기만 함
+// - 창이 닫히면(같은 메시지 재등장, flush/sweep 시 정리, 슬롯 교체) "last message repeated N times: ..." 한 줄
+// - 추적 슬롯은 kMaxEntries개 고정(가득 차면 가장 오래 안 보인 항목을 요약 후 교체) → 메모리 상한
+// - 레벨/포맷은 대상 싱크 것을 그대로 사용(set_pattern/set_formatter는 대상으로 전달)
+class DedupSink final : public spdlog::sinks::sink, public SweepSink {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kMaxEntries = 256;   // 추적하는 서로 다른 메시지 수
+    static constexpr std::size_t kProbe = 8;          // 해시 슬롯 탐색 범위
+    static constexpr std::size_t kMaxTextBytes = 512; // 슬롯에 보관하는 본문 상한(요약/비교용)
+
+    DedupSink(spdlog::sink_ptr target, std::chrono::milliseconds window);
+    ~DedupSink() override;
+
+    DedupSink(const DedupSink&) = delete;
+    DedupSink& operator=(const DedupSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override;
+    // 닫힌 창 요약만 기록(대상 flush 없음): DURABILITY=none의 주기 정리
+    void sweep() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+    const spdlog::sink_ptr& target() const { return target_; }
+    void setWindow(std::chrono::milliseconds window);
+
+    // 대기 중인 요약을 모두 기록하고 슬롯 비움(교체/해제 전)
+    void drain();
+
+    // 접어서 대상 싱크로 보내지 않은 메시지 수
+    std::uint64_t coalesced() const noexcept { return coalesced_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        bool used = false;
+        std::size_t hash = 0;
+        spdlog::level::level_enum level = spdlog::level::off;
+        std::size_t size = 0;           // 원래 본문 길이(잘린 경우 비교 보조)
+        std::string text;               // 본문 앞부분(kMaxTextBytes 이하)
+        std::string loggerName;
+        Clock::time_point windowStart;
+        Clock::time_point lastSeen;
+        std::uint64_t repeats = 0;      // 창 안에서 접은 수
+    };
+
+    Entry* find_(std::size_t hash, const spdlog::details::log_msg& msg);
+    Entry& claim_(std::size_t hash);
+    void start_(Entry& e, std::size_t hash, const spdlog::details::log_msg& msg, Clock::time_point now);
+    void close_(Entry& e);   // 요약 기록(반복이 있을 때) 후 슬롯 비움
+
+    spdlog::sink_ptr target_;
+    std::atomic<std::int64_t> windowMs_;
+    std::mutex mu_;
+    std::array<Entry, kMaxEntries> entries_;   // mu_ 보호
+    spdlog::memory_buf_t summary_;             // mu_ 보호
+    Clock::time_point nextSweep_{};            // mu_ 보호
+    std::atomic<std::uint64_t> coalesced_{0};
+};
+
+} // namespace sinks
+} // namespace j2
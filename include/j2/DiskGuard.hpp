@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 싱크 경로별 마운트 잔여 공간 감시 스레드(채움 속도 기반 예측 + 단계별 등급)
+namespace j2 {
+
+class DiskGuard {
+public:
+    // 대상별 등급: 높을수록 심각(LoggerManager가 싱크별 강등 단계로 해석)
+    enum class Tier : std::uint8_t {
+        ok       = 0,
+        warn     = 1,  // DISK_WARN_FREE_RATIO 미만(또는 곧 도달 예측)
+        low      = 2,  // DISK_MIN_FREE_RATIO 미만
+        critical = 3   // DISK_CRITICAL_FREE_RATIO 미만
+    };
+
+    struct Config {
+        std::vector<std::string> paths;        // 감시 대상(파일 또는 디렉터리 경로), 순서 = 결과 순서
+        double warnRatio     = 10.0;           // %, 0이면 해당 단계 미사용
+        double minRatio      = 5.0;
+        double criticalRatio = 1.0;
+        unsigned timeToFullSec = 300;          // 예측 도달 시간이 이보다 짧으면 미리 강등(0: 비율만 사용)
+        std::chrono::milliseconds interval{1000};
+    };
+
+    struct Status {
+        std::string path;        // 대상 경로
+        std::string mount;       // space()를 조회한 디렉터리
+        Tier tier = Tier::ok;
+        unsigned long long avail = 0;
+        unsigned long long capacity = 0;
+        double ratio = 100.0;       // 잔여 %
+        double bytesPerSec = 0.0;   // 소비 속도(EWMA, 음수면 회복 중)
+        double secondsToFull = -1;  // 다음 임계값까지 예상 시간(-1: 증가 없음)
+        bool valid = false;         // space() 실패 시 false(등급 유지)
+    };
+
+    // 매 tick마다 전체 대상 상태로 호출(심각 상태 알림 반복은 호출 측에서 판단)
+    using Callback = std::function<void(const std::vector<Status>&)>;
+
+    // 테스트/시뮬레이션용 공간 조회 교체(기본: std::filesystem::space)
+    struct SpaceInfo {
+        unsigned long long capacity = 0;
+        unsigned long long available = 0;
+        bool ok = false;
+    };
+    using SpaceProvider = std::function<SpaceInfo(const std::string& dir)>;
+
+    DiskGuard() = default;
+    ~DiskGuard();
+
+    DiskGuard(const DiskGuard&) = delete;
+    DiskGuard& operator=(const DiskGuard&) = delete;
+
+    void start(Callback cb);
+    void stop();                           // 대기 중이어도 즉시 깨워서 종료
+    void configure(const Config& cfg);     // 스레드 대기 없이 반영(다음 tick부터)
+    void setSpaceProvider(SpaceProvider p);
+
+    bool running() const { return running_; }
+
+    // 마운트 그룹(같은 장치)마다 space() 1회, 예측 등급 계산
+    static Tier computeTier(const Config& cfg, unsigned long long avail, unsigned long long cap,
+                            double bytesPerSec, Tier current, double* secondsToNext);
+
+private:
+    struct Mount {
+        std::string dir;
+        std::uint64_t key = 0;
+        unsigned long long lastAvail = 0;
+        std::chrono::steady_clock::time_point lastAt{};
+        double rate = 0.0;
+        bool seen = false;
+    };
+
+    void run();
+    void tick();
+    static std::string mountDir(const std::string& path);
+    static std::uint64_t mountKey(const std::string& dir);
+
+    Config cfg_;
+    bool cfgDirty_ = false;
+    SpaceProvider provider_;
+    Callback cb_;
+
+    std::vector<Mount> mounts_;
+    std::vector<std::size_t> targetMount_;  // 대상 → mounts_ 인덱스
+    std::vector<Status> status_;
+
+    std::atomic<bool> running_{false};
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::thread thread_;
+};
+
+} // namespace j2
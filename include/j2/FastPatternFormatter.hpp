@@ -0,0 +1,66 @@
+#pragma once
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+#include <spdlog/formatter.h>
+#include <spdlog/pattern_formatter.h>
+
+// 기본 INI 패턴용 빠른 formatter
+// - 패턴을 한 번만 해석해 평평한 연산 목록으로 보관
+// - 초 단위로만 바뀌는 구간(%Y-%m-%d %H:%M:%S 와 사이 리터럴)은 렌더링 결과를 캐시하고
+//   초가 바뀔 때만 다시 만든다(%e/%f/%F는 매번 덧붙임)
+// - %Z(TIME_MODE)와 %P(pid)는 고정 문자열로 미리 계산
+// - 지원하지 않는 플래그/패딩이 있으면 spdlog::pattern_formatter(+TzFlag)로 대체
+namespace j2 {
+
+class FastPatternFormatter final : public spdlog::formatter {
+public:
+    // 지원하지 않는 패턴이면 nullptr
+    static std::unique_ptr<FastPatternFormatter> compile(const std::string& pattern,
+                                                         spdlog::pattern_time_type timeType,
+                                                         bool utc,
+                                                         std::string eol);
+
+    void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override;
+    std::unique_ptr<spdlog::formatter> clone() const override;
+
+private:
+    enum class Op : unsigned char {
+        literal,    // text
+        seconds,    // fields(초 단위 필드/리터럴)를 캐시해 출력
+        millis, micros, nanos,
+        level, shortLevel, thread, payload, loggerName,
+        colorStart, colorEnd
+    };
+
+    // seconds 구간 요소: flag가 0이면 text 리터럴
+    struct Field {
+        char flag = 0;
+        std::string text;
+    };
+
+    struct Item {
+        Op op = Op::literal;
+        std::string text;
+        std::vector<Field> fields;
+        std::time_t cachedSec = -1;   // seconds: 캐시된 초
+        std::string cached;           // seconds: 캐시된 렌더링 결과
+    };
+
+    FastPatternFormatter() = default;
+    void renderSeconds_(Item& item, std::time_t secs);
+
+    std::vector<Item> items_;
+    spdlog::pattern_time_type timeType_ = spdlog::pattern_time_type::local;
+    std::string eol_;
+};
+
+// 패턴에 맞는 formatter 생성: 빠른 경로가 가능하면 FastPatternFormatter, 아니면 spdlog 기본(+%Z)
+std::unique_ptr<spdlog::formatter> makePatternFormatter(const std::string& pattern,
+                                                        spdlog::pattern_time_type timeType,
+                                                        bool utc,
+                                                        std::string eol = spdlog::details::os::default_eol);
+
+} // namespace j2
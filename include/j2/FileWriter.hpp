@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <spdlog/common.h>
+#include <spdlog/details/file_helper.h>
+
+// 회전 파일 싱크의 실제 파일 기록 계층(FILE_IO_BACKEND): stdio(spdlog file_helper) 또는 io_uring
+namespace j2 {
+namespace sinks {
+
+enum class FileIoBackend { stdio, io_uring };
+
+// 호출은 모두 싱크 mutex 안에서(endSync만 예외). 실패는 spdlog_ex(file_helper와 같음)
+class FileWriter {
+public:
+    // beginSync가 넘긴 기록분의 디스크 반영 대기에 필요한 정보.
+    // fd는 beginSync가 dup 한 것(endSync가 닫음): 그 사이 회전으로 경로가 바뀌어도 같은 파일을 동기화
+    struct SyncTicket {
+        std::string path;                     // 오류 메시지용
+        int fd = -1;
+        std::uint64_t seq = 0;
+    };
+
+    virtual ~FileWriter() = default;
+
+    virtual void open(const std::string& fname, bool truncate) = 0;
+    virtual void reopen(bool truncate) = 0;
+    virtual void write(const spdlog::memory_buf_t& buf) = 0;
+    virtual void flush() = 0;                 // 버퍼를 커널로 넘김
+    virtual void close() = 0;                 // 진행 중인 기록을 모두 끝내고 닫음
+    virtual std::size_t size() const = 0;     // 넘긴 바이트 포함 파일 길이
+    virtual const std::string& filename() const = 0;
+    // 밖에서 잘린 파일(copytruncate)을 따라가 끝에 이어 쓴 횟수. 바뀌면 size()가 새 끝 기준(io_uring만 감지)
+    virtual std::uint64_t truncations() const { return 0; }
+
+    // DURABILITY=fdatasync: beginSync(싱크 mutex 안) → endSync(mutex 밖, 디스크 대기).
+    // beginSync를 부른 뒤에는 반드시 endSync 호출
+    virtual SyncTicket beginSync() = 0;
+    virtual void endSync(const SyncTicket& t) = 0;
+};
+
+// 기존 동작: stdio 버퍼 + fwrite/fflush(로깅 스레드에서 시스템 콜)
+class StdioFileWriter final : public FileWriter {
+public:
+    ~StdioFileWriter() override { closeSyncFd_(); }
+
+    void open(const std::string& fname, bool truncate) override;
+    void reopen(bool truncate) override;
+    void write(const spdlog::memory_buf_t& buf) override { file_.write(buf); }
+    void flush() override { file_.flush(); }
+    void close() override;
+    std::size_t size() const override { return file_.size(); }
+    const std::string& filename() const override { return file_.filename(); }
+
+    SyncTicket beginSync() override;
+    void endSync(const SyncTicket& t) override;
+
+private:
+    void openSyncFd_();
+    void closeSyncFd_();
+
+    spdlog::details::file_helper file_;
+    int syncFd_ = -1;   // file_helper는 fd를 내주지 않으므로 열 때 같은 파일을 따로 열어 둠(동기화 전용)
+};
+
+// io_uring 요청 시 지원되지 않으면(커널/seccomp) stdio로 대체하고 stderr에 1회 알림
+std::unique_ptr<FileWriter> makeFileWriter(FileIoBackend backend);
+
+} // namespace sinks
+} // namespace j2
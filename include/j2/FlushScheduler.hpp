@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <spdlog/common.h>
+
+// DURABILITY: spdlog::flush_every 대신 LoggerManager가 소유하는 그룹 커밋(flush/fdatasync) 스레드
+namespace j2 {
+
+// fdatasync 가능한 파일 싱크(버퍼를 비운 뒤 현재 파일 내용을 디스크까지 내림)
+class DurableSink {
+public:
+    virtual ~DurableSink() = default;
+    virtual void sync() = 0;
+
+    // DURABILITY=fdatasync: 회전/hard-reload/소멸로 파일을 닫기 전에도 디스크까지 내림(LoggerManager가 설정)
+    void setSyncOnClose(bool on) noexcept { syncOnClose_.store(on, std::memory_order_relaxed); }
+    bool syncOnClose() const noexcept { return syncOnClose_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> syncOnClose_{false};
+};
+
+// 시간이 지나면 정리할 상태가 있는 싱크(DedupSink의 닫힌 창 요약). flush와 달리 대상 버퍼는 내리지 않음
+class SweepSink {
+public:
+    virtual ~SweepSink() = default;
+    virtual void sweep() = 0;
+};
+
+// - 주기(FLUSH_EVERY_SEC) 또는 누적 바이트(FLUSH_GROUP_BYTES)마다 커밋 1회:
+//   분배 싱크 flush → (fdatasync 이면) 파일 싱크 sync
+// - FLUSH_ON_LEVEL 이상을 기록한 스레드는 직접 flush 하지 않고 commitAndWait()로 다음 커밋을 기다림.
+//   커밋이 진행 중일 때 도착한 요청들은 그다음 커밋 1회로 함께 처리(그룹 커밋)
+// - none: 커밋하지 않음(버퍼가 차거나 종료할 때만 기록), 대기도 하지 않음.
+//   주기가 있으면 스레드는 그대로 돌며 SweepSink만 정리(커밋 수에는 넣지 않음)
+class FlushScheduler {
+public:
+    enum class Durability { none, flush, fdatasync };
+
+    struct Options {
+        Durability durability = Durability::flush;
+        std::chrono::milliseconds interval{1000};   // 0: 주기 커밋 없음(요청/바이트 기준만)
+        std::size_t groupBytes = 0;                  // 0: 바이트 기준 없음
+    };
+
+    FlushScheduler() = default;
+    ~FlushScheduler();
+
+    FlushScheduler(const FlushScheduler&) = delete;
+    FlushScheduler& operator=(const FlushScheduler&) = delete;
+
+    // 처음 켜질 때(커밋 또는 주기 정리가 필요할 때) 스레드 시작, 이후에는 대기 중인 스레드에 바로 반영
+    void configure(const Options& opt);
+    // flush: 분배 싱크(콘솔/UDP 포함), sync: DurableSink 인 파일 싱크,
+    // sweep: none일 때 주기마다 sweep() 할 SweepSink(flush 커밋에서는 분배 싱크 flush가 대신함)
+    void setTargets(std::vector<spdlog::sink_ptr> flush, std::vector<spdlog::sink_ptr> sync,
+                    std::vector<spdlog::sink_ptr> sweep = {});
+    // 남은 요청을 마지막 커밋으로 처리하고 종료(이후 commitAndWait는 바로 반환)
+    void stop();
+
+    // 다음 커밋이 끝날 때까지 대기(none/정지 상태/커밋 스레드 자신이면 바로 반환).
+    // setRequestOnlyThread()를 부른 스레드는 커밋만 요청하고 기다리지 않음
+    void commitAndWait();
+    // 이 스레드(비동기 로거 워커)는 커밋을 기다리지 않음: 레코드마다 fdatasync를 기다리면 큐 전체가 밀림
+    static void setRequestOnlyThread() noexcept;
+    // 기록 바이트 누적(groupBytes > 0 일 때만 의미), 넘으면 커밋 스레드를 깨움
+    void addBytes(std::size_t n) noexcept;
+
+    bool waitsOnCommit() const noexcept { return durability_.load(std::memory_order_relaxed) != Durability::none; }
+    std::size_t groupBytes() const noexcept { return groupBytes_.load(std::memory_order_relaxed); }
+    std::uint64_t commits() const noexcept { return commits_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void commit(Durability d);
+
+    Options opt_;                                   // mu_ 보호
+    std::vector<spdlog::sink_ptr> flushTargets_;    // mu_ 보호
+    std::vector<spdlog::sink_ptr> syncTargets_;     // mu_ 보호
+    std::vector<spdlog::sink_ptr> sweepTargets_;    // mu_ 보호
+    std::uint64_t requested_ = 0;                   // 기다리는 커밋 번호(mu_ 보호)
+    std::uint64_t started_ = 0;                     // 시작한 커밋 번호(mu_ 보호)
+    std::uint64_t done_ = 0;                        // 끝난 커밋 번호(mu_ 보호)
+    bool dirty_ = false;                            // 설정 변경 알림(mu_ 보호)
+    bool stop_ = false;                             // mu_ 보호
+
+    std::atomic<Durability> durability_{Durability::none};
+    std::atomic<std::size_t> groupBytes_{0};
+    std::atomic<std::size_t> pendingBytes_{0};
+    std::atomic<std::uint64_t> commits_{0};
+
+    std::mutex mu_;
+    std::condition_variable cv_;       // 커밋 스레드 깨움
+    std::condition_variable doneCv_;   // 대기자 깨움
+    std::thread thread_;
+};
+
+} // namespace j2
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <spdlog/common.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/sink.h>
+#include "j2/FlushScheduler.hpp"
+#include "j2/SharedFormatSink.hpp"
+
+// hard-reload로 같은 경로의 파일 싱크를 새로 만들 때 파일 인계
+namespace j2 {
+namespace sinks {
+
+// 같은 파일을 두 싱크가 동시에 열면 mmap 세그먼트 truncate(이중 매핑 → SIGBUS),
+// io_uring 명시적 offset 기록 등으로 서로 덮어쓰므로:
+// 1) 이전 싱크가 기록을 막고 파일을 닫은 뒤(남은 버퍼 기록, 세그먼트 정리) make()로 새 싱크를 만들고
+// 2) 스냅샷 교체 전까지 이전 싱크로 들어오는 기록은 새 싱크로 전달
+class HandoffSink {
+public:
+    virtual ~HandoffSink() = default;
+
+    virtual const std::string& basePath() const = 0;
+
+    // make()가 예외를 던지면 파일을 다시 열고 예외를 그대로 전달
+    virtual spdlog::sink_ptr handOff(const std::function<spdlog::sink_ptr()>& make) = 0;
+
+    // 교체로 빠진 싱크(LoggerManager가 스냅샷 교체 뒤 호출): 파일을 닫고 이후 기록은 버림.
+    // 매크로 캐시가 붙잡은 바이너리 채널 등이 남아도 파일/fd를 놓게 함. 이미 인계했으면 그대로
+    void retire() {
+        if (!handedOff()) handOff([]() { return spdlog::sink_ptr(); });
+    }
+
+protected:
+    // 인계 후에는 successor_가 바뀌지 않음(handedOff() 확인 뒤 읽음). retire() 뒤에는 nullptr
+    bool handedOff() const noexcept { return handedOff_.load(std::memory_order_acquire); }
+    void setSuccessor_(spdlog::sink_ptr next) {
+        successor_ = std::move(next);
+        handedOff_.store(true, std::memory_order_release);
+    }
+
+    void forward(const spdlog::details::log_msg& msg) const {
+        if (successor_ && successor_->should_log(msg.level)) successor_->log(msg);
+    }
+    // 이미 포맷한 버퍼는 출력이 같을 때(같은 키)만 재사용, 아니면 새 싱크가 직접 포맷
+    void forwardRendered(const spdlog::details::log_msg& msg, std::size_t key,
+                         const spdlog::memory_buf_t& formatted) const {
+        if (!successor_ || !successor_->should_log(msg.level)) return;
+        auto* sh = dynamic_cast<SharedFormatSink*>(successor_.get());
+        if (sh && key != 0 && sh->formatKey() == key) sh->logRendered(msg, formatted);
+        else                                          successor_->log(msg);
+    }
+    const spdlog::sink_ptr& successor() const noexcept { return successor_; }
+    void forwardFlush() const {
+        if (successor_) successor_->flush();
+    }
+    void forwardSync() const {
+        if (auto* d = dynamic_cast<DurableSink*>(successor_.get())) d->sync();
+    }
+
+private:
+    spdlog::sink_ptr successor_;
+    std::atomic<bool> handedOff_{false};
+};
+
+} // namespace sinks
+} // namespace j2
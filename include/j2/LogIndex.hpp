@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include <spdlog/common.h>
+
+// FILE_INDEX: 로그 파일 옆 사이드카 색인(all.log → all.log.idx, all.1.log.gz → all.1.log.idx)
+// 블록(연속된 레코드 묶음)마다 바이트 범위, 시각 범위, 레벨 비트맵을 기록해
+// j2_log_query가 시간 범위로 바로 이동하고 원하는 레벨이 없는 블록을 건너뛰게 함
+namespace j2 {
+namespace sinks {
+
+// 디스크 형식(네이티브 엔디언): 헤더 16바이트 + 블록 항목 32바이트 반복
+// - 열린 블록은 flush 때 마지막 항목으로 기록하고, 블록이 닫힐 때까지 그 자리를 덮어씀
+// - 같은 offset 항목이 여러 번이면 마지막 것이 유효(이어 쓰기 전의 색인과 겹칠 때)
+// - offset은 압축 전 파일 기준, 색인이 덮지 않는 구간은 조회 시 처음부터 끝까지 읽음
+struct LogIndexHeader {
+    char magic[8];                 // "J2LIDX01"
+    std::uint32_t blockBytes;      // 기록 당시 FILE_INDEX_BLOCK(참고용)
+    std::uint32_t reserved;
+};
+
+struct LogIndexBlock {
+    std::uint64_t offset = 0;      // 블록 첫 레코드 위치
+    std::uint32_t length = 0;      // 블록 바이트 수(레코드 경계에서 끝남)
+    std::uint16_t levels = 0;      // bit(level): 블록에 있는 레벨
+    std::uint16_t reserved = 0;
+    std::int64_t minNs = 0;        // 블록 레코드 시각 범위(epoch ns, 스레드 간 역순 포함)
+    std::int64_t maxNs = 0;
+};
+
+static_assert(sizeof(LogIndexHeader) == 16, "LogIndexHeader layout");
+static_assert(sizeof(LogIndexBlock) == 32, "LogIndexBlock layout");
+
+// 회전 싱크가 mutex 안에서 사용. 기록 실패는 색인만 포기(로그 기록에는 영향 없음)
+class LogIndexWriter {
+public:
+    explicit LogIndexWriter(std::size_t blockBytes);
+    ~LogIndexWriter();
+
+    LogIndexWriter(const LogIndexWriter&) = delete;
+    LogIndexWriter& operator=(const LogIndexWriter&) = delete;
+
+    // offset: 이어 쓸 로그 파일 위치(truncate면 0). 기존 색인이 offset 너머를 덮으면 새로 시작
+    void open(const std::string& logPath, bool truncate, std::uint64_t offset);
+    void note(std::uint64_t offset, std::size_t len, spdlog::log_clock::time_point t, spdlog::level::level_enum lvl);
+    void flush();                  // 열린 블록 항목 기록(이미 있으면 덮어씀) + fflush
+    void close();                  // 마지막 블록 확정
+
+    // 로그 파일 경로 → 색인 경로(압축 확장자 제외 + ".idx")
+    static std::string pathFor(const std::string& logPath);
+
+private:
+    void emit_();
+    void closeBlock_();            // cur_ 확정 후 다음 블록은 새 항목으로
+
+    std::size_t blockBytes_;
+    std::FILE* fp_ = nullptr;
+    LogIndexBlock cur_;
+    bool dirty_ = false;           // cur_가 마지막 기록 이후 바뀜
+    bool entryWritten_ = false;    // cur_ 항목이 이미 파일에 있음(entryPos_에 덮어씀)
+    std::uint64_t entryPos_ = 0;
+};
+
+// 색인 읽기: 중복 offset 정리(마지막 항목), offset 순 정렬, 겹침 제거, fileSize로 자름
+// 색인이 없거나 형식이 다르면 false
+bool loadLogIndex(const std::string& logPath, std::uint64_t fileSize, std::vector<LogIndexBlock>& out);
+
+// 회전 파일 순차 읽기(.gz/.zst 백업은 풀면서 읽음, 위치는 압축 전 기준, 뒤로 이동 불가)
+class LogFileReader {
+public:
+    LogFileReader();
+    ~LogFileReader();
+
+    LogFileReader(const LogFileReader&) = delete;
+    LogFileReader& operator=(const LogFileReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool compressed() const;
+    std::uint64_t size() const;    // 압축 파일은 알 수 없음(UINT64_MAX)
+    bool skipTo(std::uint64_t offset);
+    std::size_t read(char* dst, std::size_t n);   // 0: EOF/오류
+    std::uint64_t position() const { return pos_; }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+    std::uint64_t pos_ = 0;
+};
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <spdlog/spdlog.h>
+
+// 매크로용 로거 핸들 캐시(spdlog::get 레지스트리 락 회피)
+namespace j2 {
+
+namespace binlog {
+struct Channel;
+std::shared_ptr<Channel> findChannel(const std::string& logger);
+} // namespace binlog
+
+namespace backtrace {
+struct Target;
+std::shared_ptr<Target> findTarget(const std::string& logger);
+} // namespace backtrace
+
+// 로거 구성 세대 번호: LoggerManager가 로거 등록/교체/해제 시 증가시킨다
+inline std::atomic<std::uint64_t>& loggerGeneration() {
+    static std::atomic<std::uint64_t> gen{1};
+    return gen;
+}
+
+inline void bumpLoggerGeneration() {
+    loggerGeneration().fetch_add(1, std::memory_order_acq_rel);
+}
+
+// 호출 지점별(thread_local) 캐시: 세대가 바뀌지 않았으면 레지스트리 조회 없이 재사용.
+// 로거/바이너리 채널/백트레이스 대상 모두 강한 참조(쓸 때 원자 연산 없음). 교체·해제된 쪽은 LoggerManager가
+// 분배 싱크를 비우고 빠진 파일 싱크를 닫으므로, 갱신 전의 캐시가 파일을 붙잡지 않음
+class LoggerHandle {
+public:
+    explicit LoggerHandle(const char* name) : name_(name) {}
+
+    spdlog::logger* get() {
+        std::uint64_t gen = loggerGeneration().load(std::memory_order_acquire);
+        if (gen != gen_) {
+            logger_ = spdlog::get(name_);
+            channel_ = binlog::findChannel(name_);
+            backtrace_ = backtrace::findTarget(name_);
+            gen_ = gen;
+        }
+        return logger_.get();
+    }
+
+    // FILE_FORMAT=binary 일 때만 존재(get() 이후 호출)
+    binlog::Channel* binary() const { return channel_.get(); }
+
+    // BACKTRACE_DEPTH > 0 일 때만 존재(get() 이후 호출)
+    backtrace::Target* backtrace() const { return backtrace_.get(); }
+
+private:
+    const char* name_;
+    std::uint64_t gen_ = 0;
+    std::shared_ptr<spdlog::logger> logger_;
+    std::shared_ptr<binlog::Channel> channel_;
+    std::shared_ptr<backtrace::Target> backtrace_;
+};
+
+} // namespace j2
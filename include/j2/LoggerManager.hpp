@@ -5,16 +5,33 @@
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <vector>
 #include <filesystem>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
 #include <boost/asio.hpp>
 #include <spdlog/logger.h>
+#include <spdlog/async_logger.h>
+#include <spdlog/details/thread_pool.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
-#include <spdlog/sinks/rotating_file_sink.h>
-#include <spdlog/sinks/dist_sink.h>
 #include "SimpleIni.h"
+#include "j2/SnapshotDistSink.hpp"
+#include "j2/ConsoleSink.hpp"
+#include "j2/RotatingFileSink.hpp"
+#include "j2/MmapFileSink.hpp"
+#include "j2/BinaryLog.hpp"
+#include "j2/ConfigWatcher.hpp"
+#include "j2/DiskGuard.hpp"
+#include "j2/FlushScheduler.hpp"
+#include "j2/SinkStats.hpp"
+#include "j2/UdpTransport.hpp"
+#include "j2/UdpSyslogSink.hpp"
+#include "j2/DedupSink.hpp"
+#include "j2/Backtrace.hpp"
+#include "j2/ShmRing.hpp"
+#include "j2/ShmSink.hpp"
 
 // INI 기반 spdlog 구성/리로드/디스크 감시/UDP 알림을 제공하는 로거 매니저
 namespace j2 {
@@ -31,27 +48,134 @@ public:
 
     std::shared_ptr<spdlog::logger> getLogger() const;
 
+    // CATEGORIES로 선언한 카테고리 로거(없으면 nullptr). 매크로는 카테고리 이름을 hname으로 사용
+    std::shared_ptr<spdlog::logger> getLogger(const std::string& category) const;
+
     bool reloadIfChanged();
     bool startAutoReload(unsigned interval_sec = 60);
     void stopAutoReload();
 
+    // 비동기 모드에서 큐 초과로 버려진 메시지 누적 수(동기 모드면 0)
+    std::size_t asyncDroppedCount() const;
+
+    // 디스크 감시 등급(락 없이 조회)
+    // all: warn → ALL 파일 레벨 warn 이상으로 상향, low 이상 → ALL 파일 분리
+    // alerts: critical → alerts 파일 분리(마지막 단계)
+    struct DiskState {
+        DiskGuard::Tier all    = DiskGuard::Tier::ok;
+        DiskGuard::Tier alerts = DiskGuard::Tier::ok;
+    };
+    DiskState diskState() const noexcept;
+
+    // 디스크 공간 조회 교체(시뮬레이션/부하 테스트용, 기본: std::filesystem::space)
+    void setDiskSpaceProvider(DiskGuard::SpaceProvider provider);
+
+    // 자체 계측 스냅샷(누적값). 싱크는 현재 켜져 있는 것만(console, all, alerts, udp, shm 순)
+    struct Stats {
+        std::chrono::system_clock::time_point at;
+        std::vector<SinkStatsSnapshot> sinks;
+        std::size_t   asyncDropped = 0;
+        std::uint64_t allDiskDetaches = 0;     // 디스크 감시로 all.log를 분리한 횟수
+        std::uint64_t alertsDiskDetaches = 0;  // 디스크 감시로 alerts.log를 분리한 횟수
+        std::uint64_t alertsCoalesced = 0;     // ALERTS_DEDUP_WINDOW_MS로 접은 alerts 메시지 수
+        std::uint64_t rateLimited = 0;         // 출력 제한 매크로(X_every/X_rate/X_first)로 억제된 수(프로세스 전체)
+        std::uint64_t flushCommits = 0;        // DURABILITY 그룹 커밋 수
+        DiskState     disk;
+    };
+    Stats stats() const;
+
+    // SHM_NAME/SHM_ROLE(init-only): 여러 프로세스의 레코드를 공유 메모리 링으로 모아 수집기 1개가 기록
+    // - producer: 파일 싱크(all/alerts/카테고리 전용 파일) 대신 링으로 보냄(콘솔/UDP는 그대로)
+    // - collector: j2_log_collector가 링을 읽어 forward()로 이 매니저의 싱크에 기록
+    enum class ShmRole { off, producer, collector };
+    ShmRole shmRole() const;
+    ShmRing::Options shmOptions() const;
+
+    // 다른 프로세스에서 온 레코드 기록: logger_name이 카테고리면 그 카테고리 싱크, 아니면 기본 싱크.
+    // 원래 시각/스레드 id 유지, 로거 레벨 적용, FLUSH_ON_LEVEL 이상이면 그룹 커밋 대기(비동기 큐는 거치지 않음)
+    void forward(const spdlog::details::log_msg& msg);
+
 private:
+    // 파일 싱크 종류(ALL_SINK_TYPE), 기록 형식(FILE_FORMAT)
+    enum class FileSinkType { file, mmap };
+    enum class FileFormat { text, binary };
+    // 텍스트 파일 레코드 모양(FILE_FORMAT=json|logfmt, soft-load, 카테고리 파일에도 적용)
+    enum class FileLayout { pattern, json, logfmt };
+
+    // 파일 싱크별 재생성이 필요한 옵션(hard-load)
+    struct FileSinkOptions {
+        FileSinkType type = FileSinkType::file;
+        FileFormat format = FileFormat::text;
+        j2::sinks::RotateCompress compress = j2::sinks::RotateCompress::none;
+        j2::sinks::RotatePolicy rotate;   // ROTATE_NAMING, ROTATE_INTERVAL
+        j2::sinks::FileIoBackend io = j2::sinks::FileIoBackend::stdio;   // FILE_IO_BACKEND(mmap은 무시)
+        std::size_t indexBlock = 0;       // FILE_INDEX_BLOCK(0: FILE_INDEX 꺼짐, 텍스트 회전 파일만)
+
+        bool operator==(const FileSinkOptions& o) const {
+            return type == o.type && format == o.format && compress == o.compress && rotate == o.rotate &&
+                   io == o.io && indexBlock == o.indexBlock;
+        }
+        bool operator!=(const FileSinkOptions& o) const { return !(*this == o); }
+    };
+
+    // 콘솔 싱크 재생성이 필요한 옵션(hard-load)
+    struct ConsoleSinkOptions {
+        bool batched = false;                          // CONSOLE_BATCHED
+        j2::sinks::BatchedConsoleSink::Options batch;  // CONSOLE_BACKLOG, CONSOLE_COLOR
+
+        bool operator==(const ConsoleSinkOptions& o) const { return batched == o.batched && batch == o.batch; }
+        bool operator!=(const ConsoleSinkOptions& o) const { return !(*this == o); }
+    };
+
     bool loadConfig(bool readAutoReload);
     void applySoftSettings();
     void applyHardSettingsIfNeeded(
-        bool old_enableConsole, bool old_enableFileAll, bool old_enableFileAlerts,
+        bool old_enableConsole, const ConsoleSinkOptions& old_consoleOpts,
+        bool old_enableFileAll, bool old_enableFileAlerts,
         const std::string& old_allPath, const std::string& old_alertsPath,
         std::size_t old_allMaxSize, std::size_t old_allMaxFiles,
-        std::size_t old_alertMaxSize, std::size_t old_alertMaxFiles);
+        std::size_t old_alertMaxSize, std::size_t old_alertMaxFiles,
+        const FileSinkOptions& old_allOpts, const FileSinkOptions& old_alertsOpts,
+        const j2::sinks::UdpSyslogSink::Options& old_udpSinkOpts);
+    std::shared_ptr<j2::sinks::UdpSyslogSink> makeUdpSink();
+    spdlog::sink_ptr makeConsoleSink() const;
+    std::unique_ptr<spdlog::formatter> makeFileFormatter(spdlog::pattern_time_type timeType, std::size_t& key) const;
+    spdlog::sink_ptr makeFileSink(const std::string& path, std::size_t maxSize,
+                                  std::size_t maxFiles, const FileSinkOptions& opts,
+                                  const spdlog::sink_ptr& previous = nullptr);
+    void periodicTick();
+    void createLogger();
+    std::shared_ptr<spdlog::logger> makeLogger(const std::string& name, spdlog::sink_ptr sink);
+    void publishSinks();
+    bool syncAlertsDedup();
+    void syncCategories(const spdlog::formatter& fileFmt, std::size_t fileKey);
+    void publishCategorySinks();
+    void dropCategories();
+    void publishBinaryChannel();
+    void publishBacktraceTargets();
+    void retireBacktraceSinks();
+    void publishFlushTargets();
+    void drainAsyncQueue();
+    void startStatsThread();
+    void stopStatsThread();
+    void statsLoop();
+    Stats collectStats(bool endInterval) const;   // endInterval: 주기 요약용(구간 최대 초기화)
+    void logStatsSummary(const Stats& prev, const Stats& cur, double seconds);
+    void reportAsyncDrops();
     static void ensureParentDir(const std::string& path);
     bool toBool(const std::string& val, bool default_val) const;
     std::string toLower(const std::string& s) const;
     std::size_t parseSizeBytes(const std::string& s, std::size_t default_val) const;
+    std::chrono::seconds parseInterval(const std::string& s) const;
     spdlog::level::level_enum parseLevel(const std::string& s,
                                          spdlog::level::level_enum def) const;
 
     // 디스크 감시 + UDP 알림
-    void checkDiskAndAct();
+    void configureDiskGuard();
+    void onDiskStatus(const std::vector<DiskGuard::Status>& status);
+    bool allDetachedForDisk() const { return allDiskTier_ >= DiskGuard::Tier::low; }
+    bool alertsDetachedForDisk() const { return alertsDiskTier_ >= DiskGuard::Tier::critical; }
+    spdlog::level::level_enum effectiveAllLevel() const;
     bool sendUdpAlert(const std::string& msg);
     std::string buildUdpMessage(const std::string& tmpl,
                                 const std::string& path,
@@ -69,6 +193,7 @@ private:
     bool utcMode_ = false;
 
     bool enableConsole_    = true;
+    ConsoleSinkOptions consoleOpts_;
     bool enableFileAll_    = true;
     bool enableFileAlerts_ = true;
 
@@ -80,9 +205,52 @@ private:
 
     std::size_t flushEverySec_ = 1;
 
+    // DURABILITY/FLUSH_EVERY_SEC/FLUSH_GROUP_BYTES(soft-load): 그룹 커밋 스레드(spdlog::flush_every 대체)
+    FlushScheduler::Durability durability_ = FlushScheduler::Durability::flush;
+    std::size_t flushGroupBytes_ = 0;
+    std::shared_ptr<FlushScheduler> flushScheduler_ = std::make_shared<FlushScheduler>();
+
+    // 자체 계측: 역할별 누적값(hard-reload로 싱크가 바뀌어도 이어짐), STATS_EVERY_SEC 요약 스레드
+    std::shared_ptr<SinkStats> consoleStats_ = std::make_shared<SinkStats>("console");
+    std::shared_ptr<SinkStats> allStats_     = std::make_shared<SinkStats>("all");
+    std::shared_ptr<SinkStats> alertsStats_  = std::make_shared<SinkStats>("alerts");
+    std::shared_ptr<SinkStats> udpStats_     = std::make_shared<SinkStats>("udp");
+    std::shared_ptr<SinkStats> shmStats_     = std::make_shared<SinkStats>("shm");
+    std::uint64_t allDiskDetaches_ = 0;     // mu_ 보호
+    std::uint64_t alertsDiskDetaches_ = 0;  // mu_ 보호
+    unsigned statsEverySecCfg_ = 0;         // INI 값(soft-load)
+    std::atomic<unsigned> statsEverySec_{0};  // 요약 스레드가 읽는 값
+    std::thread statsThread_;
+    std::mutex statsMu_;
+    std::condition_variable statsCv_;
+    bool statsStop_ = false;    // statsMu_ 보호
+    bool statsKick_ = false;    // statsMu_ 보호(주기 변경 알림)
+
+    // 출력 제한 매크로 기본값(RATE_LIMIT_*, soft-load) → rateLimitDefaults()
+    unsigned rateEveryN_ = 100;
+    unsigned ratePerSec_ = 10;
+    unsigned rateBurst_ = 0;
+    unsigned rateFirstN_ = 10;
+
+    // 비동기 모드(init-only)
+    enum class AsyncOverflow { block, drop_oldest, drop_newest };
+    bool          asyncMode_       = false;
+    std::size_t   asyncQueueSize_  = 8192;
+    std::size_t   asyncThreads_    = 1;
+    AsyncOverflow asyncOverflow_   = AsyncOverflow::block;
+    std::shared_ptr<spdlog::details::thread_pool> threadPool_;
+    std::shared_ptr<std::atomic<std::size_t>> asyncQueueSlots_ =     // drop_newest: 예약한 큐 자리
+        std::make_shared<std::atomic<std::size_t>>(0);
+    std::shared_ptr<std::atomic<std::size_t>> asyncDroppedNewest_ =
+        std::make_shared<std::atomic<std::size_t>>(0);
+    std::size_t asyncDropsReported_ = 0;
+
     // 기본값은 INI에서 덮어씀(필요 시 %Z를 패턴에 넣어 사용 가능)
     std::string patternConsole_ = "[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [%t] %v";
     std::string patternFile_    = "[%Y-%m-%d %H:%M:%S.%e] [%l] [%t] %v";
+    FileLayout fileLayout_ = FileLayout::pattern;   // json/logfmt 이면 PATTERN_FILE 무시
+    bool structuredAsyncWarned_ = false;            // json/logfmt + ASYNC_MODE 경고(1회)
+    bool binaryAsyncWarned_ = false;                // binary + ASYNC_MODE 경고(1회)
 
     std::string allPath_    = "logs/all.log";
     std::string alertsPath_ = "logs/alerts.log";
@@ -92,33 +260,95 @@ private:
     std::size_t alertMaxSize_  = 100 * 1024 * 1024;
     std::size_t alertMaxFiles_ = 10;
 
-    // 디스크 감시(단일)
+    // 싱크 종류/형식(all만 mmap·binary 선택 가능), 회전 파일 압축(none/gzip/zstd)
+    FileSinkOptions allOpts_;
+    FileSinkOptions alertsOpts_;
+
+    // 카테고리 로거: [Log] CATEGORIES=a,b + 섹션 [Log.a] (soft-load, 로거는 이름으로 등록)
+    // - SINKS=shared: 공용 싱크(콘솔/all/alerts/udp)를 그대로 공유(distSink_)
+    // - SINKS=dedicated|both: 전용 회전 파일(FILE) 추가, 디스크 감시는 all.log와 같은 등급 적용
+    struct CategoryConfig {
+        std::string name;
+        spdlog::level::level_enum level = spdlog::level::trace;
+        bool shared = true;
+        std::string file;           // 비어 있으면 전용 파일 없음
+        std::size_t maxSize = 0;
+        std::size_t maxFiles = 0;
+    };
+    struct Category {
+        CategoryConfig cfg;
+        FileSinkOptions fileOpts;
+        spdlog::sink_ptr fileSink;
+        std::shared_ptr<SinkStats> fileStats;
+        std::shared_ptr<j2::sinks::SnapshotDistSink> dist;   // 로거의 유일한 싱크(구성은 교체 가능)
+        std::shared_ptr<spdlog::logger> logger;
+    };
+    std::vector<CategoryConfig> categoryCfg_;   // INI 값
+    std::vector<std::string> backtraceNames_;   // 등록한 backtrace 대상(로거 이름)
+    std::vector<std::shared_ptr<j2::sinks::SnapshotDistSink>> backtraceDists_;   // 등록한 대상의 싱크
+    std::vector<std::shared_ptr<j2::sinks::SnapshotDistSink>> retiredBacktrace_; // 세대 갱신 뒤 비울 이전 대상
+
+    // BACKTRACE_DEPTH(soft-load): 걸러진 매크로 레코드를 스레드당 N개 원시 보관, 트리거 레벨에서 파일로 기록
+    std::size_t backtraceDepth_ = 0;
+    spdlog::level::level_enum backtraceTrigger_ = spdlog::level::err;
+    std::vector<Category> categories_;          // 적용 상태(mu_ 보호)
+
+    // 디스크 감시(싱크 경로별 마운트 + 선택적 DISK_ROOT, 전용 타이머)
     bool        diskGuardEnable_ = true;
     std::string diskRoot_;
-    double      diskMinFreeRatio_ = 5.0;
+    double      diskWarnFreeRatio_     = 10.0;
+    double      diskMinFreeRatio_      = 5.0;
+    double      diskCriticalFreeRatio_ = 1.0;
+    unsigned    diskTimeToFullSec_     = 300;
+    unsigned    diskGuardIntervalMs_   = 1000;
+    DiskGuard   diskGuard_;
 
-    // UDP 알림(Boost.Asio)
+    // UDP 알림(Boost.Asio, 영구 소켓 + 백그라운드 전송)
     std::string udpIp_;
     unsigned    udpPort_ = 0;
+    std::unique_ptr<UdpTransport> alertTransport_;
+    std::string alertTarget_;   // alertTransport_에 설정된 "ip:port"
+
+    // UDP_SINK: RFC 5424 syslog 전달(host 비어 있으면 사용 안 함)
+    j2::sinks::UdpSyslogSink::Options udpSinkOpts_;
+    spdlog::level::level_enum udpSinkMin_ = spdlog::level::info;
+    std::string patternUdp_ = "%v";
     unsigned    udpIntervalSec_ = 60;
     std::string udpMessageTmpl_ = "DISK LOW: path={path} free={avail_bytes}B ({ratio}%)";
     std::chrono::steady_clock::time_point lastUdpSent_{};
 
-    // 파일 싱크 분리 상태
-    bool fileSinksDetachedForDisk_ = false;
+    // 공유 메모리 전송(init-only, SHM_NAME 비어 있으면 사용 안 함)
+    ShmRole shmRole_ = ShmRole::off;
+    ShmRing::Options shmOpts_;
+
+    // 디스크 등급(적용 상태는 mu_ 보호, 조회용 복사본은 원자 변수: all | alerts << 4)
+    DiskGuard::Tier allDiskTier_    = DiskGuard::Tier::ok;
+    DiskGuard::Tier alertsDiskTier_ = DiskGuard::Tier::ok;
+    std::atomic<std::uint8_t> diskState_{0};
 
     // 로거/싱크
     std::shared_ptr<spdlog::logger> logger_;
-    std::shared_ptr<spdlog::sinks::stdout_color_sink_mt> consoleSink_;
-    std::shared_ptr<spdlog::sinks::rotating_file_sink_mt> allSink_;
-    std::shared_ptr<spdlog::sinks::rotating_file_sink_mt> alertsSink_;
-    std::shared_ptr<spdlog::sinks::dist_sink_mt> distSink_;
+    spdlog::sink_ptr consoleSink_;   // stdout_color_sink_mt 또는 BatchedConsoleSink(CONSOLE_BATCHED)
+    spdlog::sink_ptr allSink_;     // RotatingFileSink, MmapFileSink 또는 BinaryFileSink
+    spdlog::sink_ptr alertsSink_;
+    std::shared_ptr<j2::sinks::DedupSink> alertsDedup_;   // ALERTS_DEDUP_WINDOW_MS > 0 이면 alertsSink_ 앞에 둠
+    unsigned alertsDedupWindowMs_ = 0;                    // INI 값(soft-load, 0: 사용 안 함)
+    std::uint64_t alertsCoalescedCarried_ = 0;            // 교체된 DedupSink의 누적값(mu_ 보호)
+    std::shared_ptr<j2::sinks::UdpSyslogSink> udpSink_;
+    std::shared_ptr<j2::sinks::ShmSink> shmSink_;          // SHM_ROLE=producer
+    std::shared_ptr<j2::sinks::RotationWorker> rotationWorker_;
+    std::shared_ptr<j2::sinks::SnapshotDistSink> distSink_;
+
+    // FILE_FORMAT=binary: 매크로 경로는 ALL 파일을 직접 기록하고, 나머지 싱크는 textLogger_로
+    std::shared_ptr<j2::sinks::SnapshotDistSink> textDistSink_;
+    std::shared_ptr<spdlog::logger> textLogger_;
 
     // 공통 상태
     std::filesystem::file_time_type lastWriteTime_{};
-    std::atomic<bool> autoReloadRunning_{false};
-    std::thread autoReloadThread_;
+    ConfigWatcher watcher_;
+    ConfigWatcher::Backend watchBackend_ = ConfigWatcher::Backend::automatic;
     unsigned autoReloadIntervalSec_{60};
+    unsigned autoReloadDebounceMs_{200};
     mutable std::mutex mu_;
 };
 
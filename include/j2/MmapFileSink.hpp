@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <system_error>
+#include <spdlog/sinks/sink.h>
+#include "j2/FlushScheduler.hpp"
+#include "j2/HandoffSink.hpp"
+#include "j2/RotationWorker.hpp"
+#include "j2/SharedFormatSink.hpp"
+#include "j2/SinkStats.hpp"
+
+// ALL_SINK_TYPE=mmap: 미리 할당(fallocate)한 세그먼트 파일을 mmap 하여 직접 복사하는 싱크
+namespace j2 {
+namespace sinks {
+
+// - 포맷: 스레드별 formatter 복제본으로 락 없이 수행
+// - 공간 예약: 현재 세그먼트의 원자적 커서(CAS)로 예약 후 memcpy (여러 스레드 동시 복사)
+// - 회전/종료: 배타 락으로 진행 중인 복사를 기다린 뒤 실제 길이로 truncate,
+//   백업 번호 밀기/압축은 RotatingFileSink와 같이 RotationWorker에 위임
+// - 세그먼트보다 긴 레코드는 앞부분 + " [truncated]" 표시로 잘라 기록하고 truncatedCount()로 셈
+// - 미리 할당이 ENOSPC 등으로 실패하면 매핑하지 않고 pwrite로 기록(디스크가 찼을 때 SIGBUS 방지),
+//   기록 실패는 버리고 droppedCount()로 셈. 다음 회전에서 다시 매핑 시도
+// - 같은 경로로 교체(hard-reload): handOff()로 세그먼트를 정리한 뒤 새 싱크가 파일을 엶
+class MmapFileSink final : public spdlog::sinks::sink, public SharedFormatSink, public SinkCounters,
+                           public DurableSink, public HandoffSink {
+public:
+    MmapFileSink(std::string base_filename,
+                 std::size_t max_size,
+                 std::size_t max_files,
+                 std::shared_ptr<RotationWorker> worker,
+                 RotateCompress compress = RotateCompress::none);
+    ~MmapFileSink() override;
+
+    MmapFileSink(const MmapFileSink&) = delete;
+    MmapFileSink& operator=(const MmapFileSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+    void setSharedFormatter(std::unique_ptr<spdlog::formatter> f, std::size_t key) override;
+    void logRender(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override;
+    void logRendered(const spdlog::details::log_msg& msg, const spdlog::memory_buf_t& formatted) override;
+
+    // 닫힌 세그먼트 누적 + 현재 커서(레코드마다 별도 원자 연산을 더하지 않음)
+    std::uint64_t bytesWritten() const noexcept override;
+    std::uint64_t rotationCount() const noexcept override { return rotations_.load(std::memory_order_relaxed); }
+    std::uint64_t droppedCount() const noexcept override { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t truncatedCount() const noexcept override { return truncated_.load(std::memory_order_relaxed); }
+
+    // DURABILITY=fdatasync: 기록된 범위를 msync(MS_SYNC)
+    void sync() override;
+
+    const std::string& basePath() const override { return base_filename_; }
+    spdlog::sink_ptr handOff(const std::function<spdlog::sink_ptr()>& make) override;
+
+    static bool supported();
+
+private:
+    struct Segment {
+        int fd = -1;
+        char* base = nullptr;
+        std::size_t capacity = 0;
+        std::atomic<std::size_t> cursor{0};
+        std::atomic<std::size_t> startSize{0};  // 열 때 이미 있던 길이(이어 쓰기)
+    };
+
+    bool write(const char* data, std::size_t n);   // false: 세그먼트 없음(열기 실패/인계 후)
+    bool writeDirect(const char* data, std::size_t n);   // 매핑 없는 세그먼트, rwMu_ 공유 보유
+    bool reserve(std::size_t n, std::size_t& offset);
+    void openSegment(bool keep = false);   // rwMu_ 배타 보유 상태에서 호출
+    void reportRenameFailure(const std::error_code& ec);   // 처음 한 번만 stderr, rwMu_ 배타 보유
+    void closeSegment();  // rwMu_ 배타 보유 상태에서 호출
+    void rotate();        // rwMu_ 배타 보유 상태에서 호출
+    spdlog::formatter& threadFormatter();
+
+    std::string base_filename_;
+    std::size_t max_size_;
+    std::size_t max_files_;
+    RotateCompress compress_;
+    std::shared_ptr<RotationWorker> worker_;
+    std::size_t stage_seq_ = 0;
+    bool renameWarned_ = false;
+
+    std::shared_mutex rwMu_;  // 공유: 복사 중, 배타: 세그먼트 교체
+    Segment seg_;
+    std::mutex directMu_;     // 매핑 없는 세그먼트의 pwrite 직렬화
+    std::uint64_t segId_ = 0;
+    std::atomic<std::uint64_t> closedBytes_{0};
+    std::atomic<std::uint64_t> rotations_{0};
+    std::atomic<std::uint64_t> truncated_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    // 스레드별 formatter 캐시 무효화용
+    const std::uint64_t sinkId_;
+    std::atomic<std::uint64_t> fmtGen_{1};
+    std::mutex fmtMu_;
+    std::unique_ptr<spdlog::formatter> formatter_;
+};
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <spdlog/logger.h>
+#include <spdlog/fmt/fmt.h>
+
+// 호출 지점별 출력 제한(he_every / he_rate / he_first 등): 재시도 루프의 같은 줄 폭주 방지
+namespace j2 {
+
+// INI 기본값(RATE_LIMIT_*): 매크로에 0을 주면 사용. 프로세스 전역(마지막으로 적용한 LoggerManager 값)
+struct RateLimitDefaults {
+    std::atomic<std::uint32_t> everyN{100};
+    std::atomic<std::uint32_t> perSecond{10};
+    std::atomic<std::uint32_t> burst{0};     // 0이면 perSecond와 같음
+    std::atomic<std::uint32_t> firstN{10};
+};
+
+inline RateLimitDefaults& rateLimitDefaults() {
+    static RateLimitDefaults d;
+    return d;
+}
+
+// 호출 지점 1개의 상태(함수 내 static, 모든 스레드 공유). 검사는 원자 연산만 사용
+class SiteLimiter {
+public:
+    enum class Kind { everyN, perSecond, firstN };
+
+    SiteLimiter(const char* file, int line);
+
+    SiteLimiter(const SiteLimiter&) = delete;
+    SiteLimiter& operator=(const SiteLimiter&) = delete;
+
+    // 출력하면 true, 이때 suppressedSinceLast에 직전 출력 이후 억제된 수
+    bool allow(Kind kind, std::uint32_t n, std::uint64_t& suppressedSinceLast) noexcept {
+        bool ok = false;
+        switch (kind) {
+        case Kind::everyN: {
+            if (n == 0) n = rateLimitDefaults().everyN.load(std::memory_order_relaxed);
+            std::uint64_t c = calls_.fetch_add(1, std::memory_order_relaxed);
+            ok = n <= 1 || c % n == 0;
+            break;
+        }
+        case Kind::firstN: {
+            if (n == 0) n = rateLimitDefaults().firstN.load(std::memory_order_relaxed);
+            // 조용해진 뒤에는 calls_를 더 올리지 않음(읽기만)
+            ok = calls_.load(std::memory_order_relaxed) < n &&
+                 calls_.fetch_add(1, std::memory_order_relaxed) < n;
+            break;
+        }
+        case Kind::perSecond:
+            ok = takeToken(n);
+            break;
+        }
+        if (!ok) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        std::uint64_t s = suppressed_.load(std::memory_order_relaxed);
+        std::uint64_t prev = reported_.exchange(s, std::memory_order_relaxed);
+        suppressedSinceLast = s > prev ? s - prev : 0;
+        return true;
+    }
+
+    std::uint64_t suppressed() const noexcept { return suppressed_.load(std::memory_order_relaxed); }
+    const char* file() const noexcept { return file_; }
+    int line() const noexcept { return line_; }
+
+    // 지금까지 만들어진 모든 호출 지점의 억제 수 합계(통계용)
+    static std::uint64_t totalSuppressed() noexcept;
+
+private:
+    // 토큰 버킷(GCRA): 원자 변수 하나(다음 허용 이론 시각)를 CAS로 전진
+    bool takeToken(std::uint32_t perSec) noexcept {
+        auto& d = rateLimitDefaults();
+        if (perSec == 0) perSec = d.perSecond.load(std::memory_order_relaxed);
+        if (perSec == 0) return true;
+        std::uint32_t burst = d.burst.load(std::memory_order_relaxed);
+        if (burst == 0) burst = perSec;
+
+        const std::int64_t interval = 1000000000LL / perSec;
+        const std::int64_t tolerance = interval * static_cast<std::int64_t>(burst - 1);
+        const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch()).count();
+        std::int64_t tat = tat_.load(std::memory_order_relaxed);
+        for (;;) {
+            std::int64_t start = std::max(tat, now);
+            if (start - now > tolerance) return false;
+            if (tat_.compare_exchange_weak(tat, start + interval, std::memory_order_relaxed)) return true;
+        }
+    }
+
+    alignas(64) std::atomic<std::uint64_t> calls_{0};
+    std::atomic<std::int64_t>  tat_{0};
+    std::atomic<std::uint64_t> suppressed_{0};   // 누적 억제 수
+    std::atomic<std::uint64_t> reported_{0};     // 마지막 출력 줄에 반영한 누적 값
+    const char* file_;
+    int line_;
+    SiteLimiter* next_ = nullptr;                // 전역 목록(추가만, 해제 없음)
+};
+
+// 억제된 수를 메시지 뒤에 붙여 텍스트로 기록(바이너리 모드에서도 TEXT 레코드)
+template <typename... Args>
+void logSuppressed(spdlog::logger& logger, const spdlog::source_loc& loc, spdlog::level::level_enum lvl,
+                   std::uint64_t suppressed, spdlog::format_string_t<Args...> fmt, Args&&... args) {
+    spdlog::memory_buf_t buf;
+    fmt::format_to(fmt::appender(buf), fmt, std::forward<Args>(args)...);
+    fmt::format_to(fmt::appender(buf), " [{} similar suppressed]", suppressed);
+    logger.log(loc, lvl, spdlog::string_view_t(buf.data(), buf.size()));
+}
+
+} // namespace j2
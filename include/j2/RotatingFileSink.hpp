@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <spdlog/sinks/base_sink.h>
+#include "j2/FileWriter.hpp"
+#include "j2/FlushScheduler.hpp"
+#include "j2/HandoffSink.hpp"
+#include "j2/LogIndex.hpp"
+#include "j2/RotationWorker.hpp"
+#include "j2/SharedFormatSink.hpp"
+#include "j2/SinkStats.hpp"
+
+// rotating_file_sink_mt 대체: 회전 시 "닫고 넘기기"만 로깅 스레드에서 수행
+namespace j2 {
+namespace sinks {
+
+// 크기 초과 시 현재 파일을 임시 이름으로 한 번 rename 하고 즉시 새 파일을 연다.
+// 백업 번호 밀기(all.1.log … all.N.log), 압축, 보존 개수 정리는 RotationWorker가 처리.
+// RotateNaming::index 이면 rename 없이 다음 번호 파일을 열고 base 심볼릭 링크만 교체.
+// RotatePolicy::interval > 0 이면 크기와 별도로 간격 경계(UTC)를 넘은 첫 기록에서 회전(max_size 0: 시간만).
+// 파일 기록은 FileWriter(FILE_IO_BACKEND: stdio 또는 io_uring)가 담당, 회전 전 진행 중인 기록을 모두 끝냄.
+// index_block > 0 이면 텍스트 레코드마다 사이드카 색인(LogIndexWriter) 갱신, flush 때 기록, 회전 때 확정.
+// 같은 경로로 교체(hard-reload)할 때는 handOff()로 남은 버퍼를 기록하고 닫은 뒤 새 싱크가 파일을 엶.
+class RotatingFileSink : public spdlog::sinks::base_sink<std::mutex>,
+                         public SharedFormatSink,
+                         public SinkCounters,
+                         public DurableSink,
+                         public HandoffSink {
+public:
+    RotatingFileSink(std::string base_filename,
+                     std::size_t max_size,
+                     std::size_t max_files,
+                     std::shared_ptr<RotationWorker> worker,
+                     RotateCompress compress = RotateCompress::none,
+                     RotatePolicy policy = {},
+                     FileIoBackend io = FileIoBackend::stdio,
+                     std::size_t index_block = 0);
+    ~RotatingFileSink() override;
+
+    std::string filename();   // 현재 기록 중인 파일(index 규칙이면 번호 붙은 실제 파일)
+
+    void setSharedFormatter(std::unique_ptr<spdlog::formatter> f, std::size_t key) override;
+    void logRender(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override;
+    void logRendered(const spdlog::details::log_msg& msg, const spdlog::memory_buf_t& formatted) override;
+
+    std::uint64_t bytesWritten() const noexcept override { return bytes_.load(std::memory_order_relaxed); }
+    std::uint64_t rotationCount() const noexcept override { return rotations_.load(std::memory_order_relaxed); }
+
+    // DURABILITY=fdatasync: 버퍼를 넘기고 현재 파일을 fdatasync(디스크 대기 중에는 mutex_를 잡지 않음).
+    // syncOnClose()면 회전/handOff/소멸로 닫을 때도 닫기 전에 동기화
+    void sync() override;
+
+    const std::string& basePath() const override { return base_filename_; }
+    spdlog::sink_ptr handOff(const std::function<spdlog::sink_ptr()>& make) override;
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+    void set_formatter_(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+    // 아래는 mutex_ 보유 상태에서 호출(파생 싱크가 텍스트 대신 자체 레코드를 쓸 때 사용)
+    // incoming 바이트를 더하면 넘치거나 at(기본: 지금)이 회전 시각을 지났으면 회전
+    void rotateIfNeeded_(std::size_t incoming, spdlog::log_clock::time_point at = {});
+    void writeRaw_(const spdlog::memory_buf_t& buf);
+    virtual void onFileOpened_() {}               // 회전으로 새 파일을 연 직후(헤더 기록 등)
+
+private:
+    void writeRecord_(const spdlog::details::log_msg& msg, const spdlog::memory_buf_t& buf);
+    void openFile_(const std::string& name, bool truncate);
+    void closeFile_();
+    void followTruncate_();
+    void rotate_();
+    void openIndexed_();
+    void updateLink_();
+    void armInterval_(spdlog::log_clock::time_point now);
+
+    std::string base_filename_;
+    std::size_t max_size_;
+    std::size_t max_files_;
+    std::size_t current_size_ = 0;
+    std::uint64_t truncSeen_ = 0;              // 반영한 file_->truncations()
+    std::size_t stage_seq_ = 0;
+    RotateCompress compress_;
+    RotatePolicy policy_;
+    std::size_t index_ = 0;                    // index 규칙: 현재 파일 번호
+    std::int64_t nextRotateNs_ = 0;            // 시간 회전 시각(epoch ns, 0: 사용 안 함)
+    bool linkWarned_ = false;
+    std::shared_ptr<RotationWorker> worker_;
+    std::unique_ptr<FileWriter> file_;
+    std::unique_ptr<LogIndexWriter> sidecar_;  // FILE_INDEX(없으면 색인 안 함)
+    std::atomic<std::uint64_t> bytes_{0};      // mutex_ 안에서만 증가(조회는 락 없이)
+    std::atomic<std::uint64_t> rotations_{0};
+};
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 회전된 로그 파일의 이름 변경/압축/보존 정리를 백그라운드에서 처리
+namespace j2 {
+namespace sinks {
+
+enum class RotateCompress { none, gzip, zstd };
+
+// 회전 파일 이름 규칙(ROTATE_NAMING)
+// - shift: all.log 에 기록, 회전마다 all.1.log … all.N.log 를 한 칸씩 밀기(보존 개수에 비례)
+// - index: all.000001.log, all.000002.log … 에 차례로 기록, all.log 는 현재 파일을 가리키는 심볼릭 링크.
+//          회전 = 새 파일 열기 + 링크 교체, 작업자는 압축과 가장 오래된 파일 1개 삭제만(보존 개수와 무관)
+enum class RotateNaming { shift, index };
+
+struct RotatePolicy {
+    RotateNaming naming = RotateNaming::shift;
+    std::chrono::seconds interval{0};   // ROTATE_INTERVAL: 0이면 크기만, 아니면 UTC 기준 간격 경계마다 회전
+
+    bool operator==(const RotatePolicy& o) const { return naming == o.naming && interval == o.interval; }
+    bool operator!=(const RotatePolicy& o) const { return !(*this == o); }
+};
+
+class RotationWorker {
+public:
+    // staged: 로깅 스레드가 막 닫고 임시 이름으로 옮겨 둔 파일
+    struct Job {
+        std::string staged;
+        std::string base;
+        std::size_t maxFiles = 0;
+        RotateCompress compress = RotateCompress::none;
+        RotateNaming naming = RotateNaming::shift;
+        std::size_t index = 0;      // index: 방금 닫힌 파일 번호(sweep이면 현재 파일 번호)
+        bool sweep = false;         // index: 시작 시 보존 개수 초과 삭제 + 미압축 파일 압축
+    };
+
+    RotationWorker();
+    ~RotationWorker();  // 남은 작업을 모두 처리한 뒤 종료
+
+    RotationWorker(const RotationWorker&) = delete;
+    RotationWorker& operator=(const RotationWorker&) = delete;
+
+    void post(Job job);
+    void drain();  // 대기 중인 작업이 모두 끝날 때까지 대기
+
+    // 이전 실행에서 처리되지 못한 staged 파일(base.rotating.*)을 순서대로 다시 등록
+    void recoverStaged(const std::string& base, std::size_t maxFiles, RotateCompress compress);
+
+    // index 이름 규칙: logs/all.log, 12, gzip → logs/all.000012.log.gz
+    static std::string indexedName(const std::string& base, std::size_t index, RotateCompress c);
+
+    struct IndexedFile {
+        std::size_t index = 0;
+        RotateCompress compress = RotateCompress::none;
+        std::string path;
+    };
+    // base 디렉터리의 index 이름 파일(압축 포함), 번호 순. indexedName과 정확히 같은 이름(6자리 이상)만
+    static std::vector<IndexedFile> scanIndexed(const std::string& base);
+    // shift 규칙 백업(all.1.log …, backupName과 같은 이름), 번호 순(1 = 가장 최근)
+    static std::vector<IndexedFile> scanShifted(const std::string& base);
+
+    // 회전 직후 임시 이름: 정렬 순서 = 회전 순서(시각 + 일련번호)
+    static std::string stagedName(const std::string& base, std::size_t seq);
+
+    // logs/all.log, 2, gzip → logs/all.2.log.gz
+    static std::string backupName(const std::string& base, std::size_t index, RotateCompress c);
+    static bool compressFile(const std::string& src, const std::string& dst, RotateCompress c);
+    static bool compressionAvailable(RotateCompress c);
+
+private:
+    void run();
+    void process(const Job& job);
+    void processIndexed(const Job& job);
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::condition_variable idleCv_;
+    std::deque<Job> queue_;
+    bool busy_ = false;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+} // namespace sinks
+} // namespace j2
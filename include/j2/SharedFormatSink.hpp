@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/formatter.h>
+
+// 포맷 결과 공유: SnapshotDistSink가 같은 formatKey()를 가진 싱크끼리는 레코드를 한 번만 포맷하고
+// 만들어진 버퍼를 나머지 싱크에 그대로 넘긴다(all.log/alerts.log가 같은 PATTERN_FILE을 쓰는 경우 등)
+namespace j2 {
+namespace sinks {
+
+class SharedFormatSink {
+public:
+    virtual ~SharedFormatSink() = default;
+
+    // 같은 키 = 같은 출력(패턴/시간 기준/줄바꿈 동일). 0이면 공유하지 않음
+    std::size_t formatKey() const noexcept { return formatKey_.load(std::memory_order_relaxed); }
+
+    // formatter와 키를 함께 설정(set_formatter로 직접 바꾸면 키는 0으로 돌아감)
+    virtual void setSharedFormatter(std::unique_ptr<spdlog::formatter> f, std::size_t key) = 0;
+
+    // 자신의 formatter로 dest에 포맷하고 기록(dest는 같은 키의 다른 싱크가 재사용)
+    virtual void logRender(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) = 0;
+
+    // 이미 포맷된 버퍼 기록
+    virtual void logRendered(const spdlog::details::log_msg& msg, const spdlog::memory_buf_t& formatted) = 0;
+
+    // 패턴 문자열 + 시간 기준 + 시간대 표기 + 줄바꿈 → 키(0은 피함)
+    static std::size_t makeKey(const std::string& pattern, spdlog::pattern_time_type timeType,
+                               bool utc, const std::string& eol) {
+        std::size_t h = std::hash<std::string>{}(pattern + '\x1f' + eol);
+        h ^= (static_cast<std::size_t>(timeType) + 1) * 0x9e3779b97f4a7c15ull + (utc ? 0x51ull : 0x17ull);
+        return h == 0 ? 1 : h;
+    }
+
+protected:
+    std::atomic<std::size_t> formatKey_{0};
+};
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <spdlog/common.h>
+
+// SHM_NAME: 여러 생산자 프로세스 → 수집기 프로세스 1개로 레코드를 넘기는 POSIX 공유 메모리 링(MPSC)
+namespace j2 {
+
+// - 고정 크기 슬롯 배열 + 슬롯별 순번(seq): 생산자는 head를 CAS로 예약해 슬롯을 채우고 seq로 게시
+//   (락 없음, 가득 차면 버리고 dropped 증가)
+// - 레코드 = 시각/레벨/pid/tid/로거 이름 + 포맷된 본문(%v). 패턴 포맷과 파일 I/O는 수집기가 수행
+//   본문이 슬롯보다 길면 잘라서 보냄(truncated)
+// - 생산자가 슬롯을 예약한 뒤 게시 전에 멈추면 수집기가 슬롯을 포기(abandoned)하고 다음으로 진행
+//   · 예약 pid가 죽은 것이 확인되면 슬롯을 바로 재사용
+//   · 살아 있거나 확인할 수 없으면 stall 시간 뒤 슬롯을 poisoned로 표시만 함(아직 memcpy 중일 수 있음).
+//     늦게 게시하려는 생산자가 CAS 실패 후 슬롯을 풀어 줌. 그사이 죽으면 수집기가 확인 후 풀고,
+//     확인이 안 되면(pid 재사용) stall × kPoisonReleaseFactor 뒤에 풂
+// - 생존 확인은 kill(pid, 0): pid 네임스페이스가 다르면(컨테이너 간) pid가 무의미하므로 슬롯에 생산자의
+//   pid 네임스페이스 id를 함께 기록하고, 수집기와 같을 때만 사망 판정에 사용(다르면 stall 경로만)
+// - tail(소비 위치)도 세그먼트에 있어 수집기를 재시작하면 이어서 읽음. 소비자는 동시에 1개만
+class ShmRing {
+public:
+    struct Options {
+        std::string name;                    // "/j2log" (shm_open 이름)
+        std::size_t slots = 16384;           // 2의 거듭제곱으로 올림(새로 만들 때만 적용)
+        std::size_t slotBytes = 512;         // 헤더 포함 슬롯 크기(새로 만들 때만 적용)
+        std::chrono::milliseconds stall{1000};  // 예약 후 게시되지 않은 슬롯을 포기하기까지
+    };
+
+    struct Record {
+        std::int64_t ns = 0;
+        std::uint64_t tid = 0;
+        std::uint32_t pid = 0;
+        spdlog::level::level_enum level = spdlog::level::info;
+        bool truncated = false;
+        std::string_view logger;
+        std::string_view payload;
+    };
+
+    ShmRing() = default;
+    ~ShmRing();
+
+    ShmRing(const ShmRing&) = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+
+    static bool supported();
+
+    // 세그먼트 열기(없으면 만들어 초기화, 있으면 기존 크기 사용). 실패하면 false + error()
+    bool open(const Options& opt);
+    void close();
+    bool isOpen() const { return base_ != nullptr; }
+    const std::string& error() const { return error_; }
+
+    // 생산자(여러 프로세스/스레드): 실패(가득 참/포기된 슬롯) 시 false
+    bool push(spdlog::level::level_enum level, std::int64_t ns, std::uint64_t tid,
+              std::string_view logger, std::string_view payload);
+
+    // 소비자: 이 프로세스를 유일한 소비자로 등록(살아 있는 다른 소비자가 있으면 false)
+    bool attachConsumer();
+    // 게시된 레코드를 순서대로 fn에 전달(최대 max개), 처리한 수 반환
+    std::size_t poll(const std::function<void(const Record&)>& fn, std::size_t max);
+
+    std::uint64_t dropped() const;      // 가득 차서 생산자가 버린 수(전체 프로세스 누적)
+    std::uint64_t abandoned() const;    // 생산자 중단으로 포기한 슬롯 수
+    std::size_t slots() const { return slots_; }
+    std::size_t slotBytes() const { return slotBytes_; }
+
+    static bool unlink(const std::string& name);
+
+private:
+    struct SegHeader;
+    struct SlotHeader;
+
+    SegHeader* header() const;
+    SlotHeader* slotAt(std::uint64_t pos) const;
+    bool ownerDead(const SlotHeader* s) const;
+
+    void* base_ = nullptr;
+    std::size_t mapped_ = 0;
+    std::size_t slots_ = 0;
+    std::size_t slotBytes_ = 0;
+    std::chrono::milliseconds stall_{1000};
+    std::uint32_t pid_ = 0;
+    std::uint32_t pidNs_ = 0;   // /proc/self/ns/pid inode 하위 32비트(알 수 없으면 0)
+    std::string error_;
+
+    // 소비자 상태(수집기 프로세스 안에서만 사용)
+    std::uint64_t stallPos_ = ~0ull;
+    std::chrono::steady_clock::time_point stallSince_{};
+};
+
+} // namespace j2
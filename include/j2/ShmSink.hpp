@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <spdlog/sinks/sink.h>
+#include "j2/ShmRing.hpp"
+#include "j2/SinkStats.hpp"
+
+// SHM_ROLE=producer: 레코드를 포맷하지 않고 공유 메모리 링으로 넘김(파일 기록은 수집기 프로세스)
+namespace j2 {
+namespace sinks {
+
+// - 본문(%v)과 시각/레벨/tid/로거 이름만 보냄. 패턴은 수집기의 싱크 설정을 따름
+// - 락 없음(ShmRing::push), 링이 가득 차면 버리고 droppedCount() 증가
+class ShmSink final : public spdlog::sinks::sink, public SinkCounters {
+public:
+    explicit ShmSink(std::shared_ptr<ShmRing> ring);
+
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override {}
+    void set_pattern(const std::string&) override {}
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+
+    const std::shared_ptr<ShmRing>& ring() const { return ring_; }
+
+    std::uint64_t bytesWritten() const noexcept override { return bytes_.load(std::memory_order_relaxed); }
+    std::uint64_t droppedCount() const noexcept override { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<ShmRing> ring_;
+    std::atomic<std::uint64_t> bytes_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+} // namespace sinks
+} // namespace j2
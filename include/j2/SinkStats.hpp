@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 싱크별 자체 계측(메시지/바이트/레벨로 걸러진 수/회전 수, 기록·flush 지연 분포)
+namespace j2 {
+
+// 지연 시간 분포: 버킷 i = [2^i, 2^(i+1)) ns
+struct LatencyHistogram {
+    static constexpr std::size_t kBuckets = 40;
+    std::array<std::uint64_t, kBuckets> buckets{};
+    std::uint64_t count = 0;
+    std::uint64_t sumNs = 0;
+    std::uint64_t maxNs = 0;
+    std::uint64_t intervalMaxNs = 0;  // 직전 구간 마감(SinkStats::snapshot(..., true)) 이후 최대
+
+    double meanNs() const { return count ? static_cast<double>(sumNs) / static_cast<double>(count) : 0.0; }
+    std::uint64_t percentileNs(double q) const;  // 해당 버킷의 상한(근사)
+    // 구간 차이: earlier가 직전 구간 마감 스냅샷이면 maxNs = 그 뒤 구간 최대(intervalMaxNs)
+    LatencyHistogram since(const LatencyHistogram& earlier) const;
+};
+
+struct SinkStatsSnapshot {
+    std::string name;
+    bool attached = false;          // 현재 분배 목록에 있는지(디스크 감시로 분리되면 false)
+    std::uint64_t messages = 0;     // 기록한 메시지
+    std::uint64_t filtered = 0;     // 싱크 레벨로 걸러진 메시지
+    std::uint64_t bytes = 0;        // 기록 바이트(파일/UDP/일괄 콘솔 싱크만, 동기 콘솔은 0)
+    std::uint64_t rotations = 0;
+    std::uint64_t dropped = 0;      // 싱크 내부에서 버린 수(UDP 큐 초과, 콘솔 대기 버퍼 초과 등)
+    std::uint64_t truncated = 0;    // 잘라서 기록한 레코드 수(mmap 세그먼트보다 긴 레코드)
+    LatencyHistogram write;
+    LatencyHistogram flush;
+};
+
+// 싱크가 직접 세는 누적값(stats() 시점에 읽음)
+class SinkCounters {
+public:
+    virtual ~SinkCounters() = default;
+    virtual std::uint64_t bytesWritten() const noexcept = 0;
+    virtual std::uint64_t rotationCount() const noexcept { return 0; }
+    virtual std::uint64_t droppedCount() const noexcept { return 0; }
+    virtual std::uint64_t truncatedCount() const noexcept { return 0; }
+    // 분배 싱크를 거치지 않고 기록한 메시지 수(바이너리 매크로 경로)
+    virtual std::uint64_t directMessages() const noexcept { return 0; }
+};
+
+// 싱크 1개의 계측값: SnapshotDistSink가 기록, 스레드별 샤드 카운터로 락/경합 없음.
+// 같은 역할(all/alerts/...)의 싱크가 hard-reload로 교체돼도 누적이 이어지도록 LoggerManager가 보관
+class SinkStats {
+public:
+    explicit SinkStats(std::string name) : name_(std::move(name)) {}
+
+    SinkStats(const SinkStats&) = delete;
+    SinkStats& operator=(const SinkStats&) = delete;
+
+    void onFiltered() noexcept;
+    void onWrite(std::uint64_t ns) noexcept;
+    void onFlush(std::uint64_t ns) noexcept;
+
+    // 교체되어 빠지는 싱크의 누적값을 이월
+    void absorb(const SinkCounters* retired) noexcept;
+
+    // current: 현재 싱크(없거나 SinkCounters가 아니면 nullptr)
+    // endInterval: 구간 최대(intervalMaxNs)를 읽고 0으로 되돌림(주기 요약 전용, 다른 조회는 false)
+    SinkStatsSnapshot snapshot(const SinkCounters* current, bool endInterval = false) const;
+
+    const std::string& name() const { return name_; }
+
+private:
+    static constexpr unsigned kShards = 8;
+
+    // 샤드 1개는 여러 캐시 라인(히스토그램 포함 약 700바이트): alignas(64)는 샤드 시작을 라인 경계에 맞춰
+    // 이웃 샤드와 라인을 나눠 쓰지 않게 할 뿐. 기록마다 건드리는 스칼라 카운터는 앞쪽 한 라인에 모음
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> messages{0};
+        std::atomic<std::uint64_t> filtered{0};
+        std::atomic<std::uint64_t> writeSum{0};
+        std::atomic<std::uint64_t> writeMax{0};
+        std::atomic<std::uint64_t> writeIntervalMax{0};
+        std::atomic<std::uint64_t> flushCount{0};
+        std::atomic<std::uint64_t> flushSum{0};
+        std::atomic<std::uint64_t> flushMax{0};
+        std::atomic<std::uint64_t> flushIntervalMax{0};
+        std::atomic<std::uint64_t> writeHist[LatencyHistogram::kBuckets]{};
+        std::atomic<std::uint64_t> flushHist[LatencyHistogram::kBuckets]{};
+    };
+
+    static unsigned shardIndex() noexcept;
+
+    std::string name_;
+    mutable Shard shards_[kShards];   // snapshot(endInterval)이 구간 최대를 되돌림
+    std::atomic<std::uint64_t> carriedBytes_{0};
+    std::atomic<std::uint64_t> carriedRotations_{0};
+    std::atomic<std::uint64_t> carriedDropped_{0};
+    std::atomic<std::uint64_t> carriedTruncated_{0};
+    std::atomic<std::uint64_t> carriedDirect_{0};
+};
+
+} // namespace j2
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <spdlog/sinks/sink.h>
+#include "j2/FlushScheduler.hpp"
+#include "j2/SharedFormatSink.hpp"
+#include "j2/SinkStats.hpp"
+
+// dist_sink_mt 대체: 불변 싱크 목록 스냅샷을 원자적으로 교체(RCU 방식)
+namespace j2 {
+namespace sinks {
+
+// - 로깅 스레드: 락 없이 현재 스냅샷을 읽어 각 싱크로 전달
+// - 구성 변경(add/remove/set_sinks): 새 스냅샷을 만들어 교체하고,
+//   이전 스냅샷을 읽던 스레드가 모두 빠져나간 뒤(grace period) 해제
+// - SharedFormatSink 자식은 formatKey()가 같으면 레코드당 한 번만 포맷하고 버퍼를 공유
+// - 자식별 SinkStats가 주어지면 기록/레벨 제외/flush 지연을 계측
+// - FlushScheduler가 연결되면 기록 바이트를 알리고, commitOn 이상 레코드는 읽기 구간을 벗어난 뒤 다음 그룹 커밋을 기다림
+//   (비동기 워커에서는 커밋 요청만). DURABILITY=none이면 파일이 아닌 자식(콘솔/UDP 등)만 바로 flush.
+//   같은 FlushScheduler에 연결된 하위 분배 싱크는 바이트 누적/대기를 상위에 맡김(레코드당 1회)
+class SnapshotDistSink : public spdlog::sinks::sink {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SnapshotDistSink();
+    explicit SnapshotDistSink(std::vector<spdlog::sink_ptr> sinks);
+    // childLevels=false: 자식 싱크 레벨을 무시하고 모두 전달(BACKTRACE 덤프)
+    explicit SnapshotDistSink(bool childLevels);
+    ~SnapshotDistSink() override;
+
+    SnapshotDistSink(const SnapshotDistSink&) = delete;
+    SnapshotDistSink& operator=(const SnapshotDistSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+    void add_sink(std::shared_ptr<spdlog::sinks::sink> sub_sink);
+    void remove_sink(std::shared_ptr<spdlog::sinks::sink> sub_sink);
+    // stats: sinks와 같은 순서(짧거나 nullptr면 해당 싱크는 계측 안 함)
+    void set_sinks(std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks,
+                   std::vector<std::shared_ptr<SinkStats>> stats = {});
+
+    // 그룹 커밋 연결(nullptr: 해제). 싱크 목록이 바뀌어도 유지
+    void set_commit(std::shared_ptr<FlushScheduler> scheduler, spdlog::level::level_enum commitOn);
+
+    // 현재 스냅샷 복사본
+    std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks() const;
+
+private:
+    // 스냅샷: 싱크 목록 + 포맷 공유 가능 여부(게시 시점에 한 번만 판별)
+    struct SinkSet {
+        std::vector<spdlog::sink_ptr> sinks;
+        std::vector<SharedFormatSink*> shared;  // sinks와 같은 순서, 공유 불가면 nullptr
+        std::vector<std::shared_ptr<SinkStats>> stats;  // sinks와 같은 크기, 계측 안 하면 nullptr
+        std::vector<bool> levelFlush;           // sinks와 같은 순서, DURABILITY=none에서도 레벨 flush 할 싱크
+        bool grouped = false;                   // 공유 가능 싱크가 2개 이상
+        bool nested = false;                    // 하위 SnapshotDistSink가 있음
+        std::shared_ptr<FlushScheduler> commit; // 그룹 커밋(없으면 nullptr)
+        spdlog::level::level_enum commitOn = spdlog::level::off;
+
+        SinkSet() = default;
+        SinkSet(std::vector<spdlog::sink_ptr> s, std::vector<std::shared_ptr<SinkStats>> st);
+    };
+
+    static constexpr std::size_t kMaxFormats = 4;  // 레코드당 공유 버퍼 수(넘으면 개별 포맷)
+    struct Rendered {
+        std::size_t key = 0;
+        spdlog::memory_buf_t buf;
+    };
+    void logTo(const SinkSet& set, const spdlog::details::log_msg& msg);
+    static void logShared(const spdlog::details::log_msg& msg, spdlog::sinks::sink& s,
+                          SharedFormatSink& sh, std::size_t key,
+                          Rendered* rendered, std::size_t& nRendered);
+
+    // 읽기 구간 보호(현재 epoch 슬롯의 샤드 카운터 증감)
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const SnapshotDistSink& owner);
+        ~ReadGuard();
+        const SinkSet& set() const { return *set_; }
+    private:
+        std::atomic<long>& counter_;
+        const SinkSet* set_;
+    };
+
+    // writeMu_ 보유 상태에서 호출(keepCommit: 그룹 커밋 연결을 현재 스냅샷에서 이어받음)
+    void publish(SinkSet* next, bool keepCommit = true);
+    void waitForReaders(unsigned slot) const;
+    static unsigned shardIndex();
+
+    const bool childLevels_ = true;
+
+    static constexpr unsigned kShards = 16;
+    struct alignas(64) Counter { std::atomic<long> n{0}; };
+
+    std::atomic<const SinkSet*> current_;
+    std::atomic<unsigned> epoch_{0};
+    mutable Counter readers_[2][kShards];
+    mutable std::mutex writeMu_;
+};
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <spdlog/formatter.h>
+#include <spdlog/logger.h>
+#include <spdlog/details/os.h>
+
+// FILE_FORMAT=json|logfmt: 파일 싱크용 한 줄 한 레코드 구조화 출력 + 키/값 필드 매크로(hX_kv)
+namespace j2 {
+
+// 필드 하나(키/문자열은 로그 호출이 끝날 때까지만 유효한 view)
+struct Field {
+    enum class Kind : std::uint8_t { i64, u64, f64, boolean, str };
+
+    std::string_view key;
+    Kind kind = Kind::str;
+    union {
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+        bool b;
+    };
+    std::string_view s;
+
+    Field() : i(0) {}
+};
+
+template <std::size_t N>
+struct Fields {
+    std::array<Field, N> items;
+};
+
+namespace detail {
+template <typename V>
+void setField(Field& f, const V& v) {
+    using T = std::decay_t<V>;
+    if constexpr (std::is_same_v<T, bool>) {
+        f.kind = Field::Kind::boolean;
+        f.b = v;
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        f.kind = Field::Kind::i64;
+        f.i = static_cast<std::int64_t>(v);
+    } else if constexpr (std::is_integral_v<T>) {
+        f.kind = Field::Kind::u64;
+        f.u = static_cast<std::uint64_t>(v);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        f.kind = Field::Kind::f64;
+        f.d = static_cast<double>(v);
+    } else {
+        static_assert(std::is_convertible_v<const V&, std::string_view>,
+                      "field values must be integers, floating point, bool or strings");
+        f.kind = Field::Kind::str;
+        f.s = std::string_view(v);
+    }
+}
+
+inline void fillFields(Field*) {}
+
+template <typename K, typename V, typename... Rest>
+void fillFields(Field* out, const K& key, const V& value, const Rest&... rest) {
+    out->key = std::string_view(key);
+    setField(*out, value);
+    fillFields(out + 1, rest...);
+}
+} // namespace detail
+
+// j2::fields("user", id, "ms", elapsed) → 키/값 쌍 목록
+template <typename... KV>
+Fields<sizeof...(KV) / 2> fields(const KV&... kv) {
+    static_assert(sizeof...(KV) % 2 == 0, "j2::fields takes key, value pairs");
+    Fields<sizeof...(KV) / 2> out;
+    detail::fillFields(out.items.data(), kv...);
+    return out;
+}
+
+// 이스케이프(8바이트 단위로 이스케이프할 문자가 없는 구간을 통째로 복사, 임시 문자열 없음)
+void appendJsonEscaped(spdlog::memory_buf_t& dest, std::string_view s);
+void appendLogfmtValue(spdlog::memory_buf_t& dest, std::string_view s);   // 필요할 때만 따옴표
+void appendFieldValue(spdlog::memory_buf_t& dest, const Field& f, bool json);
+
+// hX_kv가 기록 중인 레코드의 필드(같은 스레드의 동기 싱크만 보임).
+// ASYNC_MODE=true면 워커 스레드에서 포맷하므로 필드는 msg 뒤의 " key=value" 텍스트로만 남음
+// (LoggerManager가 설정을 읽을 때 한 번 경고)
+struct FieldContext {
+    const char* payload = nullptr;   // 이 payload를 가진 log_msg에만 적용
+    std::size_t msgLen = 0;          // payload 중 메시지 부분 길이(뒤는 " key=value" 텍스트)
+    const Field* fields = nullptr;
+    std::size_t count = 0;
+};
+FieldContext& fieldContext();
+
+// 메시지 뒤에 " key=value"를 붙여 기록(텍스트 싱크용). 구조화 formatter는 필드를 따로 출력
+template <std::size_t N, typename... Args>
+void logFields(spdlog::logger& logger, const spdlog::source_loc& loc, spdlog::level::level_enum lvl,
+               const Fields<N>& f, spdlog::format_string_t<Args...> fmt, Args&&... args) {
+    spdlog::memory_buf_t buf;
+    fmt::format_to(fmt::appender(buf), fmt, std::forward<Args>(args)...);
+    const std::size_t msgLen = buf.size();
+    for (const auto& x : f.items) {
+        buf.push_back(' ');
+        buf.append(x.key.data(), x.key.data() + x.key.size());
+        buf.push_back('=');
+        appendFieldValue(buf, x, false);
+    }
+    auto& ctx = fieldContext();
+    const FieldContext saved = ctx;
+    ctx = FieldContext{buf.data(), msgLen, f.items.data(), N};
+    logger.log(loc, lvl, spdlog::string_view_t(buf.data(), buf.size()));
+    ctx = saved;
+}
+
+// 레코드 = ts(RFC 3339, 밀리초, TIME_MODE 오프셋) + level + thread + logger + msg + 필드
+//   json  : {"ts":"2025-01-31T12:00:00.123+09:00","level":"info","thread":1234,"logger":"app","msg":"...","user":42}
+//   logfmt: ts=2025-01-31T12:00:00.123+09:00 level=info thread=1234 logger=app msg="..." user=42
+class StructuredFormatter final : public spdlog::formatter {
+public:
+    enum class Style { json, logfmt };
+
+    StructuredFormatter(Style style, spdlog::pattern_time_type timeType,
+                        std::string eol = spdlog::details::os::default_eol);
+
+    void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override;
+    std::unique_ptr<spdlog::formatter> clone() const override;
+
+private:
+    void renderSeconds_(std::time_t secs);
+
+    Style style_;
+    spdlog::pattern_time_type timeType_;
+    std::string eol_;
+    std::time_t cachedSec_ = -1;
+    std::string cachedDate_;     // "2025-01-31T12:00:00"
+    std::string cachedZone_;     // "Z" / "+09:00"
+};
+
+} // namespace j2
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/fmt/fmt.h>
+
+namespace j2 {
+
+// %Z 플래그: TIME_MODE에 따라 "utc" 또는 "local"을 고정폭(기본 5)으로 출력
+class TzFlag : public spdlog::custom_flag_formatter {
+public:
+    explicit TzFlag(bool utc, std::size_t width = 5) : utc_(utc), width_(width) {}
+
+    void format(const spdlog::details::log_msg&,
+                const std::tm&,
+                spdlog::memory_buf_t& dest) override
+    {
+        const char* s = utc_ ? "utc" : "local";
+        fmt::format_to(fmt::appender(dest), "{:<{}}", s, width_);
+    }
+
+    std::unique_ptr<spdlog::custom_flag_formatter> clone() const override {
+        return spdlog::details::make_unique<TzFlag>(utc_, width_);
+    }
+
+private:
+    bool utc_{false};
+    std::size_t width_{5};
+};
+
+} // namespace j2
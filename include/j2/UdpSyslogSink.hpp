@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <boost/asio/steady_timer.hpp>
+#include <spdlog/sinks/base_sink.h>
+#include "j2/SinkStats.hpp"
+#include "j2/UdpTransport.hpp"
+
+// UDP_SINK: 로그 레코드를 RFC 5424 syslog 형식으로 UDP 전송(디스크를 거치지 않음)
+namespace j2 {
+namespace sinks {
+
+// - 헤더: <PRI>1 TIMESTAMP(UTC, 마이크로초) HOSTNAME APP-NAME PROCID - - MSG
+// - MSG 부분만 싱크 formatter(UDP_SINK_PATTERN)로 포맷
+// - 여러 레코드를 '\n'으로 이어 MTU 이하의 데이터그램 하나로 묶어 전송
+//   (가득 차거나 flush_interval 경과/flush 시 전송)
+// - 전송은 UdpTransport의 제한 큐를 거쳐 백그라운드 스레드에서 수행(가득 차면 버림)
+class UdpSyslogSink final : public spdlog::sinks::base_sink<std::mutex>, public SinkCounters {
+public:
+    struct Options {
+        std::string host;
+        unsigned short port = 514;
+        int facility = 16;                 // local0
+        std::string appName;               // 비어 있으면 "-"
+        std::size_t mtu = 1400;            // 데이터그램 최대 바이트
+        std::size_t maxQueued = 1024;      // 전송 대기 데이터그램 수 상한
+        std::chrono::milliseconds flushInterval{200};
+
+        bool operator==(const Options& o) const {
+            return host == o.host && port == o.port && facility == o.facility && appName == o.appName &&
+                   mtu == o.mtu && maxQueued == o.maxQueued && flushInterval == o.flushInterval;
+        }
+        bool operator!=(const Options& o) const { return !(*this == o); }
+    };
+
+    explicit UdpSyslogSink(Options opt);
+    ~UdpSyslogSink() override;
+
+    std::size_t dropped() const { return transport_.dropped(); }
+
+    std::uint64_t bytesWritten() const noexcept override { return bytes_.load(std::memory_order_relaxed); }
+    std::uint64_t droppedCount() const noexcept override { return transport_.dropped(); }
+
+    // "local0" / "user" / "16" → 시설 번호(알 수 없으면 def)
+    static int parseFacility(const std::string& s, int def);
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+
+private:
+    void sendBatch_();
+    void armTimer();
+    void appendTimestamp_(spdlog::memory_buf_t& dest, spdlog::log_clock::time_point tp);
+
+    Options opt_;
+    std::string hostname_;
+    std::string procId_;
+    spdlog::memory_buf_t batch_;     // mutex_ 보호
+    spdlog::memory_buf_t record_;    // mutex_ 보호
+    std::time_t cachedSec_ = -1;     // 초 단위 타임스탬프 캐시
+    char cachedTs_[32] = {0};
+    std::atomic<std::uint64_t> bytes_{0};  // 전송 큐에 넣은 데이터그램 바이트
+
+    UdpTransport transport_;
+    boost::asio::steady_timer timer_;
+};
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <thread>
+#include <boost/asio.hpp>
+
+// 백그라운드 io_context 스레드 1개 + 영구 UDP 소켓(Boost.Asio)
+// send()는 큐에 넣기만 하고 바로 반환: 이름 해석/전송 지연이 로깅 스레드나 mu_를 막지 않음
+namespace j2 {
+
+class UdpTransport {
+public:
+    explicit UdpTransport(std::size_t maxQueued = 1024);
+    ~UdpTransport();  // 대기 중인 데이터그램을 잠시(최대 200ms) 기다린 뒤 종료
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    // 대상 변경(이름 해석은 io 스레드에서 수행, 실패 시 다음 설정까지 전송분은 버림)
+    void setTarget(const std::string& host, unsigned short port);
+
+    // 큐가 가득 차 있으면 false(버린 수 누적)
+    bool send(std::string datagram);
+
+    std::size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    std::size_t sent() const { return sent_.load(std::memory_order_relaxed); }
+
+    // 같은 스레드에서 돌릴 타이머 등록용
+    boost::asio::io_context& context() { return io_; }
+
+    void shutdown();  // 소멸자 이전에 명시적으로 종료할 때(중복 호출 가능)
+
+private:
+    void startSend();  // io 스레드 전용
+
+    boost::asio::io_context io_;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_;
+    boost::asio::ip::udp::socket socket_;
+    boost::asio::ip::udp::endpoint endpoint_;
+    bool haveEndpoint_ = false;   // io 스레드 전용
+    bool sending_ = false;        // io 스레드 전용
+    std::deque<std::string> queue_;  // io 스레드 전용
+
+    const std::size_t maxQueued_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<std::size_t> dropped_{0};
+    std::atomic<std::size_t> sent_{0};
+    std::atomic<bool> stopped_{false};
+    std::thread thread_;
+};
+
+} // namespace j2
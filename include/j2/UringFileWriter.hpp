@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "j2/FileWriter.hpp"
+
+struct io_uring_sqe;
+
+// FILE_IO_BACKEND=io_uring(Linux): 포맷된 줄을 등록 버퍼 풀에 모아 WRITE_FIXED로 제출하는 파일 기록기
+namespace j2 {
+namespace sinks {
+
+// - 버퍼(기본 64 KiB x 8)가 차거나 flush 될 때만 제출(io_uring_enter 1회, 완료를 기다리지 않음).
+//   오프셋을 직접 지정하므로 완료 순서와 무관하게 파일 내용은 기록 순서 그대로
+// - 완료는 전용 스레드가 수거해 버퍼를 풀에 반납. 짧은 기록/오류는 그 스레드가 pwrite로 마저 기록
+// - 빈 버퍼가 없으면 로깅 스레드가 반납을 기다림(디스크보다 빠르게 쓰는 동안만)
+// - beginSync: 마지막 기록에 링크한 FSYNC(DATASYNC, DRAIN) 제출, endSync가 완료 대기(실패하면 spdlog_ex)
+// - close/reopen(회전, hard-reload, 소멸): 진행 중인 기록과 fsync가 모두 끝난 뒤 fd를 닫음.
+//   fdatasync 내구성이면 싱크가 닫기 전에 beginSync/endSync로 마지막 FSYNC를 링크해 완료를 기다림
+// - io_uring_enter가 끝내 실패하면 제출 못 한 요청을 거둬 동기 pwrite/fdatasync로 처리.
+//   완료 대기는 모두 상한이 있고 넘으면 spdlog_ex
+// - 파일이 밖에서 잘리면(copytruncate) 수거 스레드가 1초 주기 fstat으로 감지, 그다음 기록부터 현재 끝에 이어 씀
+//   (truncations() 증가: 싱크가 회전 크기와 색인을 새 끝 기준으로 다시 잡음)
+// liburing 없이 커널 uapi 헤더와 시스템 콜만 사용(헤더가 없으면 supported()가 false)
+class UringFileWriter final : public FileWriter {
+public:
+    static constexpr std::size_t kBufferBytes = 64 * 1024;
+    static constexpr std::size_t kBuffers = 8;
+
+    static bool supported();
+
+    UringFileWriter();
+    ~UringFileWriter() override;
+
+    UringFileWriter(const UringFileWriter&) = delete;
+    UringFileWriter& operator=(const UringFileWriter&) = delete;
+
+    void open(const std::string& fname, bool truncate) override;
+    void reopen(bool truncate) override;
+    void write(const spdlog::memory_buf_t& buf) override;
+    void flush() override;
+    void close() override;
+    std::size_t size() const override { return offset_ + curLen_; }
+    const std::string& filename() const override { return filename_; }
+    std::uint64_t truncations() const override { return truncations_; }
+
+    SyncTicket beginSync() override;
+    void endSync(const SyncTicket& t) override;
+
+private:
+    struct Ring;
+    struct Slot {
+        char* data = nullptr;
+        std::size_t len = 0;
+        std::uint64_t offset = 0;
+    };
+
+    void submitCurrent_(bool linkNext);
+    io_uring_sqe* nextSqe_();
+    void submit_();                 // enter, 실패하면 동기 처리로 대체
+    void followTruncate_();         // 외부 truncate 뒤 offset_을 파일 끝으로
+    void checkTruncate_();          // 수거 스레드의 주기 확인
+    void reportOnce_(const char* what, int err);
+    int acquire_();                 // 빈 버퍼 번호(없으면 반납 대기)
+    void drain_();                  // 진행 중인 요청이 0이 될 때까지 대기
+    void reap_();                   // 완료 수거 스레드
+    void complete_(std::uint64_t tag, int res);
+
+    std::unique_ptr<Ring> ring_;
+    std::vector<char> pool_;        // kBuffers * kBufferBytes(등록 버퍼)
+    std::vector<Slot> slots_;
+    std::string filename_;
+    int fd_ = -1;
+    std::uint64_t offset_ = 0;      // 제출한 기록의 끝(다음 버퍼의 파일 오프셋)
+    int cur_ = -1;                  // 채우는 중인 버퍼(-1: 없음)
+    std::size_t curLen_ = 0;
+    std::uint64_t fsyncSeq_ = 0;    // 제출한 fsync 번호(싱크 mutex 보호)
+    std::uint64_t truncations_ = 0; // followTruncate_ 횟수(싱크 mutex 보호)
+
+    std::mutex mu_;                 // 아래 상태 + 반납/완료 알림
+    std::condition_variable cv_;
+    std::vector<int> free_;
+    std::size_t inflight_ = 0;      // 제출 후 완료 전(기록 + fsync)
+    std::uint64_t fsyncDone_ = 0;
+    std::uint64_t fsyncFailed_ = 0; // 실패한 fsync 중 가장 큰 번호
+    int fsyncErrno_ = 0;
+    std::uint64_t writtenEnd_ = 0;  // 완료된 기록의 끝(외부 truncate 감지용)
+    int watchFd_ = -1;              // 수거 스레드가 확인할 fd(열린 동안만)
+    std::atomic<bool> truncated_{false};
+    bool errorReported_ = false;
+    std::atomic<bool> stop_{false};
+    std::thread reaper_;
+};
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,119 @@
+#include "j2/Backtrace.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <fmt/args.h>
+
+namespace j2 {
+namespace backtrace {
+
+namespace {
+struct TargetRegistry {
+    std::mutex mu;
+    std::unordered_map<std::string, std::shared_ptr<Target>> targets;
+};
+
+TargetRegistry& targetRegistry() {
+    static TargetRegistry r;
+    return r;
+}
+
+template <typename T>
+bool take(const char*& p, const char* end, T& v) {
+    if (static_cast<std::size_t>(end - p) < sizeof(T)) return false;
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+// capture()가 만든 [u32 포맷 길이][포맷][인자...]를 텍스트로(인자 형식은 binlog EVENT와 같음)
+void render(const Ring::Entry& e, spdlog::memory_buf_t& out) {
+    const char* p = e.data.data();
+    const char* end = p + e.data.size();
+    std::uint32_t fmtLen = 0;
+    if (!take(p, end, fmtLen) || static_cast<std::size_t>(end - p) < fmtLen) return;
+    fmt::string_view f(p, fmtLen);
+    p += fmtLen;
+
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    for (unsigned i = 0; i < e.argc; ++i) {
+        std::uint8_t tag = 0;
+        if (!take(p, end, tag)) return;
+        switch (tag) {
+        case binlog::kI64:  { std::int64_t v;  if (!take(p, end, v)) return; store.push_back(v); break; }
+        case binlog::kU64:  { std::uint64_t v; if (!take(p, end, v)) return; store.push_back(v); break; }
+        case binlog::kF64:  { double v;        if (!take(p, end, v)) return; store.push_back(v); break; }
+        case binlog::kBool: { std::uint8_t v;  if (!take(p, end, v)) return; store.push_back(v != 0); break; }
+        case binlog::kChar: { char v;          if (!take(p, end, v)) return; store.push_back(v); break; }
+        case binlog::kPtr:  { std::uint64_t v; if (!take(p, end, v)) return;
+                              store.push_back(reinterpret_cast<const void*>(static_cast<std::uintptr_t>(v))); break; }
+        case binlog::kStr:  { std::uint32_t n; if (!take(p, end, n) || static_cast<std::size_t>(end - p) < n) return;
+                              store.push_back(fmt::string_view(p, n)); p += n; break; }
+        default: return;
+        }
+    }
+    try {
+        fmt::vformat_to(fmt::appender(out), f, store);
+    } catch (const std::exception&) {
+        out.clear();
+        out.append(f.data(), f.data() + f.size());
+    }
+}
+} // anonymous namespace
+
+void registerTarget(const std::string& logger, std::shared_ptr<Target> t) {
+    auto& r = targetRegistry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    r.targets[logger] = std::move(t);
+}
+
+void unregisterTarget(const std::string& logger) {
+    auto& r = targetRegistry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    r.targets.erase(logger);
+}
+
+std::shared_ptr<Target> findTarget(const std::string& logger) {
+    auto& r = targetRegistry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    auto it = r.targets.find(logger);
+    return it != r.targets.end() ? it->second : nullptr;
+}
+
+std::uint64_t nextTargetId() {
+    static std::atomic<std::uint64_t> id{0};
+    return id.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+std::size_t Ring::dump(const Target& target, spdlog::level::level_enum lvl) {
+    const std::size_t depth = entries_.size();
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < size_; ++i) {
+        if (entries_[(head_ + depth - size_ + i) % depth].target == target.id) ++count;
+    }
+    if (count == 0) return 0;
+
+    auto mark = [&](const char* what) {
+        text_.clear();
+        fmt::format_to(fmt::appender(text_), "---- backtrace {} ({} records) ----", what, count);
+        target.logger->log(lvl, spdlog::string_view_t(text_.data(), text_.size()));
+    };
+
+    mark("begin");
+    for (std::size_t i = 0; i < size_; ++i) {
+        Entry& e = entries_[(head_ + depth - size_ + i) % depth];
+        if (e.target != target.id) continue;
+        text_.clear();
+        render(e, text_);
+        auto tp = spdlog::log_clock::time_point(
+            std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(e.ns)));
+        target.logger->log(tp, e.loc, e.level, spdlog::string_view_t(text_.data(), text_.size()));
+        e.target = 0;   // 다른 로거의 항목은 그대로 둠
+    }
+    mark("end");
+    return count;
+}
+
+} // namespace backtrace
+} // namespace j2
@@ -0,0 +1,159 @@
+#include "j2/BinaryLog.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace j2 {
+namespace binlog {
+
+namespace {
+struct SiteRegistry {
+    std::mutex mu;
+    std::unordered_map<std::string, std::uint32_t> ids;  // file:line + 포맷 문자열 → id
+    std::vector<SiteInfo> sites;
+};
+
+SiteRegistry& siteRegistry() {
+    static SiteRegistry r;
+    return r;
+}
+
+struct ChannelRegistry {
+    std::mutex mu;
+    std::unordered_map<std::string, std::shared_ptr<Channel>> channels;
+};
+
+ChannelRegistry& channelRegistry() {
+    static ChannelRegistry r;
+    return r;
+}
+
+void putLenStr16(spdlog::memory_buf_t& b, const std::string& s) {
+    std::size_t n = s.size() > 0xFFFF ? 0xFFFF : s.size();
+    detail::put<std::uint16_t>(b, static_cast<std::uint16_t>(n));
+    b.append(s.data(), s.data() + n);
+}
+} // anonymous namespace
+
+std::uint32_t siteId(fmt::string_view fmt, const spdlog::source_loc& loc) {
+    const char* file = loc.filename ? loc.filename : "";
+    std::string key = fmt::format("{}:{}", file, loc.line);
+    key.push_back('\0');
+    key.append(fmt.data(), fmt.size());
+
+    auto& r = siteRegistry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    auto it = r.ids.find(key);
+    if (it != r.ids.end()) return it->second;
+
+    auto id = static_cast<std::uint32_t>(r.sites.size());
+    SiteInfo info;
+    info.fmt.assign(fmt.data(), fmt.size());
+    info.file = file;
+    info.func = loc.funcname ? loc.funcname : "";
+    info.line = static_cast<std::uint32_t>(loc.line);
+    r.sites.push_back(std::move(info));
+    r.ids.emplace(std::move(key), id);
+    return id;
+}
+
+SiteInfo siteInfo(std::uint32_t id) {
+    auto& r = siteRegistry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    return id < r.sites.size() ? r.sites[id] : SiteInfo{};
+}
+
+BinaryFileSink::BinaryFileSink(std::string base_filename,
+                               std::size_t max_size,
+                               std::size_t max_files,
+                               std::shared_ptr<j2::sinks::RotationWorker> worker,
+                               j2::sinks::RotateCompress compress,
+                               std::string loggerName,
+                               j2::sinks::RotatePolicy policy,
+                               j2::sinks::FileIoBackend io)
+    : RotatingFileSink(std::move(base_filename), max_size, max_files, std::move(worker), compress, policy, io)
+    , loggerName_(std::move(loggerName)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writeSession_();  // 기존 파일에 이어 쓰는 경우에도 새 세션(사전 재시작)으로 표시
+}
+
+void BinaryFileSink::sink_it_(const spdlog::details::log_msg& msg) {
+    if (handedOff()) {
+        forward(msg);
+        return;
+    }
+    scratch_.clear();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+    detail::put<std::uint8_t>(scratch_, kText);
+    detail::put<std::int64_t>(scratch_, static_cast<std::int64_t>(ns));
+    detail::put<std::uint8_t>(scratch_, static_cast<std::uint8_t>(msg.level));
+    detail::put<std::uint64_t>(scratch_, static_cast<std::uint64_t>(msg.thread_id));
+    detail::put<std::uint32_t>(scratch_, static_cast<std::uint32_t>(msg.payload.size()));
+    scratch_.append(msg.payload.data(), msg.payload.data() + msg.payload.size());
+    rotateIfNeeded_(scratch_.size(), msg.time);
+    writeRaw_(scratch_);
+}
+
+void BinaryFileSink::writeEvent(std::uint32_t id, const spdlog::memory_buf_t& rec) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (handedOff()) {
+        // 같은 경로로 교체된 뒤: 새 바이너리 싱크로(형식이 바뀌었으면 버림)
+        if (auto* next = dynamic_cast<BinaryFileSink*>(successor().get())) next->writeEvent(id, rec);
+        return;
+    }
+    rotateIfNeeded_(rec.size());
+
+    if (id >= emitted_.size() || !emitted_[id]) {
+        SiteInfo info = siteInfo(id);
+        scratch_.clear();
+        detail::put<std::uint8_t>(scratch_, kSite);
+        detail::put<std::uint32_t>(scratch_, id);
+        detail::put<std::uint32_t>(scratch_, info.line);
+        putLenStr16(scratch_, info.file);
+        putLenStr16(scratch_, info.func);
+        detail::put<std::uint32_t>(scratch_, static_cast<std::uint32_t>(info.fmt.size()));
+        scratch_.append(info.fmt.data(), info.fmt.data() + info.fmt.size());
+        writeRaw_(scratch_);
+
+        if (id >= emitted_.size()) emitted_.resize(id + 1, false);
+        emitted_[id] = true;
+    }
+    writeRaw_(rec);
+    events_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BinaryFileSink::onFileOpened_() {
+    writeSession_();
+}
+
+void BinaryFileSink::writeSession_() {
+    emitted_.assign(emitted_.size(), false);
+    scratch_.clear();
+    detail::put<std::uint8_t>(scratch_, kSession);
+    scratch_.append(kMagic, kMagic + sizeof(kMagic));
+    detail::put<std::uint16_t>(scratch_, kVersion);
+    putLenStr16(scratch_, loggerName_);
+    writeRaw_(scratch_);
+}
+
+void registerChannel(const std::string& logger, std::shared_ptr<Channel> ch) {
+    auto& r = channelRegistry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    r.channels[logger] = std::move(ch);
+}
+
+void unregisterChannel(const std::string& logger) {
+    auto& r = channelRegistry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    r.channels.erase(logger);
+}
+
+std::shared_ptr<Channel> findChannel(const std::string& logger) {
+    auto& r = channelRegistry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    auto it = r.channels.find(logger);
+    return it != r.channels.end() ? it->second : nullptr;
+}
+
+} // namespace binlog
+} // namespace j2
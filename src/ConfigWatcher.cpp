@@ -0,0 +1,157 @@
+#include "j2/ConfigWatcher.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace j2 {
+
+ConfigWatcher::~ConfigWatcher() { stop(); }
+
+bool ConfigWatcher::start(const std::string& path,
+                          std::chrono::milliseconds interval,
+                          std::chrono::milliseconds debounce,
+                          Backend backend,
+                          Callback cb) {
+    if (running_) return true;
+
+    std::filesystem::path p(path);
+    dir_  = p.has_parent_path() ? p.parent_path().string() : std::string(".");
+    file_ = p.filename().string();
+    intervalMs_ = interval.count();
+    debounce_   = debounce;
+    cb_         = std::move(cb);
+    running_    = true;
+
+#ifdef __linux__
+    if (backend == Backend::automatic && openInotify()) {
+        eventDriven_ = true;
+        thread_ = std::thread([this]() { runInotify(); });
+        return true;
+    }
+#else
+    (void)backend;
+#endif
+    eventDriven_ = false;
+    thread_ = std::thread([this]() { runPoll(); });
+    return true;
+}
+
+void ConfigWatcher::stop() {
+    if (!running_.exchange(false)) return;
+    {
+        std::lock_guard<std::mutex> lk(mu_);  // 대기 진입 직전의 스레드가 깨움을 놓치지 않도록
+    }
+    cv_.notify_all();
+#ifdef __linux__
+    if (wakeFd_ >= 0) {
+        std::uint64_t one = 1;
+        (void)::write(wakeFd_, &one, sizeof(one));
+    }
+#endif
+    if (thread_.joinable()) thread_.join();
+#ifdef __linux__
+    closeInotify();
+#endif
+}
+
+void ConfigWatcher::setInterval(std::chrono::milliseconds interval) {
+    intervalMs_ = interval.count();
+    cv_.notify_all();
+}
+
+// 폴링: tick마다 콜백(변경 여부는 콜백 쪽에서 mtime 비교), 대기는 condition_variable
+void ConfigWatcher::runPoll() {
+    std::unique_lock<std::mutex> lk(mu_);
+    while (running_) {
+        lk.unlock();
+        try { cb_(Event::tick); } catch (...) {}
+        lk.lock();
+        cv_.wait_for(lk, std::chrono::milliseconds(intervalMs_.load()),
+                     [this]() { return !running_; });
+    }
+}
+
+#ifdef __linux__
+// 파일이 아닌 디렉터리를 감시해야 rename-over 저장(vim, configmap ..data 교체)도 잡힘
+bool ConfigWatcher::openInotify() {
+    inotifyFd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ < 0) return false;
+    int wd = ::inotify_add_watch(inotifyFd_, dir_.c_str(),
+                                 IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_ATTRIB);
+    wakeFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wd < 0 || wakeFd_ < 0) {
+        closeInotify();
+        return false;
+    }
+    return true;
+}
+
+void ConfigWatcher::closeInotify() {
+    if (inotifyFd_ >= 0) { ::close(inotifyFd_); inotifyFd_ = -1; }
+    if (wakeFd_ >= 0)    { ::close(wakeFd_);    wakeFd_ = -1; }
+}
+
+void ConfigWatcher::runInotify() {
+    using clock = std::chrono::steady_clock;
+    alignas(struct inotify_event) char buf[4096];
+
+    auto nextTick = clock::now();
+    bool pending = false;
+    clock::time_point fireAt{};
+
+    while (running_) {
+        auto now = clock::now();
+        if (now >= nextTick) {
+            try { cb_(Event::tick); } catch (...) {}
+            nextTick = clock::now() + std::chrono::milliseconds(intervalMs_.load());
+        }
+        if (pending && now >= fireAt) {
+            pending = false;
+            try { cb_(Event::changed); } catch (...) {}
+        }
+
+        auto until = pending ? std::min(nextTick, fireAt) : nextTick;
+        auto waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(until - clock::now()).count();
+        if (waitMs < 0) waitMs = 0;
+
+        struct pollfd fds[2] = {{inotifyFd_, POLLIN, 0}, {wakeFd_, POLLIN, 0}};
+        int rc = ::poll(fds, 2, static_cast<int>(waitMs));
+        if (rc < 0 && errno != EINTR) break;
+        if (!running_) break;
+        if (rc <= 0) continue;
+
+        if (fds[0].revents & POLLIN) {
+            for (;;) {
+                ssize_t n = ::read(inotifyFd_, buf, sizeof(buf));
+                if (n <= 0) break;
+                for (char* ptr = buf; ptr < buf + n;) {
+                    auto* ev = reinterpret_cast<struct inotify_event*>(ptr);
+                    ptr += sizeof(struct inotify_event) + ev->len;
+                    if (ev->len == 0) continue;
+                    // 대상 파일 자체 또는 Kubernetes configmap의 ..data 심볼릭 링크 교체
+                    if (file_ == ev->name || std::strcmp(ev->name, "..data") == 0) {
+                        pending = true;
+                        fireAt = clock::now() + debounce_;  // 연속 이벤트는 마지막 기준으로 디바운스
+                    }
+                }
+            }
+        }
+        if (fds[1].revents & POLLIN) {
+            std::uint64_t v = 0;
+            (void)::read(wakeFd_, &v, sizeof(v));
+        }
+    }
+}
+#endif
+
+} // namespace j2
@@ -0,0 +1,175 @@
+#include "j2/ConsoleSink.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <spdlog/details/os.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/pattern_formatter.h>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h>
+#include <windows.h>
+#endif
+
+namespace j2 {
+namespace sinks {
+
+namespace {
+// flush()가 기록 스레드를 기다리는 최대 시간
+constexpr std::chrono::milliseconds kFlushWait{50};
+
+// spdlog ansicolor_sink 기본 색상과 같게(레벨 순서: trace..off)
+const char* const kLevelColors[] = {
+    "\033[37m",          // trace: white
+    "\033[36m",          // debug: cyan
+    "\033[32m",          // info: green
+    "\033[33m\033[1m",   // warn: yellow bold
+    "\033[31m\033[1m",   // err: red bold
+    "\033[1m\033[41m",   // critical: bold on red
+    "",                  // off
+};
+constexpr char kReset[] = "\033[m";
+
+void append(std::string& dst, const char* b, const char* e) {
+    dst.append(b, static_cast<std::size_t>(e - b));
+}
+} // anonymous namespace
+
+BatchedConsoleSink::BatchedConsoleSink(Options opt, std::FILE* out)
+    : opt_(opt)
+    , out_(out)
+    , colored_(shouldColor(opt.color, out))
+    , reserveBytes_(std::min<std::size_t>(opt.backlogBytes, 64 * 1024))
+    , formatter_(std::make_unique<spdlog::pattern_formatter>()) {
+    pending_.reserve(reserveBytes_);
+    thread_ = std::thread([this]() { run_(); });
+}
+
+BatchedConsoleSink::~BatchedConsoleSink() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+void BatchedConsoleSink::log(const spdlog::details::log_msg& msg) {
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        formatted_.clear();
+        formatter_->format(msg, formatted_);
+
+        const char* b = formatted_.data();
+        const char* e = b + formatted_.size();
+        const bool paint = colored_ && msg.color_range_end > msg.color_range_start &&
+                           msg.color_range_end <= formatted_.size();
+        const char* color = paint ? kLevelColors[static_cast<std::size_t>(msg.level) % 7] : "";
+        const std::size_t extra = paint ? std::strlen(color) + sizeof(kReset) - 1 : 0;
+
+        if (pending_.size() + formatted_.size() + extra > opt_.backlogBytes) {
+            // 첫 버림이면 깨움: 대기 버퍼가 비어 있어도 알림 줄이 다음 레코드를 기다리지 않게
+            wake = droppedNotice_++ == 0;
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            wake = pending_.empty();
+            if (paint) {
+                append(pending_, b, b + msg.color_range_start);
+                pending_.append(color);
+                append(pending_, b + msg.color_range_start, b + msg.color_range_end);
+                pending_.append(kReset);
+                append(pending_, b + msg.color_range_end, e);
+            } else {
+                append(pending_, b, e);
+            }
+            appendedBytes_ += formatted_.size() + extra;
+        }
+    }
+    if (wake) wake_.notify_one();
+}
+
+void BatchedConsoleSink::flush() {
+    std::unique_lock<std::mutex> lock(mu_);
+    if (stalled_) return;
+    const std::uint64_t target = appendedBytes_;
+    if (!written_.wait_for(lock, kFlushWait, [&]() { return writtenBytes_ >= target; })) {
+        stalled_ = true;
+    }
+}
+
+void BatchedConsoleSink::set_pattern(const std::string& pattern) {
+    set_formatter(std::make_unique<spdlog::pattern_formatter>(pattern));
+}
+
+void BatchedConsoleSink::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) {
+    std::lock_guard<std::mutex> lock(mu_);
+    formatter_ = std::move(sink_formatter);
+}
+
+// 기록 스레드: 대기 버퍼와 묶음 버퍼를 맞바꿔(용량 재사용) 락 밖에서 한 번에 기록
+void BatchedConsoleSink::run_() {
+    std::string batch;
+    batch.reserve(reserveBytes_);
+    std::unique_lock<std::mutex> lock(mu_);
+    for (;;) {
+        wake_.wait(lock, [&]() { return stop_ || !pending_.empty() || droppedNotice_ > 0; });
+        if (pending_.empty() && droppedNotice_ == 0) break;   // stop_
+
+        batch.clear();
+        batch.swap(pending_);
+        const std::uint64_t drops = droppedNotice_;
+        const std::uint64_t upto = appendedBytes_;
+        droppedNotice_ = 0;
+        lock.unlock();
+
+        if (drops > 0) {
+            fmt::format_to(std::back_inserter(batch),
+                           "[console] {} message(s) dropped: console backlog full ({} bytes)\n", drops,
+                           opt_.backlogBytes);
+        }
+        std::fwrite(batch.data(), 1, batch.size(), out_);
+        std::fflush(out_);
+        bytes_.fetch_add(batch.size(), std::memory_order_relaxed);
+
+        lock.lock();
+        writtenBytes_ = upto;
+        stalled_ = false;
+        written_.notify_all();
+    }
+}
+
+ConsoleColor BatchedConsoleSink::parseColor(const std::string& s, ConsoleColor def) {
+    std::string v;
+    for (unsigned char c : s) v.push_back(static_cast<char>(std::tolower(c)));
+    if (v == "auto" || v == "automatic") return ConsoleColor::automatic;
+    if (v == "always" || v == "on")      return ConsoleColor::always;
+    if (v == "never" || v == "off")      return ConsoleColor::never;
+    return def;
+}
+
+bool BatchedConsoleSink::shouldColor(ConsoleColor mode, std::FILE* out) {
+    if (mode == ConsoleColor::never) return false;
+    if (mode == ConsoleColor::automatic &&
+        !(spdlog::details::os::in_terminal(out) && spdlog::details::os::is_color_terminal())) {
+        return false;
+    }
+#if defined(_WIN32)
+    // 콘솔이면 ANSI(VT) 처리를 켜 봄, 실패하면(구형 콘솔) 색상 없이
+    HANDLE h = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(out)));
+    DWORD consoleMode = 0;
+    if (h != INVALID_HANDLE_VALUE && GetConsoleMode(h, &consoleMode)) {
+        if (!SetConsoleMode(h, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING)) return mode == ConsoleColor::always;
+    }
+#endif
+    return true;
+}
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,140 @@
+#include "j2/DedupSink.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/fmt/fmt.h>
+
+namespace j2 {
+namespace sinks {
+
+namespace {
+std::size_t hashOf(const spdlog::details::log_msg& msg) {
+    std::string_view body(msg.payload.data(), msg.payload.size());
+    std::size_t h = std::hash<std::string_view>{}(body);
+    return h ^ ((static_cast<std::size_t>(msg.level) + 1) * 0x9e3779b97f4a7c15ull);
+}
+} // anonymous namespace
+
+DedupSink::DedupSink(spdlog::sink_ptr target, std::chrono::milliseconds window)
+    : target_(std::move(target)), windowMs_(window.count()) {
+    set_level(target_->level());
+}
+
+DedupSink::~DedupSink() {
+    try {
+        drain();
+    } catch (...) {
+    }
+}
+
+void DedupSink::setWindow(std::chrono::milliseconds window) {
+    windowMs_.store(window.count(), std::memory_order_relaxed);
+}
+
+void DedupSink::log(const spdlog::details::log_msg& msg) {
+    const auto now = Clock::now();
+    const auto window = std::chrono::milliseconds(windowMs_.load(std::memory_order_relaxed));
+    const std::size_t hash = hashOf(msg);
+
+    std::lock_guard<std::mutex> lk(mu_);
+    if (Entry* e = find_(hash, msg)) {
+        if (now - e->windowStart < window) {
+            ++e->repeats;
+            e->lastSeen = now;
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // 창이 닫힘: 요약을 먼저 남기고 이번 메시지로 새 창 시작
+        close_(*e);
+        start_(*e, hash, msg, now);
+    } else {
+        start_(claim_(hash), hash, msg, now);
+    }
+    target_->log(msg);
+}
+
+// flush 주기(FLUSH_EVERY_SEC)마다 닫힌 창을 정리해 요약이 늦지 않게 함
+void DedupSink::flush() {
+    sweep();
+    target_->flush();
+}
+
+// FLUSH_ON_LEVEL로 메시지마다 flush가 와도 전체 슬롯 검사는 창의 1/4 간격으로만
+void DedupSink::sweep() {
+    const auto now = Clock::now();
+    const auto window = std::chrono::milliseconds(windowMs_.load(std::memory_order_relaxed));
+    std::lock_guard<std::mutex> lk(mu_);
+    if (now < nextSweep_) return;
+    nextSweep_ = now + std::max(window / 4, std::chrono::milliseconds(1));
+    for (auto& e : entries_) {
+        if (e.used && now - e.windowStart >= window) close_(e);
+    }
+}
+
+void DedupSink::drain() {
+    std::lock_guard<std::mutex> lk(mu_);
+    for (auto& e : entries_) {
+        if (e.used) close_(e);
+    }
+}
+
+void DedupSink::set_pattern(const std::string& pattern) { target_->set_pattern(pattern); }
+
+void DedupSink::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) {
+    target_->set_formatter(std::move(sink_formatter));
+}
+
+DedupSink::Entry* DedupSink::find_(std::size_t hash, const spdlog::details::log_msg& msg) {
+    const std::size_t n = msg.payload.size();
+    const std::size_t cmp = std::min(n, kMaxTextBytes);
+    for (std::size_t i = 0; i < kProbe; ++i) {
+        Entry& e = entries_[(hash + i) % kMaxEntries];
+        if (e.used && e.hash == hash && e.level == msg.level && e.size == n &&
+            e.text.compare(0, std::string::npos, msg.payload.data(), cmp) == 0) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+// 빈 슬롯, 없으면 탐색 범위에서 가장 오래 안 보인 슬롯(요약 후 재사용)
+DedupSink::Entry& DedupSink::claim_(std::size_t hash) {
+    Entry* victim = nullptr;
+    for (std::size_t i = 0; i < kProbe; ++i) {
+        Entry& e = entries_[(hash + i) % kMaxEntries];
+        if (!e.used) return e;
+        if (!victim || e.lastSeen < victim->lastSeen) victim = &e;
+    }
+    close_(*victim);
+    return *victim;
+}
+
+void DedupSink::start_(Entry& e, std::size_t hash, const spdlog::details::log_msg& msg, Clock::time_point now) {
+    e.used = true;
+    e.hash = hash;
+    e.level = msg.level;
+    e.size = msg.payload.size();
+    e.text.assign(msg.payload.data(), std::min(msg.payload.size(), kMaxTextBytes));
+    e.loggerName.assign(msg.logger_name.data(), msg.logger_name.size());
+    e.windowStart = now;
+    e.lastSeen = now;
+    e.repeats = 0;
+}
+
+void DedupSink::close_(Entry& e) {
+    if (e.repeats > 0) {
+        summary_.clear();
+        fmt::format_to(fmt::appender(summary_), "last message repeated {} times: {}{}", e.repeats, e.text,
+                       e.size > e.text.size() ? "..." : "");
+        spdlog::details::log_msg summary(spdlog::log_clock::now(), spdlog::source_loc{}, e.loggerName, e.level,
+                                         spdlog::string_view_t(summary_.data(), summary_.size()));
+        target_->log(summary);
+    }
+    e.used = false;
+    e.repeats = 0;
+}
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,215 @@
+#include "j2/DiskGuard.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
+
+namespace j2 {
+
+namespace {
+constexpr double kRateAlpha = 0.3;        // 채움 속도 EWMA 가중치
+constexpr double kRecoverMargin = 1.0;    // 등급 해제 시 임계값 위로 필요한 여유(%p)
+
+DiskGuard::SpaceInfo defaultSpace(const std::string& dir) {
+    DiskGuard::SpaceInfo si;
+    std::error_code ec;
+    auto s = std::filesystem::space(std::filesystem::path(dir), ec);
+    if (ec) return si;
+    si.capacity  = static_cast<unsigned long long>(s.capacity);
+    si.available = static_cast<unsigned long long>(s.available);
+    si.ok = true;
+    return si;
+}
+} // anonymous namespace
+
+DiskGuard::~DiskGuard() { stop(); }
+
+void DiskGuard::start(Callback cb) {
+    if (running_) return;
+    cb_ = std::move(cb);
+    running_ = true;
+    thread_ = std::thread([this]() { run(); });
+}
+
+void DiskGuard::stop() {
+    if (!running_.exchange(false)) return;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void DiskGuard::configure(const Config& cfg) {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        cfg_ = cfg;
+        cfgDirty_ = true;
+    }
+    cv_.notify_all();
+}
+
+void DiskGuard::setSpaceProvider(SpaceProvider p) {
+    std::lock_guard<std::mutex> lk(mu_);
+    provider_ = std::move(p);
+}
+
+void DiskGuard::run() {
+    std::unique_lock<std::mutex> lk(mu_);
+    while (running_) {
+        lk.unlock();
+        try { tick(); } catch (...) {}
+        lk.lock();
+        auto interval = std::max(cfg_.interval, std::chrono::milliseconds(10));
+        cv_.wait_for(lk, interval, [this]() { return !running_ || cfgDirty_; });
+    }
+}
+
+void DiskGuard::tick() {
+    Config cfg;
+    SpaceProvider provider;
+    bool dirty = false;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        cfg = cfg_;
+        provider = provider_ ? provider_ : SpaceProvider(defaultSpace);
+        dirty = cfgDirty_;
+        cfgDirty_ = false;
+    }
+
+    // 대상 목록이 바뀌면 마운트 그룹 재구성(같은 장치의 대상은 한 번만 조회)
+    if (dirty || targetMount_.size() != cfg.paths.size()) {
+        std::vector<Mount> mounts;
+        std::vector<std::size_t> targetMount;
+        std::vector<Status> status(cfg.paths.size());
+        for (std::size_t i = 0; i < cfg.paths.size(); ++i) {
+            std::string dir = mountDir(cfg.paths[i]);
+            std::uint64_t key = mountKey(dir);
+            auto it = std::find_if(mounts.begin(), mounts.end(),
+                                   [&](const Mount& m) { return m.key == key && (key != 0 || m.dir == dir); });
+            if (it == mounts.end()) {
+                Mount m;
+                m.dir = dir;
+                m.key = key;
+                // 같은 마운트를 이미 보고 있었다면 속도 추정 이어가기
+                for (const auto& old : mounts_) {
+                    if (old.key == key && (key != 0 || old.dir == dir)) { m = old; m.dir = dir; break; }
+                }
+                mounts.push_back(m);
+                it = mounts.end() - 1;
+            }
+            targetMount.push_back(static_cast<std::size_t>(it - mounts.begin()));
+            status[i].path  = cfg.paths[i];
+            status[i].mount = dir;
+            for (const auto& old : status_) {
+                if (old.path == cfg.paths[i]) { status[i].tier = old.tier; break; }
+            }
+        }
+        mounts_.swap(mounts);
+        targetMount_.swap(targetMount);
+        status_.swap(status);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<SpaceInfo> infos(mounts_.size());
+    for (std::size_t m = 0; m < mounts_.size(); ++m) {
+        Mount& mt = mounts_[m];
+        infos[m] = provider(mt.dir);
+        if (!infos[m].ok) continue;
+        if (mt.seen) {
+            double dt = std::chrono::duration<double>(now - mt.lastAt).count();
+            if (dt > 0) {
+                double inst = (static_cast<double>(mt.lastAvail) - static_cast<double>(infos[m].available)) / dt;
+                mt.rate = kRateAlpha * inst + (1.0 - kRateAlpha) * mt.rate;
+            }
+        }
+        mt.seen = true;
+        mt.lastAvail = infos[m].available;
+        mt.lastAt = now;
+    }
+
+    for (std::size_t i = 0; i < status_.size(); ++i) {
+        const Mount& mt = mounts_[targetMount_[i]];
+        const SpaceInfo& si = infos[targetMount_[i]];
+        Status& st = status_[i];
+        st.valid = si.ok;
+        if (!si.ok) continue;  // 조회 실패: 이전 등급 유지
+
+        st.avail = si.available;
+        st.capacity = si.capacity;
+        st.ratio = si.capacity > 0 ? static_cast<double>(si.available) * 100.0 / static_cast<double>(si.capacity)
+                                   : 100.0;
+        st.bytesPerSec = mt.rate;
+        st.tier = computeTier(cfg, si.available, si.capacity, mt.rate, st.tier, &st.secondsToFull);
+    }
+
+    if (cb_) cb_(status_);
+}
+
+// 임계값 k(비율)마다: 이미 넘었거나, 현재 속도로 timeToFullSec 안에 넘을 것으로 예측되면 등급 k
+// 해제는 임계값 + 여유 이상이고 예측 시간도 2배 이상일 때만(경계에서 깜빡임 방지)
+DiskGuard::Tier DiskGuard::computeTier(const Config& cfg, unsigned long long avail, unsigned long long cap,
+                                       double bytesPerSec, Tier current, double* secondsToNext) {
+    if (secondsToNext) *secondsToNext = -1;
+    if (cap == 0) return Tier::ok;
+
+    const double ratios[] = {cfg.warnRatio, cfg.minRatio, cfg.criticalRatio};
+    const double a = static_cast<double>(avail);
+    const double c = static_cast<double>(cap);
+
+    for (int k = 3; k >= 1; --k) {
+        double ratio = ratios[k - 1];
+        if (ratio <= 0) continue;
+        double threshold = c * ratio / 100.0;
+        double eta = (bytesPerSec > 0 && a > threshold) ? (a - threshold) / bytesPerSec : -1;
+
+        bool hit;
+        if (static_cast<int>(current) >= k) {
+            double release = c * (ratio + kRecoverMargin) / 100.0;
+            bool clear = a >= release &&
+                         (cfg.timeToFullSec == 0 || eta < 0 || eta >= 2.0 * cfg.timeToFullSec);
+            hit = !clear;
+        } else {
+            hit = a < threshold ||
+                  (cfg.timeToFullSec > 0 && eta >= 0 && eta < static_cast<double>(cfg.timeToFullSec));
+        }
+
+        if (secondsToNext && eta >= 0 && (*secondsToNext < 0 || eta < *secondsToNext)) *secondsToNext = eta;
+        if (hit) return static_cast<Tier>(k);
+    }
+    return Tier::ok;
+}
+
+// 싱크 파일 경로 → 존재하는 가장 가까운 상위 디렉터리(파일이 아직 없을 수 있음)
+std::string DiskGuard::mountDir(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path p(path.empty() ? "." : path);
+    if (!std::filesystem::is_directory(p, ec)) {
+        p = p.has_parent_path() ? p.parent_path() : std::filesystem::path(".");
+    }
+    while (!p.empty() && !std::filesystem::exists(p, ec)) {
+        if (!p.has_parent_path() || p.parent_path() == p) break;
+        p = p.parent_path();
+    }
+    if (p.empty()) p = ".";
+    return p.string();
+}
+
+// 같은 파일 시스템 판별 키(POSIX: st_dev, 그 외: 루트 경로 해시)
+std::uint64_t DiskGuard::mountKey(const std::string& dir) {
+#if defined(__unix__) || defined(__APPLE__)
+    struct stat st {};
+    if (::stat(dir.c_str(), &st) == 0) return static_cast<std::uint64_t>(st.st_dev) + 1;
+    return 0;
+#else
+    std::error_code ec;
+    auto abs = std::filesystem::absolute(dir, ec);
+    return std::hash<std::string>{}(abs.root_path().string()) | 1;
+#endif
+}
+
+} // namespace j2
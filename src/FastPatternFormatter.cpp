@@ -0,0 +1,178 @@
+#include "j2/FastPatternFormatter.hpp"
+#include "j2/TzFlag.hpp"
+
+#include <chrono>
+#include <spdlog/details/fmt_helper.h>
+#include <spdlog/details/os.h>
+
+namespace j2 {
+
+namespace fh = spdlog::details::fmt_helper;
+
+std::unique_ptr<FastPatternFormatter> FastPatternFormatter::compile(const std::string& pattern,
+                                                                   spdlog::pattern_time_type timeType,
+                                                                   bool utc,
+                                                                   std::string eol) {
+    std::unique_ptr<FastPatternFormatter> f(new FastPatternFormatter());
+    f->timeType_ = timeType;
+    f->eol_ = std::move(eol);
+    auto& items = f->items_;
+
+    // 리터럴은 앞 항목(리터럴/초 구간)에 붙이고, 초 필드는 앞 리터럴까지 초 구간으로 흡수
+    auto addLiteral = [&](const std::string& s) {
+        if (!items.empty() && items.back().op == Op::literal) {
+            items.back().text += s;
+        } else if (!items.empty() && items.back().op == Op::seconds) {
+            auto& fields = items.back().fields;
+            if (!fields.empty() && fields.back().flag == 0) fields.back().text += s;
+            else fields.push_back(Field{0, s});
+        } else {
+            Item it;
+            it.op = Op::literal;
+            it.text = s;
+            items.push_back(std::move(it));
+        }
+    };
+    auto addSecondsField = [&](char flag) {
+        if (!items.empty() && items.back().op == Op::literal) {
+            Item& it = items.back();
+            it.op = Op::seconds;
+            it.fields.push_back(Field{0, std::move(it.text)});
+            it.text.clear();
+        } else if (items.empty() || items.back().op != Op::seconds) {
+            Item it;
+            it.op = Op::seconds;
+            items.push_back(std::move(it));
+        }
+        items.back().fields.push_back(Field{flag, std::string()});
+    };
+    auto addOp = [&](Op op) {
+        Item it;
+        it.op = op;
+        items.push_back(std::move(it));
+    };
+
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c != '%') {
+            addLiteral(std::string(1, c));
+            continue;
+        }
+        if (++i >= pattern.size()) return nullptr;
+        switch (pattern[i]) {
+        case '%': addLiteral("%"); break;
+        case 'Y': case 'm': case 'd': case 'H': case 'M': case 'S':
+            addSecondsField(pattern[i]);
+            break;
+        case 'e': addOp(Op::millis); break;
+        case 'f': addOp(Op::micros); break;
+        case 'F': addOp(Op::nanos); break;
+        case 'l': addOp(Op::level); break;
+        case 'L': addOp(Op::shortLevel); break;
+        case 't': addOp(Op::thread); break;
+        case 'v': addOp(Op::payload); break;
+        case 'n': addOp(Op::loggerName); break;
+        case 'P': addLiteral(std::to_string(spdlog::details::os::pid())); break;
+        case '^': addOp(Op::colorStart); break;
+        case '$': addOp(Op::colorEnd); break;
+        case 'Z': {
+            spdlog::memory_buf_t tz;
+            TzFlag(utc).format(spdlog::details::log_msg(), std::tm{}, tz);
+            addLiteral(std::string(tz.data(), tz.size()));
+            break;
+        }
+        default:
+            return nullptr;  // 패딩/잘라내기/기타 플래그: spdlog 기본 경로
+        }
+    }
+    return f;
+}
+
+void FastPatternFormatter::renderSeconds_(Item& item, std::time_t secs) {
+    std::tm tm = timeType_ == spdlog::pattern_time_type::utc ? spdlog::details::os::gmtime(secs)
+                                                             : spdlog::details::os::localtime(secs);
+    spdlog::memory_buf_t buf;
+    for (const auto& fd : item.fields) {
+        switch (fd.flag) {
+        case 0:   fh::append_string_view(fd.text, buf); break;
+        case 'Y': fh::append_int(tm.tm_year + 1900, buf); break;
+        case 'm': fh::pad2(tm.tm_mon + 1, buf); break;
+        case 'd': fh::pad2(tm.tm_mday, buf); break;
+        case 'H': fh::pad2(tm.tm_hour, buf); break;
+        case 'M': fh::pad2(tm.tm_min, buf); break;
+        case 'S': fh::pad2(tm.tm_sec, buf); break;
+        default: break;
+        }
+    }
+    item.cached.assign(buf.data(), buf.size());
+    item.cachedSec = secs;
+}
+
+void FastPatternFormatter::format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) {
+    using namespace std::chrono;
+    const auto since = msg.time.time_since_epoch();
+    const auto secs = duration_cast<seconds>(since);
+
+    for (auto& it : items_) {
+        switch (it.op) {
+        case Op::literal:
+            fh::append_string_view(it.text, dest);
+            break;
+        case Op::seconds: {
+            auto t = static_cast<std::time_t>(secs.count());
+            if (t != it.cachedSec) renderSeconds_(it, t);
+            fh::append_string_view(it.cached, dest);
+            break;
+        }
+        case Op::millis:
+            fh::pad3(static_cast<std::uint32_t>(duration_cast<milliseconds>(since - secs).count()), dest);
+            break;
+        case Op::micros:
+            fh::pad6(static_cast<std::size_t>(duration_cast<microseconds>(since - secs).count()), dest);
+            break;
+        case Op::nanos:
+            fh::pad9(static_cast<std::size_t>(duration_cast<nanoseconds>(since - secs).count()), dest);
+            break;
+        case Op::level:
+            fh::append_string_view(spdlog::level::to_string_view(msg.level), dest);
+            break;
+        case Op::shortLevel:
+            fh::append_string_view(spdlog::level::to_short_c_str(msg.level), dest);
+            break;
+        case Op::thread:
+            fh::append_int(msg.thread_id, dest);
+            break;
+        case Op::payload:
+            fh::append_string_view(msg.payload, dest);
+            break;
+        case Op::loggerName:
+            fh::append_string_view(msg.logger_name, dest);
+            break;
+        case Op::colorStart:
+            msg.color_range_start = dest.size();
+            break;
+        case Op::colorEnd:
+            msg.color_range_end = dest.size();
+            break;
+        }
+    }
+    fh::append_string_view(eol_, dest);
+}
+
+std::unique_ptr<spdlog::formatter> FastPatternFormatter::clone() const {
+    return std::unique_ptr<spdlog::formatter>(new FastPatternFormatter(*this));
+}
+
+std::unique_ptr<spdlog::formatter> makePatternFormatter(const std::string& pattern,
+                                                        spdlog::pattern_time_type timeType,
+                                                        bool utc,
+                                                        std::string eol) {
+    if (auto fast = FastPatternFormatter::compile(pattern, timeType, utc, eol)) {
+        return fast;
+    }
+    auto f = std::make_unique<spdlog::pattern_formatter>(pattern, timeType, std::move(eol));
+    f->add_flag<TzFlag>('Z', utc).set_pattern(pattern);  // 사용자 플래그는 패턴을 다시 해석해야 반영됨
+    return f;
+}
+
+} // namespace j2
@@ -0,0 +1,93 @@
+#include "j2/FileWriter.hpp"
+#include "j2/UringFileWriter.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define J2_FILE_WRITER_POSIX 1
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace j2 {
+namespace sinks {
+
+void StdioFileWriter::open(const std::string& fname, bool truncate) {
+    closeSyncFd_();
+    file_.open(fname, truncate);
+    openSyncFd_();
+}
+
+void StdioFileWriter::reopen(bool truncate) {
+    closeSyncFd_();
+    file_.reopen(truncate);
+    openSyncFd_();
+}
+
+void StdioFileWriter::close() {
+    file_.close();
+    closeSyncFd_();
+}
+
+// 방금 file_helper가 연 경로를 다시 엶(같은 싱크 mutex 안이라 회전과 겹치지 않음)
+void StdioFileWriter::openSyncFd_() {
+#ifdef J2_FILE_WRITER_POSIX
+    syncFd_ = ::open(file_.filename().c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+void StdioFileWriter::closeSyncFd_() {
+#ifdef J2_FILE_WRITER_POSIX
+    if (syncFd_ >= 0) ::close(syncFd_);
+#endif
+    syncFd_ = -1;
+}
+
+FileWriter::SyncTicket StdioFileWriter::beginSync() {
+    file_.flush();
+    SyncTicket t;
+    t.path = file_.filename();
+#ifdef J2_FILE_WRITER_POSIX
+    if (syncFd_ >= 0) t.fd = ::fcntl(syncFd_, F_DUPFD_CLOEXEC, 0);
+#endif
+    return t;
+}
+
+void StdioFileWriter::endSync(const SyncTicket& t) {
+#ifdef J2_FILE_WRITER_POSIX
+    if (t.fd < 0) return;
+#if defined(__linux__)
+    const int rc = ::fdatasync(t.fd);
+#else
+    const int rc = ::fsync(t.fd);
+#endif
+    const int err = errno;
+    ::close(t.fd);
+    if (rc != 0) spdlog::throw_spdlog_ex("fdatasync failed for " + t.path, err);
+#else
+    (void)t;
+#endif
+}
+
+std::unique_ptr<FileWriter> makeFileWriter(FileIoBackend backend) {
+    static std::atomic<bool> warned{false};
+    if (backend == FileIoBackend::io_uring) {
+        if (UringFileWriter::supported()) {
+            try {
+                return std::make_unique<UringFileWriter>();
+            } catch (const std::exception& e) {
+                if (!warned.exchange(true)) {
+                    std::cerr << "[LoggerManager] FILE_IO_BACKEND=io_uring: " << e.what() << ", using stdio.\n";
+                }
+            }
+        } else if (!warned.exchange(true)) {
+            std::cerr << "[LoggerManager] FILE_IO_BACKEND=io_uring is not available here, using stdio.\n";
+        }
+    }
+    return std::make_unique<StdioFileWriter>();
+}
+
+} // namespace sinks
+} // namespace j2
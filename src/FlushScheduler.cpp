@@ -0,0 +1,157 @@
+#include "j2/FlushScheduler.hpp"
+
+#include <algorithm>
+#include <spdlog/sinks/sink.h>
+
+namespace j2 {
+
+namespace {
+// 커밋 중인 스레드(싱크 flush 안에서 로깅해도 자기 커밋을 기다리지 않게)
+thread_local const FlushScheduler* tlCommitting = nullptr;
+thread_local bool tlRequestOnly = false;
+} // anonymous namespace
+
+FlushScheduler::~FlushScheduler() {
+    stop();
+}
+
+void FlushScheduler::configure(const Options& opt) {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (stop_) return;
+        opt_ = opt;
+        dirty_ = true;
+        durability_.store(opt.durability, std::memory_order_relaxed);
+        groupBytes_.store(opt.groupBytes, std::memory_order_relaxed);
+        if (!thread_.joinable() && (opt.durability != Durability::none || opt.interval.count() > 0)) {
+            thread_ = std::thread([this]() { run(); });
+        }
+    }
+    cv_.notify_all();
+}
+
+void FlushScheduler::setTargets(std::vector<spdlog::sink_ptr> flush, std::vector<spdlog::sink_ptr> sync,
+                                std::vector<spdlog::sink_ptr> sweep) {
+    std::lock_guard<std::mutex> lk(mu_);
+    flushTargets_ = std::move(flush);
+    syncTargets_ = std::move(sync);
+    sweepTargets_ = std::move(sweep);
+}
+
+void FlushScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (stop_) return;
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+
+    std::lock_guard<std::mutex> lk(mu_);
+    durability_.store(Durability::none, std::memory_order_relaxed);
+    done_ = started_ = std::max(started_, requested_);
+    flushTargets_.clear();
+    syncTargets_.clear();
+    sweepTargets_.clear();
+    doneCv_.notify_all();
+}
+
+void FlushScheduler::commitAndWait() {
+    if (!waitsOnCommit() || tlCommitting == this) return;
+    std::unique_lock<std::mutex> lk(mu_);
+    if (stop_ || !thread_.joinable()) return;
+    // 이미 시작된 커밋에는 이 레코드가 빠졌을 수 있으므로 그다음 커밋을 기다림
+    const std::uint64_t target = started_ + 1;
+    if (requested_ < target) {
+        requested_ = target;
+        cv_.notify_one();
+    }
+    if (tlRequestOnly) return;
+    doneCv_.wait(lk, [&]() { return done_ >= target; });
+}
+
+void FlushScheduler::setRequestOnlyThread() noexcept {
+    tlRequestOnly = true;
+}
+
+void FlushScheduler::addBytes(std::size_t n) noexcept {
+    const std::size_t limit = groupBytes_.load(std::memory_order_relaxed);
+    if (limit == 0) return;
+    const std::size_t before = pendingBytes_.fetch_add(n, std::memory_order_relaxed);
+    if (before < limit && before + n >= limit) {
+        // 기준을 처음 넘긴 스레드만 깨움(락을 잡아 커밋 스레드의 대기 진입과 엇갈리지 않게)
+        std::lock_guard<std::mutex> lk(mu_);
+        cv_.notify_one();
+    }
+}
+
+void FlushScheduler::run() {
+    using Clock = std::chrono::steady_clock;
+    std::unique_lock<std::mutex> lk(mu_);
+    auto next = Clock::now() + opt_.interval;
+    for (;;) {
+        auto wake = [this]() {
+            const std::size_t limit = groupBytes_.load(std::memory_order_relaxed);
+            return stop_ || dirty_ || requested_ > started_ ||
+                   (limit > 0 && pendingBytes_.load(std::memory_order_relaxed) >= limit);
+        };
+        if (opt_.interval.count() > 0) cv_.wait_until(lk, next, wake);
+        else                           cv_.wait(lk, wake);
+
+        if (dirty_) {
+            dirty_ = false;
+            next = Clock::now() + opt_.interval;
+        }
+        const std::size_t limit = groupBytes_.load(std::memory_order_relaxed);
+        const bool due = opt_.interval.count() > 0 && Clock::now() >= next;
+        const bool full = limit > 0 && pendingBytes_.load(std::memory_order_relaxed) >= limit;
+        if (!stop_ && !due && !full && requested_ <= started_) continue;
+
+        const Durability d = opt_.durability;
+        const std::uint64_t seq = ++started_;
+        pendingBytes_.store(0, std::memory_order_relaxed);
+        lk.unlock();
+        commit(d);
+        lk.lock();
+        done_ = seq;
+        doneCv_.notify_all();
+        next = Clock::now() + opt_.interval;
+        if (stop_ && requested_ <= done_) break;
+    }
+}
+
+// 대상 목록 복사본으로 mu_ 밖에서 flush/sync(느린 디스크가 대기자 등록을 막지 않게).
+// none이면 SweepSink 정리만
+void FlushScheduler::commit(Durability d) {
+    std::vector<spdlog::sink_ptr> flush, sync;
+    if (d == Durability::none) {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            flush = sweepTargets_;
+        }
+        for (const auto& s : flush) {
+            if (auto* sweeper = dynamic_cast<SweepSink*>(s.get())) {
+                try { sweeper->sweep(); } catch (...) {}
+            }
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        flush = flushTargets_;
+        if (d == Durability::fdatasync) sync = syncTargets_;
+    }
+    tlCommitting = this;
+    for (const auto& s : flush) {
+        try { s->flush(); } catch (...) {}
+    }
+    for (const auto& s : sync) {
+        if (auto* durable = dynamic_cast<DurableSink*>(s.get())) {
+            try { durable->sync(); } catch (...) {}
+        }
+    }
+    commits_.fetch_add(1, std::memory_order_relaxed);
+    tlCommitting = nullptr;
+}
+
+} // namespace j2
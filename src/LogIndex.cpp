@@ -0,0 +1,355 @@
+#include "j2/LogIndex.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <sys/types.h>
+
+#ifdef J2_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef J2_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace j2 {
+namespace sinks {
+
+namespace {
+constexpr char kMagic[8] = {'J', '2', 'L', 'I', 'D', 'X', '0', '1'};
+
+bool endsWith(const std::string& s, const char* suffix) {
+    const std::size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+int seekFile(std::FILE* f, std::uint64_t off, int whence) {
+#if defined(_WIN32)
+    return _fseeki64(f, static_cast<__int64>(off), whence);
+#else
+    return fseeko(f, static_cast<off_t>(off), whence);
+#endif
+}
+
+std::uint64_t tellFile(std::FILE* f) {
+#if defined(_WIN32)
+    return static_cast<std::uint64_t>(_ftelli64(f));
+#else
+    return static_cast<std::uint64_t>(ftello(f));
+#endif
+}
+
+bool readHeader(std::FILE* f) {
+    LogIndexHeader h;
+    return std::fread(&h, sizeof(h), 1, f) == 1 && std::memcmp(h.magic, kMagic, sizeof(kMagic)) == 0;
+}
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// LogIndexWriter
+
+LogIndexWriter::LogIndexWriter(std::size_t blockBytes)
+    : blockBytes_(blockBytes > 0 ? blockBytes : 64 * 1024) {}
+
+LogIndexWriter::~LogIndexWriter() {
+    close();
+}
+
+std::string LogIndexWriter::pathFor(const std::string& logPath) {
+    std::string p = logPath;
+    if (endsWith(p, ".gz"))       p.resize(p.size() - 3);
+    else if (endsWith(p, ".zst")) p.resize(p.size() - 4);
+    return p + ".idx";
+}
+
+void LogIndexWriter::open(const std::string& logPath, bool truncate, std::uint64_t offset) {
+    close();
+    const std::string path = pathFor(logPath);
+
+    // 이어 쓰기: 헤더가 맞고 마지막 항목이 offset 안쪽에서 끝나야 기존 색인 유지(잘린 항목/외부 truncate면 새로)
+    bool fresh = truncate;
+    if (!fresh) {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        fresh = true;
+        if (f) {
+            if (readHeader(f) && seekFile(f, 0, SEEK_END) == 0) {
+                const std::uint64_t sz = tellFile(f);
+                const std::uint64_t body = sz - sizeof(LogIndexHeader);
+                if (body % sizeof(LogIndexBlock) == 0) {
+                    LogIndexBlock last;
+                    fresh = body > 0 &&
+                            (seekFile(f, sz - sizeof(last), SEEK_SET) != 0 ||
+                             std::fread(&last, sizeof(last), 1, f) != 1 || last.offset + last.length > offset);
+                }
+            }
+            std::fclose(f);
+        }
+    }
+
+    // 열린 블록 항목을 제자리에서 고쳐 쓰므로 append 모드가 아닌 r+b(이어 쓰기는 끝으로 이동)
+    fp_ = std::fopen(path.c_str(), fresh ? "w+b" : "r+b");
+    if (!fp_) return;
+    if (!fresh && seekFile(fp_, 0, SEEK_END) != 0) {
+        std::fclose(fp_);
+        fp_ = nullptr;
+        return;
+    }
+    if (fresh) {
+        LogIndexHeader h{};
+        std::memcpy(h.magic, kMagic, sizeof(kMagic));
+        h.blockBytes = static_cast<std::uint32_t>(std::min<std::size_t>(blockBytes_, UINT32_MAX));
+        if (std::fwrite(&h, sizeof(h), 1, fp_) != 1) {
+            std::fclose(fp_);
+            fp_ = nullptr;
+            return;
+        }
+    }
+    cur_ = LogIndexBlock{};
+    cur_.offset = offset;
+    dirty_ = false;
+    entryWritten_ = false;
+}
+
+void LogIndexWriter::note(std::uint64_t offset, std::size_t len, spdlog::log_clock::time_point t,
+                          spdlog::level::level_enum lvl) {
+    if (!fp_) return;
+    const std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    if (cur_.length > 0 && offset != cur_.offset + cur_.length) {
+        closeBlock_();   // 색인 밖에서 기록된 바이트(파생 싱크 헤더 등)가 끼면 블록을 끊음
+    }
+    if (cur_.length == 0) {
+        cur_.offset = offset;
+        cur_.levels = 0;
+        cur_.minNs = cur_.maxNs = ns;
+    }
+    cur_.length += static_cast<std::uint32_t>(len);
+    cur_.levels |= static_cast<std::uint16_t>(1u << (static_cast<unsigned>(lvl) & 15u));
+    cur_.minNs = std::min(cur_.minNs, ns);
+    cur_.maxNs = std::max(cur_.maxNs, ns);
+    dirty_ = true;
+    if (cur_.length >= blockBytes_) closeBlock_();
+}
+
+// 열린 블록 항목은 처음 기록할 때 끝에 붙이고, 이후 flush/확정은 같은 자리를 덮어씀(항목 수 = 블록 수)
+void LogIndexWriter::emit_() {
+    if (!fp_ || !dirty_ || cur_.length == 0) return;
+    dirty_ = false;
+    bool ok;
+    if (entryWritten_) {
+        ok = seekFile(fp_, entryPos_, SEEK_SET) == 0;
+    } else {
+        entryPos_ = tellFile(fp_);
+        entryWritten_ = true;
+        ok = true;
+    }
+    if (!ok || std::fwrite(&cur_, sizeof(cur_), 1, fp_) != 1) {
+        // 디스크 부족 등: 색인만 포기(조회는 색인 없는 구간을 처음부터 읽음)
+        std::fclose(fp_);
+        fp_ = nullptr;
+    }
+}
+
+void LogIndexWriter::closeBlock_() {
+    emit_();
+    cur_ = LogIndexBlock{};
+    dirty_ = false;
+    entryWritten_ = false;
+}
+
+void LogIndexWriter::flush() {
+    emit_();
+    if (fp_) std::fflush(fp_);
+}
+
+void LogIndexWriter::close() {
+    emit_();
+    if (fp_) std::fclose(fp_);
+    fp_ = nullptr;
+    cur_ = LogIndexBlock{};
+    dirty_ = false;
+    entryWritten_ = false;
+}
+
+// ---------------------------------------------------------------------------
+// 읽기
+
+bool loadLogIndex(const std::string& logPath, std::uint64_t fileSize, std::vector<LogIndexBlock>& out) {
+    out.clear();
+    std::FILE* f = std::fopen(LogIndexWriter::pathFor(logPath).c_str(), "rb");
+    if (!f) return false;
+    if (!readHeader(f)) {
+        std::fclose(f);
+        return false;
+    }
+    std::map<std::uint64_t, LogIndexBlock> byOffset;   // 같은 offset은 나중 항목(블록 갱신)이 유효
+    LogIndexBlock b;
+    while (std::fread(&b, sizeof(b), 1, f) == 1) {
+        if (b.length > 0) byOffset[b.offset] = b;
+    }
+    std::fclose(f);
+
+    std::uint64_t end = 0;
+    for (auto& kv : byOffset) {
+        LogIndexBlock blk = kv.second;
+        if (blk.offset < end) continue;             // 이전 블록과 겹침(외부 수정): 앞 블록 우선
+        if (blk.offset >= fileSize) break;
+        if (blk.offset + blk.length > fileSize) blk.length = static_cast<std::uint32_t>(fileSize - blk.offset);
+        out.push_back(blk);
+        end = blk.offset + blk.length;
+    }
+    return true;
+}
+
+struct LogFileReader::Impl {
+    enum class Kind { plain, gzip, zstd } kind = Kind::plain;
+    std::FILE* fp = nullptr;
+    std::uint64_t size = UINT64_MAX;
+#ifdef J2_HAVE_ZLIB
+    gzFile gz = nullptr;
+#endif
+#ifdef J2_HAVE_ZSTD
+    ZSTD_DStream* ds = nullptr;
+    std::vector<char> in, out;
+    ZSTD_inBuffer ib{nullptr, 0, 0};
+    std::size_t outPos = 0, outLen = 0;
+    bool eof = false;
+#endif
+
+    ~Impl() {
+        if (fp) std::fclose(fp);
+#ifdef J2_HAVE_ZLIB
+        if (gz) gzclose(gz);
+#endif
+#ifdef J2_HAVE_ZSTD
+        if (ds) ZSTD_freeDStream(ds);
+#endif
+    }
+
+    std::size_t read(char* dst, std::size_t n) {
+        switch (kind) {
+        case Kind::plain:
+            return std::fread(dst, 1, n, fp);
+#ifdef J2_HAVE_ZLIB
+        case Kind::gzip: {
+            int r = gzread(gz, dst, static_cast<unsigned>(std::min<std::size_t>(n, 1u << 30)));
+            return r > 0 ? static_cast<std::size_t>(r) : 0;
+        }
+#endif
+#ifdef J2_HAVE_ZSTD
+        case Kind::zstd: {
+            std::size_t got = 0;
+            while (got < n) {
+                if (outPos < outLen) {
+                    const std::size_t k = std::min(n - got, outLen - outPos);
+                    std::memcpy(dst + got, out.data() + outPos, k);
+                    outPos += k;
+                    got += k;
+                    continue;
+                }
+                if (eof) break;
+                if (ib.pos == ib.size) {
+                    const std::size_t r = std::fread(in.data(), 1, in.size(), fp);
+                    if (r == 0) { eof = true; break; }
+                    ib = ZSTD_inBuffer{in.data(), r, 0};
+                }
+                ZSTD_outBuffer ob{out.data(), out.size(), 0};
+                if (ZSTD_isError(ZSTD_decompressStream(ds, &ob, &ib))) { eof = true; break; }
+                outPos = 0;
+                outLen = ob.pos;
+            }
+            return got;
+        }
+#endif
+        default:
+            return 0;
+        }
+    }
+};
+
+LogFileReader::LogFileReader() = default;
+LogFileReader::~LogFileReader() = default;
+
+bool LogFileReader::open(const std::string& path) {
+    close();
+    auto impl = std::make_unique<Impl>();
+    if (endsWith(path, ".gz")) {
+#ifdef J2_HAVE_ZLIB
+        impl->kind = Impl::Kind::gzip;
+        impl->gz = gzopen(path.c_str(), "rb");
+        if (!impl->gz) return false;
+        gzbuffer(impl->gz, 256 * 1024);
+#else
+        return false;
+#endif
+    } else if (endsWith(path, ".zst")) {
+#ifdef J2_HAVE_ZSTD
+        impl->kind = Impl::Kind::zstd;
+        impl->fp = std::fopen(path.c_str(), "rb");
+        if (!impl->fp) return false;
+        impl->ds = ZSTD_createDStream();
+        ZSTD_initDStream(impl->ds);
+        impl->in.resize(ZSTD_DStreamInSize());
+        impl->out.resize(ZSTD_DStreamOutSize());
+#else
+        return false;
+#endif
+    } else {
+        impl->fp = std::fopen(path.c_str(), "rb");
+        if (!impl->fp) return false;
+        if (seekFile(impl->fp, 0, SEEK_END) == 0) impl->size = tellFile(impl->fp);
+        seekFile(impl->fp, 0, SEEK_SET);
+    }
+    impl_ = std::move(impl);
+    pos_ = 0;
+    return true;
+}
+
+void LogFileReader::close() {
+    impl_.reset();
+    pos_ = 0;
+}
+
+bool LogFileReader::compressed() const {
+    return impl_ && impl_->kind != Impl::Kind::plain;
+}
+
+std::uint64_t LogFileReader::size() const {
+    return impl_ ? impl_->size : 0;
+}
+
+bool LogFileReader::skipTo(std::uint64_t offset) {
+    if (!impl_) return false;
+    if (impl_->kind == Impl::Kind::plain) {
+        if (seekFile(impl_->fp, offset, SEEK_SET) != 0) return false;
+        pos_ = offset;
+        return true;
+    }
+    if (offset < pos_) return false;
+#ifdef J2_HAVE_ZLIB
+    if (impl_->kind == Impl::Kind::gzip) {
+        if (gzseek(impl_->gz, static_cast<z_off_t>(offset), SEEK_SET) < 0) return false;
+        pos_ = offset;
+        return true;
+    }
+#endif
+    // zstd: 풀어서 버림
+    char scratch[64 * 1024];
+    while (pos_ < offset) {
+        const std::size_t n = impl_->read(scratch, static_cast<std::size_t>(
+                                                       std::min<std::uint64_t>(sizeof(scratch), offset - pos_)));
+        if (n == 0) return false;
+        pos_ += n;
+    }
+    return true;
+}
+
+std::size_t LogFileReader::read(char* dst, std::size_t n) {
+    if (!impl_) return 0;
+    const std::size_t r = impl_->read(dst, n);
+    pos_ += r;
+    return r;
+}
+
+} // namespace sinks
+} // namespace j2
@@ -1,4 +1,9 @@
 #include "j2/LoggerManager.hpp"
+#include "j2/LoggerHandle.hpp"
+#include "j2/FastPatternFormatter.hpp"
+#include "j2/StructuredFormatter.hpp"
+#include "j2/RateLimit.hpp"
+#include "j2/Backtrace.hpp"
 
 #include <spdlog/spdlog.h>
 #include <spdlog/pattern_formatter.h>
@@ -9,35 +14,146 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <thread>
 
 namespace j2 {
 
-// %Z 플래그: TIME_MODE에 따라 "utc" 또는 "local"을 고정폭(기본 5)으로 출력
 namespace {
-class TzFlag : public spdlog::custom_flag_formatter {
+// 파일 싱크 formatter 설정: 포맷 공유가 가능한 싱크면 키와 함께 설정(같은 키끼리 한 번만 포맷)
+void setFileFormatter(const spdlog::sink_ptr& sink, const spdlog::formatter& fmt, std::size_t key) {
+    if (auto* shared = dynamic_cast<j2::sinks::SharedFormatSink*>(sink.get())) {
+        shared->setSharedFormatter(fmt.clone(), key);
+    } else {
+        sink->set_formatter(fmt.clone());
+    }
+}
+
+// 교체/해제로 빠진 파일 싱크는 닫고 이후 기록을 버림(HandoffSink::retire)
+void retireFileSink(const spdlog::sink_ptr& sink) {
+    if (auto* h = dynamic_cast<j2::sinks::HandoffSink*>(sink.get())) h->retire();
+}
+
+// drop_newest 정책: 큐 자리를 먼저 예약(원자 카운터)하고, 예약에 실패하면 새 메시지를 넣지 않고 버린 수만 센다
+// (spdlog 기본 정책은 block / overrun_oldest 뿐이고 async_logger는 final이므로
+//  앞단 로거가 자리를 예약한 뒤에만 block 정책의 내부 async_logger로 넘긴다 → 넣을 때 막히지 않음)
+// 예약 카운터는 같은 스레드 풀의 모든 로거가 공유, 워커가 꺼낸 메시지(기록/flush)마다 QueueSlotSink가 반납
+class QueueSlotSink : public spdlog::sinks::sink {
 public:
-    explicit TzFlag(bool utc, std::size_t width = 5) : utc_(utc), width_(width) {}
+    QueueSlotSink(spdlog::sink_ptr inner, std::shared_ptr<std::atomic<std::size_t>> slots)
+        : inner_(std::move(inner)), slots_(std::move(slots)) {}
 
-    void format(const spdlog::details::log_msg&,
-                const std::tm&,
-                spdlog::memory_buf_t& dest) override
-    {
-        const char* s = utc_ ? "utc" : "local";
-        fmt::format_to(fmt::appender(dest), "{:<{}}", s, width_);
+    void log(const spdlog::details::log_msg& msg) override {
+        slots_->fetch_sub(1, std::memory_order_acq_rel);   // 큐에서 꺼낸 시점에 자리는 비어 있음
+        if (inner_->should_log(msg.level)) inner_->log(msg);
+    }
+    void flush() override {
+        slots_->fetch_sub(1, std::memory_order_acq_rel);
+        inner_->flush();
+    }
+    void set_pattern(const std::string& pattern) override { inner_->set_pattern(pattern); }
+    void set_formatter(std::unique_ptr<spdlog::formatter> f) override { inner_->set_formatter(std::move(f)); }
+
+private:
+    spdlog::sink_ptr inner_;
+    std::shared_ptr<std::atomic<std::size_t>> slots_;
+};
+
+class DropNewestLogger : public spdlog::logger {
+public:
+    DropNewestLogger(std::string name,
+                     spdlog::sink_ptr sink,
+                     std::shared_ptr<spdlog::details::thread_pool> tp,
+                     std::size_t capacity,
+                     std::shared_ptr<std::atomic<std::size_t>> slots,
+                     std::shared_ptr<std::atomic<std::size_t>> dropped)
+        : spdlog::logger(name)
+        , inner_(std::make_shared<spdlog::async_logger>(
+              name, std::make_shared<QueueSlotSink>(std::move(sink), slots), tp,
+              spdlog::async_overflow_policy::block))
+        , capacity_(capacity)
+        , slots_(std::move(slots))
+        , dropped_(std::move(dropped)) {
+        inner_->set_level(spdlog::level::trace);
+        inner_->flush_on(spdlog::level::off);
+    }
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        if (!reserve_()) {
+            dropped_->fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        inner_->log(msg.time, msg.source, msg.level, msg.payload);
+        if (should_flush_(msg)) flush_();
     }
 
-    std::unique_ptr<spdlog::custom_flag_formatter> clone() const override {
-        return spdlog::details::make_unique<TzFlag>(utc_, width_);
+    // flush 요청도 큐 자리를 차지하므로 예약이 안 되면 생략(다음 커밋/flush가 처리)
+    void flush_() override {
+        if (reserve_()) inner_->flush();
     }
 
 private:
-    bool utc_{false};
-    std::size_t width_{5};
+    bool reserve_() {
+        if (slots_->fetch_add(1, std::memory_order_acq_rel) < capacity_) return true;
+        slots_->fetch_sub(1, std::memory_order_acq_rel);
+        return false;
+    }
+
+    std::shared_ptr<spdlog::async_logger> inner_;
+    std::size_t capacity_;
+    std::shared_ptr<std::atomic<std::size_t>> slots_;
+    std::shared_ptr<std::atomic<std::size_t>> dropped_;
 };
 } // anonymous namespace
 
 LoggerManager::LoggerManager() {}
-LoggerManager::~LoggerManager() { stopAutoReload(); }
+
+LoggerManager::~LoggerManager() {
+    stopStatsThread();
+    stopAutoReload();
+    diskGuard_.stop();
+
+    if (textLogger_) {
+        binlog::unregisterChannel(loggerName_);
+        bumpLoggerGeneration();
+    }
+
+    // 매크로 핸들(thread_local)이 로거 객체를 계속 붙잡을 수 있으므로 끝에서 분배 싱크를 비워 파일을 닫음
+    std::vector<std::shared_ptr<j2::sinks::SnapshotDistSink>> dists{distSink_, textDistSink_};
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        for (const auto& name : backtraceNames_) backtrace::unregisterTarget(name);
+        backtraceNames_.clear();
+        for (auto& d : backtraceDists_) dists.push_back(std::move(d));
+        for (auto& d : retiredBacktrace_) dists.push_back(std::move(d));
+        backtraceDists_.clear();
+        retiredBacktrace_.clear();
+        for (const auto& c : categories_) dists.push_back(c.dist);
+        dropCategories();
+    }
+
+    // 비동기 모드: 큐에 남은 메시지를 모두 기록한 뒤 스레드 풀과 함께 로거 해제
+    if (threadPool_) {
+        if (logger_) logger_->flush();
+        if (textLogger_) textLogger_->flush();
+        drainAsyncQueue();
+        spdlog::drop(loggerName_);
+        bumpLoggerGeneration();
+        logger_.reset();
+        textLogger_.reset();
+        threadPool_.reset();
+    }
+
+    // 마지막 그룹 커밋 후 커밋 스레드 종료(이후 FLUSH_ON_LEVEL 대기는 바로 반환)
+    flushScheduler_->stop();
+
+    for (const auto& d : dists) {
+        if (d) d->set_sinks({});
+    }
+    // 바이너리 채널은 ALL 싱크를 직접 가리키므로 파일 싱크도 닫음(DURABILITY=fdatasync면 닫기 전 동기화)
+    retireFileSink(allSink_);
+    retireFileSink(alertsSink_);
+}
 
 // init에서 락을 해제한 뒤 start/stopAutoReload를 호출하여 교착 방지
 bool LoggerManager::init(const std::string& defaultConfigPath,
@@ -83,62 +199,67 @@ bool LoggerManager::init(const std::string& defaultConfigPath,
         auto time_type = utcMode_ ? spdlog::pattern_time_type::utc
                                   : spdlog::pattern_time_type::local;
 
-        auto console_fmt = std::make_unique<spdlog::pattern_formatter>(patternConsole_, time_type);
-        auto file_fmt    = std::make_unique<spdlog::pattern_formatter>(patternFile_,    time_type);
+        // 기본 패턴은 빠른 경로(초 단위 캐시, %Z 고정 문자열), 그 외는 spdlog 기본 + %Z
+        auto console_fmt = makePatternFormatter(patternConsole_, time_type, utcMode_);
+        std::size_t file_key = 0;
+        auto file_fmt    = makeFileFormatter(time_type, file_key);
 
-        // %Z 플래그 등록(utc/local 고정폭 출력)
-        console_fmt->add_flag<TzFlag>('Z', utcMode_);
-        file_fmt->add_flag<TzFlag>('Z', utcMode_);
-
-        distSink_ = std::make_shared<spdlog::sinks::dist_sink_mt>();
+        distSink_ = std::make_shared<j2::sinks::SnapshotDistSink>();
+        textDistSink_ = std::make_shared<j2::sinks::SnapshotDistSink>();
+        rotationWorker_ = std::make_shared<j2::sinks::RotationWorker>();
 
         if (enableConsole_) {
-            consoleSink_ = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+            consoleSink_ = makeConsoleSink();
             consoleSink_->set_level(consoleMin_);
             consoleSink_->set_formatter(console_fmt->clone());
-            distSink_->add_sink(consoleSink_);
         }
 
         if (enableFileAll_) {
             ensureParentDir(allPath_);
-            allSink_ = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
-                allPath_, allMaxSize_, allMaxFiles_, false);
+            allSink_ = makeFileSink(allPath_, allMaxSize_, allMaxFiles_, allOpts_);
             allSink_->set_level(allFileMin_);
-            allSink_->set_formatter(file_fmt->clone());
-            distSink_->add_sink(allSink_);
+            setFileFormatter(allSink_, *file_fmt, file_key);
         }
 
         if (enableFileAlerts_) {
             ensureParentDir(alertsPath_);
-            alertsSink_ = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
-                alertsPath_, alertMaxSize_, alertMaxFiles_, false);
+            alertsSink_ = makeFileSink(alertsPath_, alertMaxSize_, alertMaxFiles_, alertsOpts_);
             alertsSink_->set_level(alertsMin_);
-            alertsSink_->set_formatter(file_fmt->clone());
-            distSink_->add_sink(alertsSink_);
+            setFileFormatter(alertsSink_, *file_fmt, file_key);
+        }
+
+        if (!udpSinkOpts_.host.empty()) {
+            udpSink_ = makeUdpSink();
         }
 
-        if (distSink_->sinks().empty()) {
-            auto fallback = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+        if (shmRole_ == ShmRole::producer) {
+            auto ring = std::make_shared<ShmRing>();
+            if (ring->open(shmOpts_)) {
+                shmSink_ = std::make_shared<j2::sinks::ShmSink>(std::move(ring));
+            } else {
+                std::cerr << "[LoggerManager] SHM_NAME=" << shmOpts_.name << ": " << ring->error() << "\n";
+            }
+        }
+
+        if (!consoleSink_ && !allSink_ && !alertsSink_ && !udpSink_ && !shmSink_) {
+            auto fallback = makeConsoleSink();
             fallback->set_level(spdlog::level::trace);
-            auto fallback_fmt = std::make_unique<spdlog::pattern_formatter>(patternConsole_, time_type);
-            fallback_fmt->add_flag<TzFlag>('Z', utcMode_);
+            auto fallback_fmt = makePatternFormatter(patternConsole_, time_type, utcMode_);
             fallback->set_formatter(std::move(fallback_fmt));
-            distSink_->add_sink(fallback);
             consoleSink_ = fallback;
             std::cerr << "[LoggerManager] No sinks enabled, fallback to console.\n";
         }
 
-        logger_ = std::make_shared<spdlog::logger>(loggerName_, distSink_);
+        publishSinks();
+
+        createLogger();
         spdlog::register_logger(logger_);
+        bumpLoggerGeneration();  // 매크로 캐시 핸들 갱신
 
         applySoftSettings();
 
-        if (flushEverySec_ > 0) {
-            spdlog::flush_every(std::chrono::seconds(flushEverySec_));
-        }
-
-        // 초기 1회 디스크 확인
-        checkDiskAndAct();
+        // 디스크 감시 스레드 시작(첫 확인은 즉시)
+        configureDiskGuard();
 
         need_start = (autoReloadIntervalSec_ > 0);
         interval_to_start = autoReloadIntervalSec_;
@@ -158,62 +279,352 @@ std::shared_ptr<spdlog::logger> LoggerManager::getLogger() const {
     return logger_;
 }
 
+std::shared_ptr<spdlog::logger> LoggerManager::getLogger(const std::string& category) const {
+    std::lock_guard<std::mutex> lk(mu_);
+    for (const auto& c : categories_) {
+        if (c.cfg.name == category) return c.logger;
+    }
+    return nullptr;
+}
+
+std::size_t LoggerManager::asyncDroppedCount() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    std::size_t n = asyncDroppedNewest_->load(std::memory_order_relaxed);
+    if (threadPool_) n += threadPool_->overrun_counter();
+    return n;
+}
+
+LoggerManager::Stats LoggerManager::stats() const {
+    return collectStats(false);
+}
+
+LoggerManager::Stats LoggerManager::collectStats(bool endInterval) const {
+    std::lock_guard<std::mutex> lk(mu_);
+    Stats out;
+    out.at = std::chrono::system_clock::now();
+    auto add = [&](const spdlog::sink_ptr& sink, const SinkStats& st, bool attached) {
+        if (!sink) return;
+        auto snap = st.snapshot(dynamic_cast<const SinkCounters*>(sink.get()), endInterval);
+        snap.attached = attached;
+        out.sinks.push_back(std::move(snap));
+    };
+    add(consoleSink_, *consoleStats_, true);
+    add(allSink_, *allStats_, !allDetachedForDisk());
+    add(alertsSink_, *alertsStats_, !alertsDetachedForDisk());
+    add(udpSink_, *udpStats_, true);
+    add(shmSink_, *shmStats_, true);
+    for (const auto& c : categories_) add(c.fileSink, *c.fileStats, !allDetachedForDisk());
+
+    out.asyncDropped = asyncDroppedNewest_->load(std::memory_order_relaxed);
+    if (threadPool_) out.asyncDropped += threadPool_->overrun_counter();
+    out.allDiskDetaches = allDiskDetaches_;
+    out.alertsDiskDetaches = alertsDiskDetaches_;
+    out.alertsCoalesced = alertsCoalescedCarried_ + (alertsDedup_ ? alertsDedup_->coalesced() : 0);
+    out.rateLimited = SiteLimiter::totalSuppressed();
+    out.flushCommits = flushScheduler_->commits();
+    out.disk.all = allDiskTier_;
+    out.disk.alerts = alertsDiskTier_;
+    return out;
+}
+
+LoggerManager::ShmRole LoggerManager::shmRole() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return shmRole_;
+}
+
+ShmRing::Options LoggerManager::shmOptions() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return shmOpts_;
+}
+
+void LoggerManager::forward(const spdlog::details::log_msg& msg) {
+    std::shared_ptr<spdlog::logger> lg;
+    spdlog::sink_ptr dist;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        lg = logger_;
+        dist = distSink_;
+        const std::string_view name(msg.logger_name.data(), msg.logger_name.size());
+        for (const auto& c : categories_) {
+            if (c.cfg.name == name) {
+                lg = c.logger;
+                dist = c.dist;
+                break;
+            }
+        }
+    }
+    // 로거 앞단(비동기 큐 포함)을 거치지 않고 분배 싱크에 직접 기록 → 싱크별 레벨/계측/그룹 커밋은 그대로 적용
+    if (!lg || !dist || !lg->should_log(msg.level)) return;
+    dist->log(msg);
+}
+
+void LoggerManager::startStatsThread() {
+    {
+        std::lock_guard<std::mutex> lk(statsMu_);
+        statsStop_ = false;
+    }
+    statsThread_ = std::thread([this]() { statsLoop(); });
+}
+
+void LoggerManager::stopStatsThread() {
+    {
+        std::lock_guard<std::mutex> lk(statsMu_);
+        statsStop_ = true;
+    }
+    statsCv_.notify_all();
+    if (statsThread_.joinable()) statsThread_.join();
+}
+
+// STATS_EVERY_SEC마다 직전 요약 이후의 증가분을 한 줄로 기록(0이면 대기만)
+// stats()가 mu_를 잡으므로 statsMu_를 놓은 상태에서 호출(applySoftSettings는 mu_ → statsMu_ 순)
+void LoggerManager::statsLoop() {
+    using clock = std::chrono::steady_clock;
+    Stats prev;
+    clock::time_point last{};
+    bool havePrev = false;
+
+    std::unique_lock<std::mutex> lk(statsMu_);
+    while (!statsStop_) {
+        unsigned every = statsEverySec_.load(std::memory_order_relaxed);
+        bool due = false;
+        if (every == 0) {
+            havePrev = false;
+            statsCv_.wait(lk, [this]() { return statsStop_ || statsKick_; });
+        } else if (havePrev) {
+            due = !statsCv_.wait_until(lk, last + std::chrono::seconds(every),
+                                       [this]() { return statsStop_ || statsKick_; });
+        }
+        if (statsStop_) break;
+        if (statsKick_) {
+            statsKick_ = false;
+            havePrev = false;  // 주기가 바뀌면 기준점부터 다시
+        }
+        if (statsEverySec_.load(std::memory_order_relaxed) == 0) continue;
+        if (havePrev && !due) continue;
+
+        lk.unlock();
+        auto now = clock::now();
+        Stats cur = collectStats(true);   // 다음 요약의 구간 최대는 여기서부터
+        if (havePrev) logStatsSummary(prev, cur, std::chrono::duration<double>(now - last).count());
+        prev = std::move(cur);
+        last = now;
+        havePrev = true;
+        lk.lock();
+    }
+}
+
+namespace {
+std::string humanNs(std::uint64_t ns) {
+    if (ns < 1000) return fmt::format("{}ns", ns);
+    if (ns < 1000000) return fmt::format("{:.1f}us", ns / 1e3);
+    if (ns < 1000000000) return fmt::format("{:.1f}ms", ns / 1e6);
+    return fmt::format("{:.2f}s", ns / 1e9);
+}
+
+const char* tierText(DiskGuard::Tier t) {
+    switch (t) {
+    case DiskGuard::Tier::warn:     return "warn";
+    case DiskGuard::Tier::low:      return "low";
+    case DiskGuard::Tier::critical: return "critical";
+    default:                        return "ok";
+    }
+}
+} // anonymous namespace
+
+void LoggerManager::logStatsSummary(const Stats& prev, const Stats& cur, double seconds) {
+    auto logger = getLogger();
+    if (!logger || seconds <= 0) return;
+
+    std::string line = fmt::format("Logging stats ({:.0f}s):", seconds);
+    for (const auto& s : cur.sinks) {
+        SinkStatsSnapshot base;
+        for (const auto& p : prev.sinks) {
+            if (p.name == s.name) { base = p; break; }
+        }
+        // hard-reload로 카운터가 줄어든 경우(이전 싱크 없음 등) 0부터
+        auto delta = [](std::uint64_t a, std::uint64_t b) { return a >= b ? a - b : a; };
+        std::uint64_t msgs = delta(s.messages, base.messages);
+        std::uint64_t bytes = delta(s.bytes, base.bytes);
+        auto w = s.write.count >= base.write.count ? s.write.since(base.write) : s.write;
+        auto f = s.flush.count >= base.flush.count ? s.flush.since(base.flush) : s.flush;
+
+        line += fmt::format(" {}{} {} msg ({:.1f}/s)", s.name, s.attached ? "" : "(detached)",
+                            msgs, msgs / seconds);
+        if (s.bytes > 0) line += fmt::format(" {:.1f} KiB/s", bytes / seconds / 1024.0);
+        line += fmt::format(" filtered {}", delta(s.filtered, base.filtered));
+        if (s.rotations > base.rotations) line += fmt::format(" rot {}", s.rotations - base.rotations);
+        if (s.dropped > base.dropped) line += fmt::format(" dropped {}", s.dropped - base.dropped);
+        if (s.truncated > base.truncated) line += fmt::format(" truncated {}", s.truncated - base.truncated);
+        if (w.count > 0) {
+            line += fmt::format(" write p50 {} p99 {} max {}", humanNs(w.percentileNs(0.5)),
+                                humanNs(w.percentileNs(0.99)), humanNs(w.maxNs));
+        }
+        if (f.count > 0) {
+            line += fmt::format(" flush {} p99 {}", f.count, humanNs(f.percentileNs(0.99)));
+        }
+        line += ';';
+    }
+    if (cur.alertsCoalesced > prev.alertsCoalesced) {
+        line += fmt::format(" alerts coalesced {};", cur.alertsCoalesced - prev.alertsCoalesced);
+    }
+    if (cur.flushCommits > prev.flushCommits) {
+        line += fmt::format(" commits {};", cur.flushCommits - prev.flushCommits);
+    }
+    line += fmt::format(" async dropped {}; rate-limited {}; disk all={} alerts={} detaches {}/{}",
+                        cur.asyncDropped - std::min(cur.asyncDropped, prev.asyncDropped),
+                        cur.rateLimited - std::min(cur.rateLimited, prev.rateLimited),
+                        tierText(cur.disk.all), tierText(cur.disk.alerts),
+                        cur.allDiskDetaches, cur.alertsDiskDetaches);
+    logger->info("{}", line);
+}
+
+// ASYNC_MODE에 따라 동기/비동기 로거 생성(distSink_를 단일 백엔드로 사용)
+void LoggerManager::createLogger() {
+    if (asyncMode_) {
+        // 워커는 FLUSH_ON_LEVEL 레코드에서 커밋을 요청만 함(기다리는 건 호출 스레드의 몫이 아님, 큐가 밀리지 않게)
+        threadPool_ = std::make_shared<spdlog::details::thread_pool>(
+            asyncQueueSize_, asyncThreads_, []() { FlushScheduler::setRequestOnlyThread(); });
+    }
+    logger_     = makeLogger(loggerName_, distSink_);
+    textLogger_ = makeLogger(loggerName_, textDistSink_);  // 등록하지 않음(바이너리 채널 전용)
+}
+
+std::shared_ptr<spdlog::logger> LoggerManager::makeLogger(const std::string& name, spdlog::sink_ptr sink) {
+    if (!asyncMode_) {
+        return std::make_shared<spdlog::logger>(name, std::move(sink));
+    }
+
+    switch (asyncOverflow_) {
+    case AsyncOverflow::drop_newest:
+        return std::make_shared<DropNewestLogger>(
+            name, std::move(sink), threadPool_, asyncQueueSize_, asyncQueueSlots_, asyncDroppedNewest_);
+    case AsyncOverflow::drop_oldest:
+        return std::make_shared<spdlog::async_logger>(
+            name, std::move(sink), threadPool_, spdlog::async_overflow_policy::overrun_oldest);
+    case AsyncOverflow::block:
+    default:
+        return std::make_shared<spdlog::async_logger>(
+            name, std::move(sink), threadPool_, spdlog::async_overflow_policy::block);
+    }
+}
+
+// 비동기 큐가 빌 때까지 대기(종료 시 로거 해제 전, 최대 5초)
+void LoggerManager::drainAsyncQueue() {
+    if (!threadPool_) return;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (threadPool_->queue_size() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// 지난 보고 이후 새로 버려진 메시지가 있으면 경고 1줄 출력
+void LoggerManager::reportAsyncDrops() {
+    if (!threadPool_ || !logger_) return;
+    std::size_t total = asyncDroppedNewest_->load(std::memory_order_relaxed) +
+                        threadPool_->overrun_counter();
+    if (total > asyncDropsReported_) {
+        logger_->warn("Async queue overflow: {} messages dropped since last report (total {}).",
+                      total - asyncDropsReported_, total);
+        asyncDropsReported_ = total;
+    }
+}
+
 void LoggerManager::applySoftSettings() {
     auto time_type = utcMode_ ? spdlog::pattern_time_type::utc
                               : spdlog::pattern_time_type::local;
 
-    auto console_fmt = std::make_unique<spdlog::pattern_formatter>(patternConsole_, time_type);
-    auto file_fmt    = std::make_unique<spdlog::pattern_formatter>(patternFile_,    time_type);
-
-    // soft-reload 시에도 %Z 재등록(utc/local 변경 반영)
-    console_fmt->add_flag<TzFlag>('Z', utcMode_);
-    file_fmt->add_flag<TzFlag>('Z', utcMode_);
+    // 기본 패턴은 빠른 경로(초 단위 캐시, %Z 고정 문자열), 그 외는 spdlog 기본 + %Z
+    auto console_fmt = makePatternFormatter(patternConsole_, time_type, utcMode_);
+    std::size_t file_key = 0;
+    auto file_fmt    = makeFileFormatter(time_type, file_key);
 
     if (consoleSink_) {
         consoleSink_->set_level(consoleMin_);
         consoleSink_->set_formatter(console_fmt->clone());
     }
     if (allSink_) {
-        allSink_->set_level(allFileMin_);
-        allSink_->set_formatter(file_fmt->clone());
+        allSink_->set_level(effectiveAllLevel());
+        setFileFormatter(allSink_, *file_fmt, file_key);
     }
     if (alertsSink_) {
         alertsSink_->set_level(alertsMin_);
-        alertsSink_->set_formatter(file_fmt->clone());
+        setFileFormatter(alertsSink_, *file_fmt, file_key);
+    }
+    if (syncAlertsDedup()) publishSinks();
+    if (udpSink_) {
+        auto udp_fmt = makePatternFormatter(patternUdp_, time_type, utcMode_, std::string());
+        udpSink_->set_level(udpSinkMin_);
+        udpSink_->set_formatter(std::move(udp_fmt));
+    }
+
+    auto& rate = rateLimitDefaults();
+    rate.everyN.store(rateEveryN_, std::memory_order_relaxed);
+    rate.perSecond.store(ratePerSec_, std::memory_order_relaxed);
+    rate.burst.store(rateBurst_, std::memory_order_relaxed);
+    rate.firstN.store(rateFirstN_, std::memory_order_relaxed);
+
+    // STATS_EVERY_SEC: 처음 켜질 때 요약 스레드 시작, 이후에는 주기만 바꿔 알림
+    if (statsEverySec_.exchange(statsEverySecCfg_) != statsEverySecCfg_) {
+        {
+            std::lock_guard<std::mutex> lk(statsMu_);
+            statsKick_ = true;
+        }
+        statsCv_.notify_all();
     }
+    if (statsEverySecCfg_ > 0 && !statsThread_.joinable()) startStatsThread();
 
+    // FLUSH_ON_LEVEL은 로거 flush_on 대신 분배 싱크의 그룹 커밋 대기로 처리
     if (logger_) {
         logger_->set_level(loggerMin_);
-        logger_->flush_on(flushOn_);
+        logger_->flush_on(spdlog::level::off);
     }
+    if (textLogger_) {
+        textLogger_->set_level(loggerMin_);
+        textLogger_->flush_on(spdlog::level::off);
+    }
+
+    FlushScheduler::Options flushOpts;
+    flushOpts.durability = durability_;
+    flushOpts.interval = std::chrono::seconds(flushEverySec_);
+    flushOpts.groupBytes = flushGroupBytes_;
+    flushScheduler_->configure(flushOpts);
+
+    syncCategories(*file_fmt, file_key);
+    publishBacktraceTargets();
+    publishBinaryChannel();
+    publishFlushTargets();
 }
 
 void LoggerManager::applyHardSettingsIfNeeded(
-    bool old_enableConsole, bool old_enableFileAll, bool old_enableFileAlerts,
+    bool old_enableConsole, const ConsoleSinkOptions& old_consoleOpts,
+    bool old_enableFileAll, bool old_enableFileAlerts,
     const std::string& old_allPath, const std::string& old_alertsPath,
     std::size_t old_allMaxSize, std::size_t old_allMaxFiles,
-    std::size_t old_alertMaxSize, std::size_t old_alertMaxFiles) {
+    std::size_t old_alertMaxSize, std::size_t old_alertMaxFiles,
+    const FileSinkOptions& old_allOpts, const FileSinkOptions& old_alertsOpts,
+    const j2::sinks::UdpSyslogSink::Options& old_udpSinkOpts) {
 
     auto time_type = utcMode_ ? spdlog::pattern_time_type::utc
                               : spdlog::pattern_time_type::local;
-    auto console_fmt = std::make_unique<spdlog::pattern_formatter>(patternConsole_, time_type);
-    auto file_fmt    = std::make_unique<spdlog::pattern_formatter>(patternFile_,    time_type);
+    // 기본 패턴은 빠른 경로(초 단위 캐시, %Z 고정 문자열), 그 외는 spdlog 기본 + %Z
+    auto console_fmt = makePatternFormatter(patternConsole_, time_type, utcMode_);
+    std::size_t file_key = 0;
+    auto file_fmt    = makeFileFormatter(time_type, file_key);
 
-    // hard-reload 시에도 %Z 재등록
-    console_fmt->add_flag<TzFlag>('Z', utcMode_);
-    file_fmt->add_flag<TzFlag>('Z', utcMode_);
+    // 새 싱크를 모두 준비한 뒤 스냅샷을 한 번만 교체하고, 빠진 싱크는 교체 후 flush
+    // (역할별 통계에 빠진 싱크의 누적 바이트/회전 수를 이월)
+    std::vector<std::pair<spdlog::sink_ptr, std::shared_ptr<SinkStats>>> retired;
 
-    bool console_add   =  enableConsole_ && !consoleSink_;
+    bool console_add   =  enableConsole_ && (!consoleSink_ || consoleOpts_ != old_consoleOpts);
     bool console_remove= !enableConsole_ &&  consoleSink_;
     if (console_add) {
-        auto s = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+        auto s = makeConsoleSink();
         s->set_level(consoleMin_);
         s->set_formatter(console_fmt->clone());
-        distSink_->add_sink(s);
+        if (consoleSink_) retired.emplace_back(consoleSink_, consoleStats_);
         consoleSink_ = s;
     } else if (console_remove) {
-        consoleSink_->flush();
-        distSink_->remove_sink(consoleSink_);
+        retired.emplace_back(consoleSink_, consoleStats_);
         consoleSink_.reset();
     }
 
@@ -222,26 +633,21 @@ void LoggerManager::applyHardSettingsIfNeeded(
         (!old_enableFileAll && enableFileAll_) ||
         (allSink_ && (allPath_ != old_allPath ||
                       allMaxSize_ != old_allMaxSize ||
-                      allMaxFiles_ != old_allMaxFiles));
+                      allMaxFiles_ != old_allMaxFiles ||
+                      allOpts_ != old_allOpts));
 
     if (enableFileAll_) {
         if (need_new_all) {
             ensureParentDir(allPath_);
-            auto new_all = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
-                allPath_, allMaxSize_, allMaxFiles_, false);
-            new_all->set_level(allFileMin_);
-            new_all->set_formatter(file_fmt->clone());
-            distSink_->add_sink(new_all);
-            if (allSink_) {
-                allSink_->flush();
-                distSink_->remove_sink(allSink_);
-            }
+            auto new_all = makeFileSink(allPath_, allMaxSize_, allMaxFiles_, allOpts_, allSink_);
+            new_all->set_level(effectiveAllLevel());
+            setFileFormatter(new_all, *file_fmt, file_key);
+            if (allSink_) retired.emplace_back(allSink_, allStats_);
             allSink_.swap(new_all);
         }
     } else {
         if (allSink_) {
-            allSink_->flush();
-            distSink_->remove_sink(allSink_);
+            retired.emplace_back(allSink_, allStats_);
             allSink_.reset();
         }
     }
@@ -251,61 +657,406 @@ void LoggerManager::applyHardSettingsIfNeeded(
         (!old_enableFileAlerts && enableFileAlerts_) ||
         (alertsSink_ && (alertsPath_ != old_alertsPath ||
                          alertMaxSize_ != old_alertMaxSize ||
-                         alertMaxFiles_ != old_alertMaxFiles));
+                         alertMaxFiles_ != old_alertMaxFiles ||
+                         alertsOpts_ != old_alertsOpts));
 
     if (enableFileAlerts_) {
         if (need_new_alerts) {
             ensureParentDir(alertsPath_);
-            auto new_alerts = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
-                alertsPath_, alertMaxSize_, alertMaxFiles_, false);
+            auto new_alerts = makeFileSink(alertsPath_, alertMaxSize_, alertMaxFiles_, alertsOpts_, alertsSink_);
             new_alerts->set_level(alertsMin_);
-            new_alerts->set_formatter(file_fmt->clone());
-            distSink_->add_sink(new_alerts);
-            if (alertsSink_) {
-                alertsSink_->flush();
-                distSink_->remove_sink(alertsSink_);
-            }
+            setFileFormatter(new_alerts, *file_fmt, file_key);
+            if (alertsSink_) retired.emplace_back(alertsSink_, alertsStats_);
             alertsSink_.swap(new_alerts);
         }
     } else {
         if (alertsSink_) {
-            alertsSink_->flush();
-            distSink_->remove_sink(alertsSink_);
+            retired.emplace_back(alertsSink_, alertsStats_);
             alertsSink_.reset();
         }
     }
 
-    if (distSink_->sinks().empty()) {
-        auto fallback = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    if (udpSinkOpts_.host.empty()) {
+        if (udpSink_) {
+            retired.emplace_back(udpSink_, udpStats_);
+            udpSink_.reset();
+        }
+    } else if (!udpSink_ || udpSinkOpts_ != old_udpSinkOpts) {
+        if (udpSink_) retired.emplace_back(udpSink_, udpStats_);
+        udpSink_ = makeUdpSink();
+    }
+
+    bool fallback_added = false;
+    if (!consoleSink_ && !allSink_ && !alertsSink_ && !udpSink_ && !shmSink_) {
+        auto fallback = makeConsoleSink();
         fallback->set_level(spdlog::level::trace);
-        auto fallback_fmt = std::make_unique<spdlog::pattern_formatter>(patternConsole_, time_type);
-        fallback_fmt->add_flag<TzFlag>('Z', utcMode_);
+        auto fallback_fmt = makePatternFormatter(patternConsole_, time_type, utcMode_);
         fallback->set_formatter(std::move(fallback_fmt));
-        distSink_->add_sink(fallback);
         consoleSink_ = fallback;
-        if (logger_) {
-            logger_->warn("No sinks enabled after hard-reload. Fallback to console sink.");
+        fallback_added = true;
+    }
+
+    publishSinks();
+
+    // 교체 완료 후에는 이전 싱크로 들어오는 쓰기가 없음(캐시된 바이너리 채널이 붙잡은 파일도 닫음)
+    for (auto& r : retired) {
+        r.first->flush();
+        r.second->absorb(dynamic_cast<const SinkCounters*>(r.first.get()));
+        retireFileSink(r.first);
+    }
+
+    if (fallback_added && logger_) {
+        logger_->warn("No sinks enabled after hard-reload. Fallback to console sink.");
+    }
+}
+
+// 콘솔 싱크 생성(레벨/패턴은 호출한 쪽에서 설정)
+spdlog::sink_ptr LoggerManager::makeConsoleSink() const {
+    if (consoleOpts_.batched) {
+        return std::make_shared<j2::sinks::BatchedConsoleSink>(consoleOpts_.batch);
+    }
+    spdlog::color_mode mode = spdlog::color_mode::automatic;
+    if (consoleOpts_.batch.color == j2::sinks::ConsoleColor::always)     mode = spdlog::color_mode::always;
+    else if (consoleOpts_.batch.color == j2::sinks::ConsoleColor::never) mode = spdlog::color_mode::never;
+    return std::make_shared<spdlog::sinks::stdout_color_sink_mt>(mode);
+}
+
+// UDP_SINK 생성(레벨/패턴은 applySoftSettings에서 설정)
+std::shared_ptr<j2::sinks::UdpSyslogSink> LoggerManager::makeUdpSink() {
+    auto opts = udpSinkOpts_;
+    if (opts.appName.empty()) opts.appName = loggerName_;
+    auto sink = std::make_shared<j2::sinks::UdpSyslogSink>(std::move(opts));
+    sink->set_level(udpSinkMin_);
+    return sink;
+}
+
+// 텍스트 파일 싱크 formatter(FILE_FORMAT=json|logfmt 면 구조화, 아니면 PATTERN_FILE)와 포맷 공유 키
+std::unique_ptr<spdlog::formatter> LoggerManager::makeFileFormatter(spdlog::pattern_time_type timeType,
+                                                                    std::size_t& key) const {
+    const std::string& eol = spdlog::details::os::default_eol;
+    if (fileLayout_ == FileLayout::pattern) {
+        key = j2::sinks::SharedFormatSink::makeKey(patternFile_, timeType, utcMode_, eol);
+        return makePatternFormatter(patternFile_, timeType, utcMode_);
+    }
+    const bool json = fileLayout_ == FileLayout::json;
+    // 패턴과 겹치지 않도록 제어 문자로 시작하는 가짜 패턴으로 키 생성
+    key = j2::sinks::SharedFormatSink::makeKey(json ? "\x01json" : "\x01logfmt", timeType, utcMode_, eol);
+    return std::make_unique<StructuredFormatter>(
+        json ? StructuredFormatter::Style::json : StructuredFormatter::Style::logfmt, timeType, eol);
+}
+
+// 회전 파일 싱크 생성(회전 후처리는 rotationWorker_가 담당).
+// previous가 같은 경로를 쓰는 싱크면 그 싱크가 파일을 닫은 뒤 만들고 넘겨받음(두 싱크가 한 파일을 동시에 열지 않게)
+spdlog::sink_ptr LoggerManager::makeFileSink(const std::string& path, std::size_t maxSize,
+                                             std::size_t maxFiles, const FileSinkOptions& opts,
+                                             const spdlog::sink_ptr& previous) {
+    auto make = [&]() -> spdlog::sink_ptr {
+        if (opts.format == FileFormat::binary) {
+            return std::make_shared<binlog::BinaryFileSink>(
+                path, maxSize, maxFiles, rotationWorker_, opts.compress, loggerName_, opts.rotate, opts.io);
+        }
+        if (opts.type == FileSinkType::mmap && j2::sinks::MmapFileSink::supported()) {
+            return std::make_shared<j2::sinks::MmapFileSink>(
+                path, maxSize, maxFiles, rotationWorker_, opts.compress);
+        }
+        return std::make_shared<j2::sinks::RotatingFileSink>(
+            path, maxSize, maxFiles, rotationWorker_, opts.compress, opts.rotate, opts.io, opts.indexBlock);
+    };
+    auto* h = dynamic_cast<j2::sinks::HandoffSink*>(previous.get());
+    if (h && h->basePath() == path) return h->handOff(make);
+    return make();
+}
+
+// 현재 싱크 구성(디스크 감시 분리 상태 반영)으로 새 스냅샷을 만들어 교체
+void LoggerManager::publishSinks() {
+    syncAlertsDedup();
+    const spdlog::sink_ptr alerts = alertsDedup_ ? spdlog::sink_ptr(alertsDedup_) : alertsSink_;
+
+    std::vector<spdlog::sink_ptr> sinks;
+    std::vector<std::shared_ptr<SinkStats>> stats;
+    auto add = [&](const spdlog::sink_ptr& s, const std::shared_ptr<SinkStats>& st) {
+        sinks.push_back(s);
+        stats.push_back(st);
+    };
+    if (consoleSink_) add(consoleSink_, consoleStats_);
+    if (allSink_ && !allDetachedForDisk())       add(allSink_, allStats_);
+    if (alerts && !alertsDetachedForDisk()) add(alerts, alertsStats_);
+    if (udpSink_) add(udpSink_, udpStats_);
+    if (shmSink_) add(shmSink_, shmStats_);
+    distSink_->set_sinks(std::move(sinks), std::move(stats));
+
+    // 텍스트 로거에는 바이너리 ALL 싱크를 제외한 나머지만
+    sinks.clear();
+    stats.clear();
+    if (consoleSink_) add(consoleSink_, consoleStats_);
+    if (alerts && !alertsDetachedForDisk()) add(alerts, alertsStats_);
+    if (udpSink_) add(udpSink_, udpStats_);
+    if (shmSink_) add(shmSink_, shmStats_);
+    textDistSink_->set_sinks(std::move(sinks), std::move(stats));
+
+    publishCategorySinks();
+    publishBacktraceTargets();
+    publishBinaryChannel();
+    publishFlushTargets();
+}
+
+// 그룹 커밋 대상: flush는 분배 싱크(콘솔/UDP 포함), fdatasync는 파일 싱크. FLUSH_ON_LEVEL 대기도 분배 싱크에 연결
+void LoggerManager::publishFlushTargets() {
+    // none이어도 commitOn을 넘겨 파일이 아닌 싱크의 레벨 flush는 유지(SnapshotDistSink::log)
+    const auto commitOn = flushOn_;
+    std::vector<spdlog::sink_ptr> flush, sync, sweep;
+    if (distSink_) {
+        distSink_->set_commit(flushScheduler_, commitOn);
+        flush.push_back(distSink_);
+    }
+    if (textDistSink_) textDistSink_->set_commit(flushScheduler_, commitOn);
+    if (allSink_) sync.push_back(allSink_);
+    if (alertsSink_) sync.push_back(alertsSink_);
+    for (const auto& c : categories_) {
+        c.dist->set_commit(flushScheduler_, commitOn);
+        // SINKS=shared면 distSink_는 이미 대상: 전용 파일만 넣어 공용 싱크를 두 번 flush 하지 않음
+        if (!c.cfg.shared || !distSink_) flush.push_back(c.dist);
+        else if (c.fileSink) flush.push_back(c.fileSink);
+        if (c.fileSink) sync.push_back(c.fileSink);
+    }
+    for (const auto& s : sync) {
+        if (auto* durable = dynamic_cast<DurableSink*>(s.get())) {
+            durable->setSyncOnClose(durability_ == FlushScheduler::Durability::fdatasync);
+        }
+    }
+    // none이면 커밋이 없으므로 dedup 창 요약은 주기 sweep으로 내보냄(분리된 alerts는 제외)
+    if (alertsDedup_ && !alertsDetachedForDisk()) sweep.push_back(alertsDedup_);
+    flushScheduler_->setTargets(std::move(flush), std::move(sync), std::move(sweep));
+}
+
+// CATEGORIES 적용: 새 카테고리 로거 생성·등록, 레벨/전용 파일 갱신, INI에서 빠진 카테고리 해제
+void LoggerManager::syncCategories(const spdlog::formatter& fileFmt, std::size_t fileKey) {
+    std::vector<std::pair<spdlog::sink_ptr, std::shared_ptr<SinkStats>>> retired;
+    std::vector<Category> next;
+    next.reserve(categoryCfg_.size());
+    bool registryChanged = false;
+
+    FileSinkOptions opts;   // 전용 파일은 항상 텍스트, 종류/압축/기록 방식은 ALL 파일을 따름
+    opts.type = allOpts_.type;
+    opts.compress = allOpts_.compress;
+    opts.rotate = allOpts_.rotate;
+    opts.io = allOpts_.io;
+    opts.indexBlock = allOpts_.indexBlock;
+
+    for (const auto& cfg : categoryCfg_) {
+        auto it = std::find_if(categories_.begin(), categories_.end(),
+                               [&](const Category& c) { return c.cfg.name == cfg.name; });
+        Category c;
+        if (it != categories_.end()) {
+            c = std::move(*it);
+            categories_.erase(it);
+        } else {
+            if (spdlog::get(cfg.name)) {
+                std::cerr << "[LoggerManager] Category '" << cfg.name << "' already registered, skipped.\n";
+                continue;
+            }
+            c.dist = std::make_shared<j2::sinks::SnapshotDistSink>();
+            c.fileStats = std::make_shared<SinkStats>(cfg.name + ".file");
+            c.logger = makeLogger(cfg.name, c.dist);
+            spdlog::register_logger(c.logger);
+            registryChanged = true;
+        }
+
+        spdlog::sink_ptr previous;
+        if (c.fileSink && (cfg.file != c.cfg.file || cfg.maxSize != c.cfg.maxSize ||
+                           cfg.maxFiles != c.cfg.maxFiles || opts != c.fileOpts)) {
+            retired.emplace_back(c.fileSink, c.fileStats);
+            previous.swap(c.fileSink);
+        }
+        if (!cfg.file.empty() && !c.fileSink) {
+            ensureParentDir(cfg.file);
+            c.fileSink = makeFileSink(cfg.file, cfg.maxSize, cfg.maxFiles, opts, previous);
+        }
+        if (c.fileSink) setFileFormatter(c.fileSink, fileFmt, fileKey);   // 레벨은 publishCategorySinks에서
+        c.cfg = cfg;
+        c.fileOpts = opts;
+        c.logger->set_level(cfg.level);
+        c.logger->flush_on(spdlog::level::off);
+        next.push_back(std::move(c));
+    }
+
+    for (auto& c : categories_) {
+        spdlog::drop(c.cfg.name);
+        // 빠진 카테고리의 로거는 매크로 핸들이 붙잡을 수 있음: 싱크를 비워 전용 파일을 놓음
+        // (큐에 남은 레코드는 리로드 규칙대로 워커가 꺼낼 때의 싱크, 즉 없음으로 기록)
+        c.dist->set_sinks({});
+        if (c.fileSink) retired.emplace_back(c.fileSink, c.fileStats);
+        registryChanged = true;
+    }
+    categories_ = std::move(next);
+    publishCategorySinks();
+    if (registryChanged) bumpLoggerGeneration();
+
+    for (auto& r : retired) {
+        r.first->flush();
+        r.second->absorb(dynamic_cast<const SinkCounters*>(r.first.get()));
+        retireFileSink(r.first);
+    }
+}
+
+// 카테고리 로거의 싱크 목록: 공용(distSink_ 통째로) + 전용 파일(디스크 감시로 all.log가 분리되면 함께 분리)
+// 전용 파일은 카테고리 레벨(LEVEL)로 거르고, all 디스크 등급이 warn이면 all 파일처럼 warn 미만을 버림
+void LoggerManager::publishCategorySinks() {
+    const auto fileLevel = allDiskTier_ == DiskGuard::Tier::warn ? spdlog::level::warn : spdlog::level::trace;
+    for (auto& c : categories_) {
+        if (c.fileSink) c.fileSink->set_level(fileLevel);
+        std::vector<spdlog::sink_ptr> sinks;
+        std::vector<std::shared_ptr<SinkStats>> stats;
+        if (c.cfg.shared && distSink_) {
+            sinks.push_back(distSink_);
+            stats.push_back(nullptr);   // 공용 싱크는 distSink_ 쪽에서 계측
+        }
+        if (c.fileSink && !allDetachedForDisk()) {
+            sinks.push_back(c.fileSink);
+            stats.push_back(c.fileStats);
         }
+        c.dist->set_sinks(std::move(sinks), std::move(stats));
     }
 }
 
+void LoggerManager::dropCategories() {
+    if (categories_.empty()) return;
+    for (auto& c : categories_) {
+        c.logger->flush();
+        spdlog::drop(c.cfg.name);
+    }
+    categories_.clear();
+    bumpLoggerGeneration();
+}
+
+// ALERTS_DEDUP_WINDOW_MS에 맞춰 alertsSink_ 앞의 DedupSink를 만들거나 없앰(레벨/창은 항상 갱신).
+// 게시할 싱크가 바뀌었으면 true(호출자가 publishSinks로 반영)
+bool LoggerManager::syncAlertsDedup() {
+    if (alertsSink_ && alertsDedupWindowMs_ > 0) {
+        const std::chrono::milliseconds window(alertsDedupWindowMs_);
+        if (alertsDedup_ && alertsDedup_->target() == alertsSink_) {
+            alertsDedup_->setWindow(window);
+            alertsDedup_->set_level(alertsSink_->level());
+            return false;
+        }
+        if (alertsDedup_) {
+            alertsDedup_->drain();
+            alertsCoalescedCarried_ += alertsDedup_->coalesced();
+        }
+        alertsDedup_ = std::make_shared<j2::sinks::DedupSink>(alertsSink_, window);
+        return true;
+    }
+    if (!alertsDedup_) return false;
+    alertsDedup_->drain();
+    alertsCoalescedCarried_ += alertsDedup_->coalesced();
+    alertsDedup_.reset();
+    return true;
+}
+
+// BACKTRACE_DEPTH > 0 이면 로거(메인 + 카테고리)마다 링을 쏟아낼 싱크와 로거를 새로 등록
+// (세대 갱신은 뒤따르는 publishBinaryChannel이 수행하고, 이전 대상의 싱크도 그 뒤에 비움)
+// alerts는 DedupSink를 거치고 역할별 통계에 계측, ASYNC_MODE면 덤프도 같은 큐를 거쳐 워커가 기록
+void LoggerManager::publishBacktraceTargets() {
+    for (const auto& name : backtraceNames_) backtrace::unregisterTarget(name);
+    backtraceNames_.clear();
+    for (auto& d : backtraceDists_) retiredBacktrace_.push_back(std::move(d));
+    backtraceDists_.clear();
+    // init에서 비동기 로거를 만들기 전이면 건너뜀(applySoftSettings에서 다시 등록)
+    if (backtraceDepth_ == 0 || (asyncMode_ && !threadPool_)) return;
+
+    const spdlog::sink_ptr alerts = alertsDedup_ ? spdlog::sink_ptr(alertsDedup_) : alertsSink_;
+    std::vector<spdlog::sink_ptr> shared;
+    std::vector<std::shared_ptr<SinkStats>> sharedStats;
+    auto addShared = [&](const spdlog::sink_ptr& s, const std::shared_ptr<SinkStats>& st) {
+        shared.push_back(s);
+        sharedStats.push_back(st);
+    };
+    if (allSink_ && !allDetachedForDisk())  addShared(allSink_, allStats_);
+    if (alerts && !alertsDetachedForDisk()) addShared(alerts, alertsStats_);
+    if (shmSink_) addShared(shmSink_, shmStats_);   // 수집기가 파일에 기록
+
+    auto add = [&](const std::string& name, std::vector<spdlog::sink_ptr> sinks,
+                   std::vector<std::shared_ptr<SinkStats>> stats) {
+        if (sinks.empty()) return;
+        auto dist = std::make_shared<j2::sinks::SnapshotDistSink>(false);
+        dist->set_sinks(std::move(sinks), std::move(stats));
+        auto t = std::make_shared<backtrace::Target>();
+        t->id = backtrace::nextTargetId();
+        t->depth = backtraceDepth_;
+        t->trigger = backtraceTrigger_;
+        t->loggerName = name;
+        t->sinks = dist;
+        t->logger = makeLogger(name, dist);
+        t->logger->set_level(spdlog::level::trace);
+        backtrace::registerTarget(name, std::move(t));
+        backtraceNames_.push_back(name);
+        backtraceDists_.push_back(std::move(dist));
+    };
+    add(loggerName_, shared, sharedStats);
+    for (const auto& c : categories_) {
+        std::vector<spdlog::sink_ptr> sinks;
+        std::vector<std::shared_ptr<SinkStats>> stats;
+        if (c.cfg.shared) {
+            sinks = shared;
+            stats = sharedStats;
+        }
+        if (c.fileSink && !allDetachedForDisk()) {
+            sinks.push_back(c.fileSink);
+            stats.push_back(c.fileStats);
+        }
+        add(c.cfg.name, std::move(sinks), std::move(stats));
+    }
+}
+
+// ALL 파일이 binary 이고 기록 중이면 매크로용 채널 등록, 아니면 해제(매크로 캐시 갱신).
+// ASYNC_MODE면 등록하지 않음: 매크로도 비동기 로거를 거쳐 워커에서 TEXT 레코드로 기록
+void LoggerManager::publishBinaryChannel() {
+    auto bin = std::dynamic_pointer_cast<binlog::BinaryFileSink>(allSink_);
+    if (!bin || asyncMode_ || allDetachedForDisk() || !textLogger_) {
+        binlog::unregisterChannel(loggerName_);
+        bumpLoggerGeneration();
+        retireBacktraceSinks();
+        return;
+    }
+
+    auto ch = std::make_shared<binlog::Channel>();
+    ch->sink = bin;
+    ch->text = textLogger_;
+    ch->flushOn = durability_ == FlushScheduler::Durability::none ? spdlog::level::off : flushOn_;
+    ch->commit = flushScheduler_;
+    ch->textMin = spdlog::level::off;
+    if (consoleSink_) ch->textMin = std::min(ch->textMin, consoleSink_->level());
+    if (alertsSink_ && !alertsDetachedForDisk()) ch->textMin = std::min(ch->textMin, alertsSink_->level());
+    if (udpSink_)     ch->textMin = std::min(ch->textMin, udpSink_->level());
+    binlog::registerChannel(loggerName_, std::move(ch));
+    bumpLoggerGeneration();
+    retireBacktraceSinks();
+}
+
+// 교체된 backtrace 대상을 캐시한 매크로 핸들이 파일을 붙잡지 않도록 싱크를 비움(세대 갱신 뒤)
+void LoggerManager::retireBacktraceSinks() {
+    for (const auto& d : retiredBacktrace_) d->set_sinks({});
+    retiredBacktrace_.clear();
+}
+
 bool LoggerManager::reloadIfChanged() {
     std::lock_guard<std::mutex> lk(mu_);
 
+    reportAsyncDrops();
+
     std::filesystem::file_time_type now;
     try {
         now = std::filesystem::last_write_time(iniPath_);
     } catch (...) {
-        checkDiskAndAct();
         return false;
     }
     if (now == lastWriteTime_) {
-        checkDiskAndAct();
         return false;
     }
     lastWriteTime_ = now;
 
     bool old_enableConsole    = enableConsole_;
+    ConsoleSinkOptions old_consoleOpts = consoleOpts_;
     bool old_enableFileAll    = enableFileAll_;
     bool old_enableFileAlerts = enableFileAlerts_;
     std::string old_allPath   = allPath_;
@@ -314,60 +1065,62 @@ bool LoggerManager::reloadIfChanged() {
     std::size_t old_allMaxFiles=allMaxFiles_;
     std::size_t old_alertMaxSize=alertMaxSize_;
     std::size_t old_alertMaxFiles=alertMaxFiles_;
+    FileSinkOptions old_allOpts   = allOpts_;
+    FileSinkOptions old_alertsOpts= alertsOpts_;
+    auto old_udpSinkOpts = udpSinkOpts_;
 
     bool ok = loadConfig(false);
     if (!ok) {
-        checkDiskAndAct();
         return false;
     }
 
+    // 비동기 큐는 기다리지 않음(생산자가 계속 쓰면 비지 않고 mu_를 잡은 채 멈춤).
+    // 큐에 있던 메시지는 워커가 꺼낼 때의 스냅샷으로 기록되고, 같은 경로로 교체된 파일 싱크는
+    // HandoffSink가 새 싱크로 넘기며 이전 스냅샷은 기록 중인 워커가 놓을 때까지 유지됨
     applyHardSettingsIfNeeded(
-        old_enableConsole, old_enableFileAll, old_enableFileAlerts,
+        old_enableConsole, old_consoleOpts, old_enableFileAll, old_enableFileAlerts,
         old_allPath, old_alertsPath,
-        old_allMaxSize, old_allMaxFiles, old_alertMaxSize, old_alertMaxFiles);
+        old_allMaxSize, old_allMaxFiles, old_alertMaxSize, old_alertMaxFiles,
+        old_allOpts, old_alertsOpts, old_udpSinkOpts);
 
     applySoftSettings();
+    bumpLoggerGeneration();
 
-    if (flushEverySec_ > 0) {
-        spdlog::flush_every(std::chrono::seconds(flushEverySec_));
-    } else {
-        if (logger_) {
-            logger_->warn("FLUSH_EVERY_SEC=0 detected. Disabling periodic flush at runtime is limited. Restart recommended.");
-        }
-    }
-
-    checkDiskAndAct();
+    configureDiskGuard();
     return true;
 }
 
 bool LoggerManager::startAutoReload(unsigned interval_sec) {
     std::lock_guard<std::mutex> lk(mu_);
-    if (autoReloadRunning_) {
-        autoReloadIntervalSec_ = interval_sec ? interval_sec : 60;
-        return true;
-    }
     if (interval_sec == 0) interval_sec = 60;
     autoReloadIntervalSec_ = interval_sec;
+    if (watcher_.running()) {
+        watcher_.setInterval(std::chrono::seconds(interval_sec));
+        return true;
+    }
 
-    autoReloadRunning_ = true;
-    autoReloadThread_ = std::thread([this]() {
-        while (autoReloadRunning_) {
-            try {
-                this->reloadIfChanged();
-            } catch (...) {
-            }
-            std::this_thread::sleep_for(std::chrono::seconds(this->autoReloadIntervalSec_));
-        }
-    });
-    return true;
+    // inotify 사용 시: 파일 변경은 이벤트로 즉시 반영, 주기 tick은 비동기 드롭 보고에만 사용(디스크 감시는 DiskGuard)
+    return watcher_.start(iniPath_,
+                          std::chrono::seconds(interval_sec),
+                          std::chrono::milliseconds(autoReloadDebounceMs_),
+                          watchBackend_,
+                          [this](ConfigWatcher::Event ev) {
+                              if (ev == ConfigWatcher::Event::changed || !watcher_.eventDriven()) {
+                                  this->reloadIfChanged();
+                              } else {
+                                  this->periodicTick();
+                              }
+                          });
+}
+
+// 설정 변경 없이 주기적으로 해야 하는 일(이벤트 기반 감시일 때 tick에서 호출)
+void LoggerManager::periodicTick() {
+    std::lock_guard<std::mutex> lk(mu_);
+    reportAsyncDrops();
 }
 
 void LoggerManager::stopAutoReload() {
-    if (!autoReloadRunning_) return;
-    autoReloadRunning_ = false;
-    if (autoReloadThread_.joinable()) {
-        autoReloadThread_.join();
-    }
+    watcher_.stop();
 }
 
 bool LoggerManager::loadConfig(bool readAutoReload) {
@@ -382,6 +1135,13 @@ bool LoggerManager::loadConfig(bool readAutoReload) {
     enableFileAll_    = toBool(ini_.GetValue(logSection_.c_str(), "ENABLE_FILE_LOG_ALL",   "true"), true);
     enableFileAlerts_ = toBool(ini_.GetValue(logSection_.c_str(), "ENABLE_FILE_LOG_ALERTS","true"), true);
 
+    // 일괄 콘솔(로깅 스레드는 버퍼에 붙이기만, 가득 차면 버리고 셈), 색상은 동기 콘솔에도 적용
+    consoleOpts_.batched = toBool(ini_.GetValue(logSection_.c_str(), "CONSOLE_BATCHED", "false"), false);
+    consoleOpts_.batch.backlogBytes = std::max<std::size_t>(
+        parseSizeBytes(ini_.GetValue(logSection_.c_str(), "CONSOLE_BACKLOG", "1MB"), 1024 * 1024), 4 * 1024);
+    consoleOpts_.batch.color = j2::sinks::BatchedConsoleSink::parseColor(
+        ini_.GetValue(logSection_.c_str(), "CONSOLE_COLOR", "auto"), j2::sinks::ConsoleColor::automatic);
+
     consoleMin_ = parseLevel(ini_.GetValue(logSection_.c_str(), "CONSOLE_LEVEL",     "trace"), spdlog::level::trace);
     allFileMin_ = parseLevel(ini_.GetValue(logSection_.c_str(), "ALL_FILE_LEVEL",    "trace"), spdlog::level::trace);
     alertsMin_  = parseLevel(ini_.GetValue(logSection_.c_str(), "ALERTS_FILE_LEVEL", "warn"),  spdlog::level::warn);
@@ -391,6 +1151,32 @@ bool LoggerManager::loadConfig(bool readAutoReload) {
     flushEverySec_ = static_cast<std::size_t>(
         ini_.GetLongValue(logSection_.c_str(), "FLUSH_EVERY_SEC", 1));
 
+    // 그룹 커밋 강도(none: 커밋 없음, flush: 버퍼 → OS, fdatasync: 파일 싱크까지 디스크에)
+    const std::string durability = toLower(ini_.GetValue(logSection_.c_str(), "DURABILITY", "flush"));
+    if (durability == "none")           durability_ = FlushScheduler::Durability::none;
+    else if (durability == "fdatasync") durability_ = FlushScheduler::Durability::fdatasync;
+    else                                durability_ = FlushScheduler::Durability::flush;
+    flushGroupBytes_ = parseSizeBytes(ini_.GetValue(logSection_.c_str(), "FLUSH_GROUP_BYTES", "0"), 0);
+    long statsEvery = ini_.GetLongValue(logSection_.c_str(), "STATS_EVERY_SEC", 0);
+    statsEverySecCfg_ = statsEvery > 0 ? static_cast<unsigned>(statsEvery) : 0u;
+
+    long btDepth = ini_.GetLongValue(logSection_.c_str(), "BACKTRACE_DEPTH", 0);
+    backtraceDepth_ = btDepth > 0 ? static_cast<std::size_t>(btDepth) : 0u;
+    backtraceTrigger_ = parseLevel(ini_.GetValue(logSection_.c_str(), "BACKTRACE_TRIGGER_LEVEL", "error"),
+                                   spdlog::level::err);
+
+    long dedupMs = ini_.GetLongValue(logSection_.c_str(), "ALERTS_DEDUP_WINDOW_MS", 0);
+    alertsDedupWindowMs_ = dedupMs > 0 ? static_cast<unsigned>(dedupMs) : 0u;
+
+    auto readCount = [&](const char* key, long def) {
+        long v = ini_.GetLongValue(logSection_.c_str(), key, def);
+        return v > 0 ? static_cast<unsigned>(v) : 0u;
+    };
+    rateEveryN_ = std::max(1u, readCount("RATE_LIMIT_EVERY_N", 100));
+    ratePerSec_ = readCount("RATE_LIMIT_PER_SEC", 10);
+    rateBurst_  = readCount("RATE_LIMIT_BURST", 0);
+    rateFirstN_ = readCount("RATE_LIMIT_FIRST_N", 10);
+
     patternConsole_ = ini_.GetValue(logSection_.c_str(), "PATTERN_CONSOLE",
                                     "[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [%t] %v");
     patternFile_    = ini_.GetValue(logSection_.c_str(), "PATTERN_FILE",
@@ -406,10 +1192,94 @@ bool LoggerManager::loadConfig(bool readAutoReload) {
                                    100ull * 1024ull * 1024ull);
     alertMaxFiles_= static_cast<std::size_t>(ini_.GetLongValue(logSection_.c_str(), "ALERT_MAX_FILES",10));
 
-    // 디스크 감시 ON/OFF 및 파라미터
+    // 카테고리: CATEGORIES=net, db → 섹션 [Log.net], [Log.db]
+    categoryCfg_.clear();
+    std::stringstream names(ini_.GetValue(logSection_.c_str(), "CATEGORIES", ""));
+    for (std::string name; std::getline(names, name, ',');) {
+        name.erase(0, name.find_first_not_of(" \t"));
+        name.erase(name.find_last_not_of(" \t") + 1);
+        if (name.empty() || name == loggerName_) continue;
+        if (std::any_of(categoryCfg_.begin(), categoryCfg_.end(),
+                        [&](const CategoryConfig& c) { return c.name == name; })) continue;
+
+        const std::string sec = logSection_ + "." + name;
+        CategoryConfig cfg;
+        cfg.name = name;
+        cfg.level = parseLevel(ini_.GetValue(sec.c_str(), "LEVEL", ""), loggerMin_);
+        std::string sinks = toLower(ini_.GetValue(sec.c_str(), "SINKS", "shared"));
+        cfg.shared = (sinks != "dedicated");
+        if (sinks == "dedicated" || sinks == "both") {
+            auto def = (std::filesystem::path(allPath_).parent_path() / (name + ".log")).string();
+            cfg.file = ini_.GetValue(sec.c_str(), "FILE", def.c_str());
+            cfg.maxSize = parseSizeBytes(ini_.GetValue(sec.c_str(), "MAX_SIZE", ""), allMaxSize_);
+            cfg.maxFiles = static_cast<std::size_t>(
+                ini_.GetLongValue(sec.c_str(), "MAX_FILES", static_cast<long>(allMaxFiles_)));
+        }
+        categoryCfg_.push_back(std::move(cfg));
+    }
+
+    // 회전된 파일 압축 방식(지원되지 않으면 gzip → none 순으로 대체)
+    std::string compress = toLower(ini_.GetValue(logSection_.c_str(), "ROTATE_COMPRESS", "none"));
+    auto rc = j2::sinks::RotateCompress::none;
+    if (compress == "gzip" || compress == "gz")       rc = j2::sinks::RotateCompress::gzip;
+    else if (compress == "zstd" || compress == "zst") rc = j2::sinks::RotateCompress::zstd;
+    if (!j2::sinks::RotationWorker::compressionAvailable(rc)) {
+        std::cerr << "[LoggerManager] ROTATE_COMPRESS=" << compress << " not available in this build.\n";
+        rc = j2::sinks::RotationWorker::compressionAvailable(j2::sinks::RotateCompress::gzip)
+                 ? j2::sinks::RotateCompress::gzip : j2::sinks::RotateCompress::none;
+    }
+    allOpts_.compress    = rc;
+    alertsOpts_.compress = rc;
+
+    // 회전 이름 규칙(shift: all.1.log … 밀기, index: all.000123.log + all.log 링크)과 시간 회전 간격
+    j2::sinks::RotatePolicy rotate;
+    rotate.naming = (toLower(ini_.GetValue(logSection_.c_str(), "ROTATE_NAMING", "shift")) == "index")
+                        ? j2::sinks::RotateNaming::index : j2::sinks::RotateNaming::shift;
+    rotate.interval = parseInterval(ini_.GetValue(logSection_.c_str(), "ROTATE_INTERVAL", "0"));
+    allOpts_.rotate    = rotate;
+    alertsOpts_.rotate = rotate;
+
+    // 파일 기록 방식(stdio: fwrite/fflush, io_uring: 등록 버퍼 + 비동기 제출, 미지원 시 stdio)
+    const std::string ioBackend = toLower(ini_.GetValue(logSection_.c_str(), "FILE_IO_BACKEND", "stdio"));
+    const auto io = (ioBackend == "io_uring" || ioBackend == "uring") ? j2::sinks::FileIoBackend::io_uring
+                                                                      : j2::sinks::FileIoBackend::stdio;
+    allOpts_.io    = io;
+    alertsOpts_.io = io;
+
+    // 사이드카 색인(all.log.idx): 블록(FILE_INDEX_BLOCK)마다 시각 범위 + 레벨 비트맵, j2_log_query가 사용
+    std::size_t indexBlock = 0;
+    if (toBool(ini_.GetValue(logSection_.c_str(), "FILE_INDEX", "false"), false)) {
+        indexBlock = parseSizeBytes(ini_.GetValue(logSection_.c_str(), "FILE_INDEX_BLOCK", "64KB"), 64 * 1024);
+        indexBlock = std::min<std::size_t>(std::max<std::size_t>(indexBlock, 4 * 1024), 1024 * 1024 * 1024);
+    }
+    allOpts_.indexBlock    = indexBlock;
+    alertsOpts_.indexBlock = indexBlock;
+
+    // ALL 파일 싱크 종류(file: 일반 회전 파일, mmap: 미리 할당한 mmap 세그먼트)
+    allOpts_.type = (toLower(ini_.GetValue(logSection_.c_str(), "ALL_SINK_TYPE", "file")) == "mmap")
+                        ? FileSinkType::mmap : FileSinkType::file;
+    if (allOpts_.type == FileSinkType::mmap && rotate != j2::sinks::RotatePolicy{}) {
+        std::cerr << "[LoggerManager] ROTATE_NAMING=index / ROTATE_INTERVAL need ALL_SINK_TYPE=file, using file.\n";
+        allOpts_.type = FileSinkType::file;
+    }
+
+    // ALL 파일 기록 형식(text: PATTERN_FILE, binary: j2_log_decode로 복원, mmap보다 우선)
+    // json/logfmt 는 텍스트 파일의 레코드 모양만 바꾸므로 soft-load(fileLayout_)
+    const std::string fileFormat = toLower(ini_.GetValue(logSection_.c_str(), "FILE_FORMAT", "text"));
+    allOpts_.format = (fileFormat == "binary") ? FileFormat::binary : FileFormat::text;
+    fileLayout_ = (fileFormat == "json")   ? FileLayout::json
+                : (fileFormat == "logfmt") ? FileLayout::logfmt : FileLayout::pattern;
+
+    // 디스크 감시 ON/OFF 및 파라미터(싱크 경로의 마운트는 자동 감시, DISK_ROOT는 추가 대상)
+    // 키가 없으면 켬(기존 INI의 디스크 보호 유지, 헤더 초기값과 같음)
     diskGuardEnable_ = toBool(ini_.GetValue(logSection_.c_str(), "DISK_GUARD_ENABLE", "true"), true);
     diskRoot_         = ini_.GetValue(logSection_.c_str(), "DISK_ROOT", "");
-    diskMinFreeRatio_ = ini_.GetDoubleValue(logSection_.c_str(), "DISK_MIN_FREE_RATIO", 5.0);
+    diskWarnFreeRatio_     = ini_.GetDoubleValue(logSection_.c_str(), "DISK_WARN_FREE_RATIO", 10.0);
+    diskMinFreeRatio_      = ini_.GetDoubleValue(logSection_.c_str(), "DISK_MIN_FREE_RATIO", 5.0);
+    diskCriticalFreeRatio_ = ini_.GetDoubleValue(logSection_.c_str(), "DISK_CRITICAL_FREE_RATIO", 1.0);
+    diskTimeToFullSec_   = static_cast<unsigned>(ini_.GetLongValue(logSection_.c_str(), "DISK_TIME_TO_FULL_SEC", 300));
+    diskGuardIntervalMs_ = static_cast<unsigned>(ini_.GetLongValue(logSection_.c_str(), "DISK_GUARD_INTERVAL_MS", 1000));
+    if (diskGuardIntervalMs_ == 0) diskGuardIntervalMs_ = 1000;
 
     // UDP 알림(Boost.Asio)
     udpIp_            = ini_.GetValue(logSection_.c_str(), "UDP_ALERT_IP", "");
@@ -418,9 +1288,101 @@ bool LoggerManager::loadConfig(bool readAutoReload) {
     udpMessageTmpl_   = ini_.GetValue(logSection_.c_str(), "UDP_ALERT_MESSAGE",
                                     "DISK LOW: path={path} free={avail_bytes}B ({ratio}%)");
 
+    // UDP_SINK=host:port ([v6]:port), 비어 있으면 사용 안 함
+    std::string udpSink = ini_.GetValue(logSection_.c_str(), "UDP_SINK", "");
+    udpSinkOpts_.host.clear();
+    udpSinkOpts_.port = 514;
+    if (!udpSink.empty()) {
+        std::string host = udpSink, port;
+        if (host.front() == '[') {
+            auto close = host.find(']');
+            if (close != std::string::npos) {
+                if (close + 1 < host.size() && host[close + 1] == ':') port = host.substr(close + 2);
+                host = host.substr(1, close - 1);
+            }
+        } else if (auto colon = host.rfind(':'); colon != std::string::npos && host.find(':') == colon) {
+            port = host.substr(colon + 1);
+            host = host.substr(0, colon);
+        }
+        udpSinkOpts_.host = host;
+        if (!port.empty()) {
+            try { udpSinkOpts_.port = static_cast<unsigned short>(std::stoul(port)); } catch (...) {}
+        }
+    }
+    udpSinkOpts_.facility = j2::sinks::UdpSyslogSink::parseFacility(
+        ini_.GetValue(logSection_.c_str(), "UDP_SINK_FACILITY", "local0"), 16);
+    udpSinkOpts_.appName = ini_.GetValue(logSection_.c_str(), "UDP_SINK_APP_NAME", "");
+    udpSinkOpts_.mtu = parseSizeBytes(ini_.GetValue(logSection_.c_str(), "UDP_SINK_MTU", "1400"), 1400);
+    udpSinkOpts_.maxQueued = static_cast<std::size_t>(ini_.GetLongValue(logSection_.c_str(), "UDP_SINK_QUEUE", 1024));
+    udpSinkOpts_.flushInterval = std::chrono::milliseconds(
+        ini_.GetLongValue(logSection_.c_str(), "UDP_SINK_FLUSH_MS", 200));
+    udpSinkMin_ = parseLevel(ini_.GetValue(logSection_.c_str(), "UDP_SINK_LEVEL", "info"), spdlog::level::info);
+    patternUdp_ = ini_.GetValue(logSection_.c_str(), "UDP_SINK_PATTERN", "%v");
+
     if (readAutoReload) {
         autoReloadIntervalSec_ = static_cast<unsigned>(
             ini_.GetLongValue(logSection_.c_str(), "AUTO_RELOAD_SEC", 60));
+        autoReloadDebounceMs_ = static_cast<unsigned>(
+            ini_.GetLongValue(logSection_.c_str(), "AUTO_RELOAD_DEBOUNCE_MS", 200));
+        watchBackend_ = (toLower(ini_.GetValue(logSection_.c_str(), "AUTO_RELOAD_WATCH", "auto")) == "poll")
+                            ? ConfigWatcher::Backend::poll
+                            : ConfigWatcher::Backend::automatic;
+
+        // 비동기 모드(init-only)
+        asyncMode_      = toBool(ini_.GetValue(logSection_.c_str(), "ASYNC_MODE", "false"), false);
+        // 음수/0은 size_t로 바꾸기 전에 걸러냄(음수가 거대한 큐로 바뀌지 않게), 큐는 최소 64
+        const long queueSize = ini_.GetLongValue(logSection_.c_str(), "ASYNC_QUEUE_SIZE", 8192);
+        const long threads   = ini_.GetLongValue(logSection_.c_str(), "ASYNC_THREADS", 1);
+        asyncQueueSize_ = queueSize > 0 ? std::max<std::size_t>(static_cast<std::size_t>(queueSize), 64) : 8192;
+        asyncThreads_   = threads > 0 ? static_cast<std::size_t>(threads) : 1;
+
+        std::string overflow = toLower(ini_.GetValue(logSection_.c_str(), "ASYNC_OVERFLOW", "block"));
+        if (overflow == "drop_oldest" || overflow == "overrun_oldest")
+            asyncOverflow_ = AsyncOverflow::drop_oldest;
+        else if (overflow == "drop_newest" || overflow == "discard_new")
+            asyncOverflow_ = AsyncOverflow::drop_newest;
+        else
+            asyncOverflow_ = AsyncOverflow::block;
+
+        // 공유 메모리 전송(init-only): SHM_NAME=/j2log, SHM_ROLE=producer|collector
+        shmOpts_.name = ini_.GetValue(logSection_.c_str(), "SHM_NAME", "");
+        if (!shmOpts_.name.empty() && shmOpts_.name.front() != '/') shmOpts_.name.insert(0, "/");
+        std::string role = toLower(ini_.GetValue(logSection_.c_str(), "SHM_ROLE", "producer"));
+        shmRole_ = shmOpts_.name.empty() ? ShmRole::off
+                 : role == "collector"   ? ShmRole::collector
+                                         : ShmRole::producer;
+        if (shmRole_ == ShmRole::producer && !ShmRing::supported()) {
+            std::cerr << "[LoggerManager] SHM_NAME is not supported on this platform.\n";
+            shmRole_ = ShmRole::off;
+        }
+        long slots = ini_.GetLongValue(logSection_.c_str(), "SHM_SLOTS", 16384);
+        shmOpts_.slots = slots > 0 ? static_cast<std::size_t>(slots) : 16384u;
+        shmOpts_.slotBytes = parseSizeBytes(ini_.GetValue(logSection_.c_str(), "SHM_SLOT_BYTES", "512"), 512);
+        long stallMs = ini_.GetLongValue(logSection_.c_str(), "SHM_STALL_MS", 1000);
+        shmOpts_.stall = std::chrono::milliseconds(stallMs > 0 ? stallMs : 1000);
+    }
+
+    // 생산자는 파일을 직접 쓰지 않음(all/alerts/카테고리 전용 파일은 수집기 몫, 카테고리 레코드는 이름 그대로 전달)
+    if (shmRole_ == ShmRole::producer) {
+        enableFileAll_ = false;
+        enableFileAlerts_ = false;
+        for (auto& c : categoryCfg_) {
+            c.shared = true;
+            c.file.clear();
+        }
+    }
+
+    // hX_kv 필드는 호출 스레드의 thread_local로 formatter에 넘어가므로 비동기 워커에서 포맷하면 보이지 않음
+    if (asyncMode_ && fileLayout_ != FileLayout::pattern && !structuredAsyncWarned_) {
+        structuredAsyncWarned_ = true;
+        std::cerr << "[LoggerManager] FILE_FORMAT=" << fileFormat
+                  << " with ASYNC_MODE=true: hX_kv fields are written inside msg, not as separate fields.\n";
+    }
+    // 바이너리 매크로 경로는 호출 스레드에서 기록하므로 비동기 모드에서는 쓰지 않음(publishBinaryChannel)
+    if (asyncMode_ && allOpts_.format == FileFormat::binary && !binaryAsyncWarned_) {
+        binaryAsyncWarned_ = true;
+        std::cerr << "[LoggerManager] FILE_FORMAT=binary with ASYNC_MODE=true: hX records are queued and "
+                     "written as preformatted TEXT records, without deferred formatting.\n";
     }
 
     return true;
@@ -476,6 +1438,23 @@ std::size_t LoggerManager::parseSizeBytes(const std::string& s, std::size_t defa
     return static_cast<std::size_t>(bytes);
 }
 
+// "90" / "90s" / "30m" / "1h" / "1d" → 초 (0 또는 해석 불가: 사용 안 함)
+std::chrono::seconds LoggerManager::parseInterval(const std::string& s) const {
+    std::string v = toLower(s);
+    v.erase(std::remove_if(v.begin(), v.end(), [](unsigned char c){ return std::isspace(c); }), v.end());
+    std::size_t i = 0;
+    while (i < v.size() && std::isdigit(static_cast<unsigned char>(v[i]))) ++i;
+    if (i == 0 || i > 9) return std::chrono::seconds(0);
+    long long n = std::stoll(v.substr(0, i));
+    std::string unit = v.substr(i);
+    long long mul = 0;
+    if (unit.empty() || unit == "s" || unit == "sec") mul = 1;
+    else if (unit == "m" || unit == "min")            mul = 60;
+    else if (unit == "h" || unit == "hour")           mul = 3600;
+    else if (unit == "d" || unit == "day")            mul = 86400;
+    return std::chrono::seconds(n * mul);
+}
+
 spdlog::level::level_enum LoggerManager::parseLevel(
     const std::string& s, spdlog::level::level_enum def) const {
     std::string v = toLower(s);
@@ -489,59 +1468,125 @@ spdlog::level::level_enum LoggerManager::parseLevel(
     return def;
 }
 
-void LoggerManager::checkDiskAndAct() {
-    if (!diskGuardEnable_) {
-        if (fileSinksDetachedForDisk_) {
-            if (enableFileAll_    && allSink_)    distSink_->add_sink(allSink_);
-            if (enableFileAlerts_ && alertsSink_) distSink_->add_sink(alertsSink_);
-            applySoftSettings();
-            fileSinksDetachedForDisk_ = false;
-            if (logger_) logger_->info("Disk guard disabled by config. File logging resumed.");
-        }
-        return;
-    }
+LoggerManager::DiskState LoggerManager::diskState() const noexcept {
+    std::uint8_t v = diskState_.load(std::memory_order_acquire);
+    DiskState st;
+    st.all    = static_cast<DiskGuard::Tier>(v & 0x0F);
+    st.alerts = static_cast<DiskGuard::Tier>(v >> 4);
+    return st;
+}
 
-    if (diskRoot_.empty()) return;
+void LoggerManager::setDiskSpaceProvider(DiskGuard::SpaceProvider provider) {
+    diskGuard_.setSpaceProvider(std::move(provider));
+}
 
-    std::filesystem::space_info info{};
-    try {
-        info = std::filesystem::space(std::filesystem::path(diskRoot_));
-    } catch (...) {
-        if (logger_) logger_->warn("DISK_ROOT='{}' space() failed. Skip this round.", diskRoot_);
-        return;
+// all 등급 warn: ALL_FILE_LEVEL과 warn 중 높은 쪽
+spdlog::level::level_enum LoggerManager::effectiveAllLevel() const {
+    if (allDiskTier_ == DiskGuard::Tier::warn) return std::max(allFileMin_, spdlog::level::warn);
+    return allFileMin_;
+}
+
+// 감시 대상 갱신(mu_ 보유 상태, 감시 스레드를 기다리지 않음)
+// 비활성화 시 대상을 비우고 등급을 즉시 해제하여 파일 로깅 복귀
+void LoggerManager::configureDiskGuard() {
+    DiskGuard::Config cfg;
+    if (diskGuardEnable_) {
+        if (enableFileAll_)    cfg.paths.push_back(allPath_);
+        if (enableFileAlerts_) cfg.paths.push_back(alertsPath_);
+        for (const auto& c : categoryCfg_) {
+            if (!c.file.empty()) cfg.paths.push_back(c.file);
+        }
+        if (!diskRoot_.empty()) cfg.paths.push_back(diskRoot_);
+    } else {
+        onDiskStatus({});
+    }
+    cfg.warnRatio     = diskWarnFreeRatio_;
+    cfg.minRatio      = diskMinFreeRatio_;
+    cfg.criticalRatio = diskCriticalFreeRatio_;
+    cfg.timeToFullSec = diskTimeToFullSec_;
+    cfg.interval      = std::chrono::milliseconds(diskGuardIntervalMs_);
+    diskGuard_.configure(cfg);
+
+    if (diskGuardEnable_ && !diskGuard_.running()) {
+        diskGuard_.start([this](const std::vector<DiskGuard::Status>& status) {
+            std::lock_guard<std::mutex> lk(mu_);
+            onDiskStatus(status);
+        });
     }
+}
 
-    unsigned long long avail = static_cast<unsigned long long>(info.available);
-    unsigned long long cap   = static_cast<unsigned long long>(info.capacity);
-    long double ratio = cap > 0 ? (static_cast<long double>(avail) * 100.0L / static_cast<long double>(cap)) : 100.0L;
+// DiskGuard 스레드(또는 비활성화 시 호출 스레드)에서 mu_ 보유 상태로 호출
+// 대상 경로별 등급 → 싱크별 등급(DISK_ROOT는 두 싱크 모두에 적용)
+void LoggerManager::onDiskStatus(const std::vector<DiskGuard::Status>& status) {
+    using Tier = DiskGuard::Tier;
+    if (!diskGuardEnable_ && !status.empty()) return;  // 비활성화 직전에 시작된 tick 결과
+    Tier allTier = Tier::ok, alertsTier = Tier::ok;
+    const DiskGuard::Status* worst = nullptr;
+    for (const auto& st : status) {
+        bool root = !diskRoot_.empty() && st.path == diskRoot_;
+        bool category = std::any_of(categoryCfg_.begin(), categoryCfg_.end(),
+                                    [&](const CategoryConfig& c) { return !c.file.empty() && st.path == c.file; });
+        if (root || category || st.path == allPath_) allTier = std::max(allTier, st.tier);
+        if (root || st.path == alertsPath_) alertsTier = std::max(alertsTier, st.tier);
+        if (!worst || st.tier > worst->tier) worst = &st;
+    }
 
-    bool low = (ratio < static_cast<long double>(diskMinFreeRatio_));
+    if (allTier != allDiskTier_ || alertsTier != alertsDiskTier_) {
+        bool escalated = allTier > allDiskTier_ || alertsTier > alertsDiskTier_;
+        bool wasAllDetached = allDetachedForDisk();
+        bool wasAlertsDetached = alertsDetachedForDisk();
+        allDiskTier_ = allTier;
+        alertsDiskTier_ = alertsTier;
+        diskState_.store(static_cast<std::uint8_t>(static_cast<unsigned>(allTier) |
+                                                   (static_cast<unsigned>(alertsTier) << 4)),
+                         std::memory_order_release);
+
+        if (allSink_) allSink_->set_level(effectiveAllLevel());
+        publishSinks();
+        if (!wasAllDetached && allDetachedForDisk() && allSink_) {
+            allSink_->flush();
+            ++allDiskDetaches_;
+        }
+        if (!wasAlertsDetached && alertsDetachedForDisk() && alertsSink_) {
+            alertsSink_->flush();
+            ++alertsDiskDetaches_;
+        }
 
-    if (low) {
-        if (!fileSinksDetachedForDisk_) {
-            if (allSink_)    { allSink_->flush();    distSink_->remove_sink(allSink_); }
-            if (alertsSink_) { alertsSink_->flush(); distSink_->remove_sink(alertsSink_); }
-            fileSinksDetachedForDisk_ = true;
-            if (logger_) logger_->warn("Low disk space on '{}': {:.2f}% free. File logging suspended, console only.", diskRoot_, static_cast<double>(ratio));
+        if (logger_) {
+            std::string where = worst ? worst->path : std::string("-");
+            double ratio = worst ? worst->ratio : 100.0;
+            double mbps = worst ? worst->bytesPerSec / (1024.0 * 1024.0) : 0.0;
+            double eta = worst ? worst->secondsToFull : -1;
+            std::string etaText = eta >= 0 ? fmt::format("~{:.0f}s", eta) : std::string("unknown");
+            const char* allText = allDetachedForDisk() ? "suspended"
+                                : (allDiskTier_ == Tier::warn ? "raised to warn" : "normal");
+            const char* alertsText = alertsDetachedForDisk() ? "suspended" : "normal";
+            if (escalated) {
+                logger_->warn("Disk pressure on '{}': {:.2f}% free, {:.2f} MB/s, {} to next threshold. "
+                              "all.log {}, alerts.log {}.",
+                              where, ratio, mbps, etaText, allText, alertsText);
+            } else {
+                logger_->info("Disk pressure eased on '{}': {:.2f}% free. all.log {}, alerts.log {}.",
+                              where, ratio, allText, alertsText);
+            }
         }
+    }
 
+    // 파일 로깅이 분리된 동안 UDP 알림 반복
+    if (worst && worst->tier >= Tier::low) {
         auto now = std::chrono::steady_clock::now();
         bool due = (lastUdpSent_.time_since_epoch().count() == 0) ||
                    (now - lastUdpSent_ >= std::chrono::seconds(udpIntervalSec_));
         if (due && !udpIp_.empty() && udpPort_ > 0) {
-            std::string payload = buildUdpMessage(udpMessageTmpl_, diskRoot_, avail, ratio);
+            std::string payload = buildUdpMessage(udpMessageTmpl_, worst->path, worst->avail,
+                                                  static_cast<long double>(worst->ratio));
+            // 증가 추세가 없으면(-1) 예상 시간을 알 수 없음
+            replaceAll(payload, "{eta_sec}", worst->secondsToFull < 0 ? std::string("unknown")
+                                                                       : fmt::format("{:.0f}", worst->secondsToFull));
             if (sendUdpAlert(payload)) {
                 lastUdpSent_ = now;
             }
         }
-    } else {
-        if (fileSinksDetachedForDisk_) {
-            if (enableFileAll_    && allSink_)    distSink_->add_sink(allSink_);
-            if (enableFileAlerts_ && alertsSink_) distSink_->add_sink(alertsSink_);
-            applySoftSettings();
-            fileSinksDetachedForDisk_ = false;
-            if (logger_) logger_->info("Disk space recovered on '{}': {:.2f}% free. File logging resumed.", diskRoot_, static_cast<double>(ratio));
-        }
     }
 }
 
@@ -570,18 +1615,15 @@ void LoggerManager::replaceAll(std::string& s, const std::string& from, const st
     }
 }
 
+// 대기열에 넣고 바로 반환(mu_ 보유 중에도 이름 해석/전송으로 막히지 않음)
 bool LoggerManager::sendUdpAlert(const std::string& msg) {
-    try {
-        boost::asio::io_context io;
-        boost::asio::ip::udp::endpoint ep(boost::asio::ip::make_address(udpIp_), static_cast<unsigned short>(udpPort_));
-        boost::asio::ip::udp::socket sock(io);
-        sock.open(boost::asio::ip::udp::v4());
-        sock.send_to(boost::asio::buffer(msg), ep);
-        sock.close();
-        return true;
-    } catch (...) {
-        return false;
+    std::string target = udpIp_ + ":" + std::to_string(udpPort_);
+    if (!alertTransport_) alertTransport_ = std::make_unique<UdpTransport>(64);
+    if (target != alertTarget_) {
+        alertTransport_->setTarget(udpIp_, static_cast<unsigned short>(udpPort_));
+        alertTarget_ = target;
     }
+    return alertTransport_->send(msg);
 }
 
 } // namespace j2
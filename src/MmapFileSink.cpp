@@ -0,0 +1,406 @@
+#include "j2/MmapFileSink.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/details/os.h>
+#include <spdlog/pattern_formatter.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define J2_MMAP_SINK_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace j2 {
+namespace sinks {
+
+namespace {
+std::atomic<std::uint64_t> g_nextSinkId{1};
+
+// 스레드별 formatter 복제본(싱크 id + 세대 번호로 무효화)
+struct TlsFormatter {
+    std::uint64_t sinkId = 0;
+    std::uint64_t gen = 0;
+    std::unique_ptr<spdlog::formatter> f;
+};
+constexpr std::size_t kMaxTlsFormatters = 8;
+thread_local std::vector<TlsFormatter> t_formatters;
+thread_local spdlog::memory_buf_t t_buf;
+
+#ifdef J2_MMAP_SINK_POSIX
+// 비정상 종료한 세그먼트는 용량 전체가 할당된 채 뒤쪽이 0으로 남음: 마지막 0 아닌 바이트까지의 길이.
+// 구멍(hole)은 SEEK_HOLE로 건너뛰고, 데이터 영역 끝에서부터 거꾸로 읽음
+std::size_t trimmedLength(int fd, std::size_t size) {
+    std::size_t end = size;
+#ifdef SEEK_HOLE
+    off_t data = 0;
+    off_t lastEnd = -1;
+    while (static_cast<std::size_t>(data) < size) {
+        data = ::lseek(fd, data, SEEK_DATA);
+        if (data < 0) break;   // ENXIO: 뒤에 데이터 없음, 그 밖의 오류: 지원 안 함
+        off_t hole = ::lseek(fd, data, SEEK_HOLE);
+        if (hole < 0) { lastEnd = -1; break; }
+        lastEnd = hole;
+        data = hole;
+    }
+    if (data < 0 && errno == ENXIO) end = lastEnd < 0 ? 0 : std::min(size, static_cast<std::size_t>(lastEnd));
+#endif
+    char chunk[64 * 1024];
+    while (end > 0) {
+        const std::size_t n = std::min(end, sizeof(chunk));
+        const ssize_t r = ::pread(fd, chunk, n, static_cast<off_t>(end - n));
+        if (r != static_cast<ssize_t>(n)) return end;   // 읽기 실패: 여기까지만 정리
+        std::size_t i = n;
+        while (i > 0 && chunk[i - 1] == '\0') --i;
+        if (i > 0) return end - n + i;
+        end -= n;
+    }
+    return 0;
+}
+#endif
+} // anonymous namespace
+
+bool MmapFileSink::supported() {
+#ifdef J2_MMAP_SINK_POSIX
+    return true;
+#else
+    return false;
+#endif
+}
+
+MmapFileSink::MmapFileSink(std::string base_filename,
+                           std::size_t max_size,
+                           std::size_t max_files,
+                           std::shared_ptr<RotationWorker> worker,
+                           RotateCompress compress)
+    : base_filename_(std::move(base_filename))
+    , max_size_(max_size)
+    , max_files_(max_files)
+    , compress_(compress)
+    , worker_(std::move(worker))
+    , sinkId_(g_nextSinkId.fetch_add(1, std::memory_order_relaxed))
+    , formatter_(spdlog::details::make_unique<spdlog::pattern_formatter>()) {
+    if (max_size_ == 0) {
+        spdlog::throw_spdlog_ex("mmap sink constructor: max_size arg cannot be zero");
+    }
+    std::unique_lock<std::shared_mutex> lk(rwMu_);
+    openSegment();
+    if (worker_) worker_->recoverStaged(base_filename_, max_files_, compress_);
+}
+
+MmapFileSink::~MmapFileSink() {
+    std::unique_lock<std::shared_mutex> lk(rwMu_);
+    closeSegment();
+}
+
+spdlog::formatter& MmapFileSink::threadFormatter() {
+    std::uint64_t gen = fmtGen_.load(std::memory_order_acquire);
+    for (auto& e : t_formatters) {
+        if (e.sinkId == sinkId_) {
+            if (e.gen != gen) {
+                std::lock_guard<std::mutex> lk(fmtMu_);
+                e.f = formatter_->clone();
+                e.gen = fmtGen_.load(std::memory_order_relaxed);
+            }
+            return *e.f;
+        }
+    }
+    // 하드 리로드로 사라진 싱크의 항목이 쌓이지 않도록 오래된 것부터 제거
+    if (t_formatters.size() >= kMaxTlsFormatters) {
+        t_formatters.erase(t_formatters.begin());
+    }
+    std::lock_guard<std::mutex> lk(fmtMu_);
+    t_formatters.push_back({sinkId_, fmtGen_.load(std::memory_order_relaxed), formatter_->clone()});
+    return *t_formatters.back().f;
+}
+
+void MmapFileSink::log(const spdlog::details::log_msg& msg) {
+    auto& buf = t_buf;
+    buf.clear();
+    threadFormatter().format(msg, buf);
+    if (!write(buf.data(), buf.size()) && handedOff()) forwardRendered(msg, formatKey(), buf);
+}
+
+void MmapFileSink::logRender(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) {
+    threadFormatter().format(msg, dest);
+    if (!write(dest.data(), dest.size()) && handedOff()) forwardRendered(msg, formatKey(), dest);
+}
+
+void MmapFileSink::logRendered(const spdlog::details::log_msg& msg, const spdlog::memory_buf_t& formatted) {
+    if (!write(formatted.data(), formatted.size()) && handedOff()) forwardRendered(msg, formatKey(), formatted);
+}
+
+bool MmapFileSink::write(const char* data, std::size_t n) {
+    if (n == 0) return true;
+    // 세그먼트보다 긴 레코드: 앞부분만 남기고 끝을 표시로 바꿔 기록(줄 경계 유지)
+    std::string cut;
+    if (n > max_size_) {
+        static const std::string kMarker = std::string(" [truncated]") + spdlog::details::os::default_eol;
+        const std::size_t keep = max_size_ > kMarker.size() ? max_size_ - kMarker.size() : 0;
+        cut.assign(data, keep);
+        cut.append(kMarker, 0, max_size_ - keep);
+        data = cut.data();
+        n = cut.size();
+    }
+
+    for (;;) {
+        std::uint64_t id;
+        {
+            std::shared_lock<std::shared_mutex> lk(rwMu_);
+            if (seg_.fd < 0) return false;  // 세그먼트 열기 실패(버림) 또는 인계 후(호출한 쪽이 전달)
+            bool done = false;
+            if (!seg_.base) {
+                done = writeDirect(data, n);   // 매핑 없는 세그먼트(디스크 부족 등)
+            } else {
+                std::size_t off = 0;
+                if (reserve(n, off)) {
+                    std::memcpy(seg_.base + off, data, n);
+                    done = true;
+                }
+            }
+            if (done) {
+                if (!cut.empty()) truncated_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            id = segId_;
+        }
+        // 공간 부족: 먼저 도착한 스레드 하나만 회전
+        std::unique_lock<std::shared_mutex> lk(rwMu_);
+        if (segId_ == id) rotate();
+    }
+}
+
+// 매핑 없이 연 세그먼트(디스크 부족 등): 직렬화한 pwrite. 실패하면 커서를 그대로 두어 다음 기록이 덮어씀.
+// false는 세그먼트가 가득 찬 경우뿐(기록 실패는 버리고 droppedCount()로 셈)
+bool MmapFileSink::writeDirect(const char* data, std::size_t n) {
+#ifdef J2_MMAP_SINK_POSIX
+    std::lock_guard<std::mutex> lk(directMu_);
+    const std::size_t cur = seg_.cursor.load(std::memory_order_relaxed);
+    if (cur + n > seg_.capacity) return false;
+    std::size_t done = 0;
+    while (done < n) {
+        const ssize_t r = ::pwrite(seg_.fd, data + done, n - done, static_cast<off_t>(cur + done));
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        done += static_cast<std::size_t>(r);
+    }
+    seg_.cursor.store(cur + n, std::memory_order_release);
+#else
+    (void)data;
+    (void)n;
+#endif
+    return true;
+}
+
+bool MmapFileSink::reserve(std::size_t n, std::size_t& offset) {
+    std::size_t cur = seg_.cursor.load(std::memory_order_relaxed);
+    do {
+        if (cur + n > seg_.capacity) return false;
+    } while (!seg_.cursor.compare_exchange_weak(cur, cur + n, std::memory_order_acq_rel,
+                                                 std::memory_order_relaxed));
+    offset = cur;
+    return true;
+}
+
+void MmapFileSink::flush() {
+    if (handedOff()) {
+        forwardFlush();
+        return;
+    }
+#ifdef J2_MMAP_SINK_POSIX
+    std::shared_lock<std::shared_mutex> lk(rwMu_);
+    if (seg_.base) {
+        ::msync(seg_.base, seg_.cursor.load(std::memory_order_acquire), MS_ASYNC);
+    }
+#endif
+}
+
+void MmapFileSink::sync() {
+    if (handedOff()) {
+        forwardSync();
+        return;
+    }
+#ifdef J2_MMAP_SINK_POSIX
+    std::shared_lock<std::shared_mutex> lk(rwMu_);
+    if (seg_.base) {
+        ::msync(seg_.base, seg_.cursor.load(std::memory_order_acquire), MS_SYNC);
+    } else if (seg_.fd >= 0) {
+        ::fdatasync(seg_.fd);
+    }
+#endif
+}
+
+// 진행 중인 복사를 기다려 세그먼트를 실제 길이로 정리(이 싱크가 아직 파일 소유자)한 뒤 새 싱크 생성.
+// 새 싱크가 같은 파일을 매핑한 뒤에는 이 싱크가 truncate 하지 않음
+spdlog::sink_ptr MmapFileSink::handOff(const std::function<spdlog::sink_ptr()>& make) {
+    std::unique_lock<std::shared_mutex> lk(rwMu_);
+    closeSegment();
+    ++segId_;
+    spdlog::sink_ptr next;
+    try {
+        next = make();
+    } catch (...) {
+        openSegment();
+        throw;
+    }
+    setSuccessor_(next);
+    return next;
+}
+
+void MmapFileSink::set_pattern(const std::string& pattern) {
+    set_formatter(spdlog::details::make_unique<spdlog::pattern_formatter>(pattern));
+}
+
+void MmapFileSink::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) {
+    std::lock_guard<std::mutex> lk(fmtMu_);
+    formatter_ = std::move(sink_formatter);
+    formatKey_.store(0, std::memory_order_relaxed);
+    fmtGen_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void MmapFileSink::setSharedFormatter(std::unique_ptr<spdlog::formatter> f, std::size_t key) {
+    std::lock_guard<std::mutex> lk(fmtMu_);
+    formatter_ = std::move(f);
+    formatKey_.store(key, std::memory_order_relaxed);
+    fmtGen_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+// 기존 파일이면 이어 쓰기: 비정상 종료로 남은 뒤쪽 0 바이트는 잘라내고 커서 위치 결정.
+// keep: 회전 이름 변경 실패로 가득 찬 파일을 그대로 이어 씀(한 세그먼트만큼 늘려 매핑)
+void MmapFileSink::openSegment(bool keep) {
+#ifdef J2_MMAP_SINK_POSIX
+    int fd = ::open(base_filename_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "[LoggerManager] mmap sink: open failed: " << base_filename_ << "\n";
+        return;
+    }
+
+    struct stat st {};
+    ::fstat(fd, &st);
+    std::size_t existing = static_cast<std::size_t>(st.st_size);
+    // 크기 비교 전에 정리해야 꽉 찬 것처럼 보이는 비정상 종료 세그먼트를 이어 씀
+    const std::size_t trimmed = trimmedLength(fd, existing);
+    if (trimmed < existing && ::ftruncate(fd, static_cast<off_t>(trimmed)) == 0) existing = trimmed;
+    if (!keep && existing >= max_size_ && worker_ && max_files_ > 0) {
+        // 이미 가득 찬 파일(일반 싱크에서 전환 등)은 바로 회전
+        std::string staged = RotationWorker::stagedName(base_filename_, stage_seq_++);
+        std::error_code ec;
+        std::filesystem::rename(base_filename_, staged, ec);
+        if (!ec) {
+            ::close(fd);
+            worker_->post({staged, base_filename_, max_files_, compress_});
+            fd = ::open(base_filename_.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) return;
+            existing = 0;
+        } else {
+            reportRenameFailure(ec);
+            keep = true;
+        }
+    } else if (!keep && existing > max_size_) {
+        ::ftruncate(fd, 0);
+        existing = 0;
+    }
+
+    const std::size_t cap = keep ? existing + max_size_ : max_size_;
+    seg_.fd = fd;
+    seg_.capacity = cap;
+    seg_.startSize.store(existing, std::memory_order_relaxed);
+    seg_.cursor.store(existing, std::memory_order_release);
+
+    // 공간을 확보하지 못한 채 매핑하면 디스크가 찼을 때 빈 페이지에 쓰는 순간 SIGBUS로 프로세스가 죽음.
+    // 파일 시스템이 미리 할당을 지원하지 않을 때(EOPNOTSUPP/EINVAL)만 sparse 매핑, 그 밖(ENOSPC 등)은 pwrite 경로
+    int rc = ::posix_fallocate(fd, 0, static_cast<off_t>(cap));
+    if (rc != 0) {
+        ::ftruncate(fd, static_cast<off_t>(existing));   // 일부만 할당되어 늘어난 길이 되돌림
+        if ((rc != EOPNOTSUPP && rc != EINVAL) || ::ftruncate(fd, static_cast<off_t>(cap)) != 0) {
+            std::cerr << "[LoggerManager] mmap sink: preallocation failed (" << std::strerror(rc)
+                      << "), writing without mmap: " << base_filename_ << "\n";
+            return;
+        }
+    }
+
+    void* p = ::mmap(nullptr, cap, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "[LoggerManager] mmap sink: mmap failed, writing without mmap: " << base_filename_ << "\n";
+        ::ftruncate(fd, static_cast<off_t>(existing));
+        return;
+    }
+    seg_.base = static_cast<char*>(p);
+#else
+    (void)keep;
+#endif
+}
+
+// 실제 기록 길이로 truncate 하여 미리 할당한 나머지 공간 반환
+void MmapFileSink::closeSegment() {
+#ifdef J2_MMAP_SINK_POSIX
+    if (seg_.fd < 0) return;
+    std::size_t used = seg_.cursor.load(std::memory_order_acquire);
+    closedBytes_.fetch_add(used - seg_.startSize.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    if (syncOnClose()) {   // DURABILITY=fdatasync: 매핑을 푸는 회전/handOff/소멸도 디스크까지
+        if (seg_.base) ::msync(seg_.base, used, MS_SYNC);
+        else           ::fdatasync(seg_.fd);
+    }
+    if (seg_.base) ::munmap(seg_.base, seg_.capacity);
+    ::ftruncate(seg_.fd, static_cast<off_t>(used));
+    ::close(seg_.fd);
+    seg_.base = nullptr;
+    seg_.fd = -1;
+    seg_.capacity = 0;
+    seg_.cursor.store(0, std::memory_order_relaxed);
+    seg_.startSize.store(0, std::memory_order_relaxed);
+#endif
+}
+
+std::uint64_t MmapFileSink::bytesWritten() const noexcept {
+    // 회전 중(커서 초기화 직전/직후) 읽으면 잠깐 어긋날 수 있음: 통계용 근사
+    std::size_t cur = seg_.cursor.load(std::memory_order_relaxed);
+    std::size_t start = seg_.startSize.load(std::memory_order_relaxed);
+    return closedBytes_.load(std::memory_order_relaxed) + (cur > start ? cur - start : 0);
+}
+
+void MmapFileSink::rotate() {
+    rotations_.fetch_add(1, std::memory_order_relaxed);
+    closeSegment();
+    ++segId_;
+
+    if (max_files_ == 0 || !worker_) {
+        std::error_code ec;
+        std::filesystem::resize_file(base_filename_, 0, ec);
+        openSegment();
+        return;
+    }
+
+    std::string staged = RotationWorker::stagedName(base_filename_, stage_seq_++);
+    std::error_code ec;
+    std::filesystem::rename(base_filename_, staged, ec);
+    if (ec) {
+        // 이름 변경 실패(잠금 등) 시 방금 닫은 세그먼트를 버리지 않고 이어 씀(다음 회전에서 다시 시도)
+        reportRenameFailure(ec);
+        openSegment(true);
+        return;
+    }
+    worker_->post({staged, base_filename_, max_files_, compress_});
+    openSegment();
+}
+
+void MmapFileSink::reportRenameFailure(const std::error_code& ec) {
+    if (renameWarned_) return;
+    renameWarned_ = true;
+    std::cerr << "[LoggerManager] mmap sink: rotate rename failed (" << ec.message()
+              << "), appending to " << base_filename_ << "\n";
+}
+
+} // namespace sinks
+} // namespace j2
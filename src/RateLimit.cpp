@@ -0,0 +1,27 @@
+#include "j2/RateLimit.hpp"
+
+namespace j2 {
+
+namespace {
+std::atomic<SiteLimiter*>& sitesHead() {
+    static std::atomic<SiteLimiter*> head{nullptr};
+    return head;
+}
+} // anonymous namespace
+
+// 함수 내 static 초기화는 지점당 한 번: 락 없는 목록 앞에 붙임
+SiteLimiter::SiteLimiter(const char* file, int line) : file_(file), line_(line) {
+    auto& head = sitesHead();
+    next_ = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(next_, this, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+std::uint64_t SiteLimiter::totalSuppressed() noexcept {
+    std::uint64_t n = 0;
+    for (SiteLimiter* s = sitesHead().load(std::memory_order_acquire); s; s = s->next_) {
+        n += s->suppressed();
+    }
+    return n;
+}
+
+} // namespace j2
@@ -0,0 +1,315 @@
+#include "j2/RotatingFileSink.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <spdlog/common.h>
+
+namespace j2 {
+namespace sinks {
+
+RotatingFileSink::RotatingFileSink(std::string base_filename,
+                                   std::size_t max_size,
+                                   std::size_t max_files,
+                                   std::shared_ptr<RotationWorker> worker,
+                                   RotateCompress compress,
+                                   RotatePolicy policy,
+                                   FileIoBackend io,
+                                   std::size_t index_block)
+    : base_filename_(std::move(base_filename))
+    , max_size_(max_size)
+    , max_files_(max_files)
+    , compress_(compress)
+    , policy_(policy)
+    , worker_(std::move(worker))
+    , file_(makeFileWriter(io)) {
+    if (max_size_ == 0 && policy_.interval.count() <= 0) {
+        spdlog::throw_spdlog_ex("rotating sink constructor: max_size arg cannot be zero");
+    }
+    if (index_block > 0) sidecar_ = std::make_unique<LogIndexWriter>(index_block);
+    if (policy_.naming == RotateNaming::index) {
+        openIndexed_();
+    } else {
+        openFile_(base_filename_, false);
+        if (worker_) worker_->recoverStaged(base_filename_, max_files_, compress_);
+    }
+    if (!sidecar_) {
+        // 색인을 끈 채 이어 쓰면 이전 실행의 색인이 내용과 어긋나므로 제거
+        std::error_code ec;
+        std::filesystem::remove(LogIndexWriter::pathFor(file_->filename()), ec);
+    }
+    armInterval_(spdlog::log_clock::now());
+}
+
+RotatingFileSink::~RotatingFileSink() {
+    try {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!handedOff()) closeFile_();
+    } catch (...) {
+    }
+}
+
+void RotatingFileSink::openFile_(const std::string& name, bool truncate) {
+    file_->open(name, truncate);
+    current_size_ = file_->size();
+    truncSeen_ = file_->truncations();
+    if (sidecar_) sidecar_->open(name, truncate, current_size_);
+}
+
+// DURABILITY=fdatasync면 닫기 전에 현재 fd로 동기화(io_uring: 마지막 기록에 링크한 FSYNC 완료 후 close).
+// 실패해도 닫기는 계속(회전 중이므로 예외를 올리지 않고 stderr에 알림)
+void RotatingFileSink::closeFile_() {
+    if (syncOnClose()) {
+        try {
+            file_->endSync(file_->beginSync());
+        } catch (const std::exception& e) {
+            std::cerr << "[LoggerManager] " << e.what() << " (before close)\n";
+        }
+    }
+    file_->close();
+    if (sidecar_) sidecar_->close();
+}
+
+// 이어 쓸 파일 결정: base 링크가 가장 큰 번호를 가리키면 그 파일에 이어 쓰고, 아니면 다음 번호로 시작.
+// 예전 shift 규칙에서 전환한 경우(base가 링크가 아님): 백업(all.N.log, 큰 N이 오래됨)과 일반 파일 base를
+// 오래된 순서로 번호를 붙여 편입(보존 개수 정리/압축은 아래 sweep이 처리)
+void RotatingFileSink::openIndexed_() {
+    namespace fs = std::filesystem;
+    auto found = RotationWorker::scanIndexed(base_filename_);
+    std::size_t last = found.empty() ? 0 : found.back().index;
+    bool resume = false;
+
+    auto adopt = [&](const std::string& from, const std::string& fromIdx, RotateCompress c) {
+        std::error_code rec;
+        std::string to = RotationWorker::indexedName(base_filename_, last + 1, c);
+        fs::rename(from, to, rec);
+        if (rec) return;
+        ++last;
+        fs::rename(fromIdx, LogIndexWriter::pathFor(RotationWorker::indexedName(base_filename_, last,
+                                                                                 RotateCompress::none)), rec);
+    };
+
+    std::error_code ec;
+    auto st = fs::symlink_status(base_filename_, ec);
+    if (!ec && fs::is_symlink(st)) {
+        auto target = fs::read_symlink(base_filename_, ec);
+        resume = !ec && last > 0 && found.back().compress == RotateCompress::none &&
+                 target.filename() == fs::path(found.back().path).filename();
+    } else {
+        auto shifted = RotationWorker::scanShifted(base_filename_);
+        for (auto it = shifted.rbegin(); it != shifted.rend(); ++it) {
+            adopt(it->path,
+                  LogIndexWriter::pathFor(RotationWorker::backupName(base_filename_, it->index, RotateCompress::none)),
+                  it->compress);
+        }
+        if (!ec && fs::is_regular_file(st)) {
+            adopt(base_filename_, LogIndexWriter::pathFor(base_filename_), RotateCompress::none);
+        }
+    }
+
+    index_ = resume ? last : last + 1;
+    openFile_(RotationWorker::indexedName(base_filename_, index_, RotateCompress::none), false);
+    updateLink_();
+    if (worker_) {
+        RotationWorker::Job job{"", base_filename_, max_files_, compress_};
+        job.naming = RotateNaming::index;
+        job.index = index_;
+        job.sweep = true;
+        worker_->post(std::move(job));
+    }
+}
+
+// base → 현재 파일(같은 디렉터리 상대 경로). 임시 링크를 만든 뒤 rename으로 원자적 교체
+void RotatingFileSink::updateLink_() {
+    namespace fs = std::filesystem;
+    const std::string tmp = base_filename_ + ".link";
+    const fs::path target = fs::path(file_->filename()).filename();
+    std::error_code ec;
+    fs::remove(tmp, ec);
+    fs::create_symlink(target, tmp, ec);
+    if (!ec) fs::rename(tmp, base_filename_, ec);
+    if (ec && !linkWarned_) {
+        linkWarned_ = true;
+        std::cerr << "[LoggerManager] rotate: cannot link " << base_filename_ << " -> " << target.string()
+                  << ": " << ec.message() << "\n";
+    }
+}
+
+// 다음 간격 경계(epoch 기준 = UTC 정각/자정 등)
+void RotatingFileSink::armInterval_(spdlog::log_clock::time_point now) {
+    const auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(policy_.interval).count();
+    if (interval <= 0) {
+        nextRotateNs_ = 0;
+        return;
+    }
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    nextRotateNs_ = (ns / interval + 1) * interval;
+}
+
+std::string RotatingFileSink::filename() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_->filename();
+}
+
+void RotatingFileSink::sink_it_(const spdlog::details::log_msg& msg) {
+    if (handedOff()) {
+        forward(msg);
+        return;
+    }
+    spdlog::memory_buf_t formatted;
+    base_sink<std::mutex>::formatter_->format(msg, formatted);
+    rotateIfNeeded_(formatted.size(), msg.time);
+    writeRecord_(msg, formatted);
+}
+
+void RotatingFileSink::setSharedFormatter(std::unique_ptr<spdlog::formatter> f, std::size_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    formatter_ = std::move(f);
+    formatKey_.store(key, std::memory_order_relaxed);
+}
+
+void RotatingFileSink::set_formatter_(std::unique_ptr<spdlog::formatter> sink_formatter) {
+    formatter_ = std::move(sink_formatter);
+    formatKey_.store(0, std::memory_order_relaxed);
+}
+
+void RotatingFileSink::logRender(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    formatter_->format(msg, dest);
+    if (handedOff()) {
+        forwardRendered(msg, formatKey(), dest);
+        return;
+    }
+    rotateIfNeeded_(dest.size(), msg.time);
+    writeRecord_(msg, dest);
+}
+
+void RotatingFileSink::logRendered(const spdlog::details::log_msg& msg, const spdlog::memory_buf_t& formatted) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (handedOff()) {
+        forwardRendered(msg, formatKey(), formatted);
+        return;
+    }
+    rotateIfNeeded_(formatted.size(), msg.time);
+    writeRecord_(msg, formatted);
+}
+
+void RotatingFileSink::rotateIfNeeded_(std::size_t incoming, spdlog::log_clock::time_point at) {
+    if (file_->truncations() != truncSeen_) followTruncate_();
+    if (nextRotateNs_ != 0) {
+        if (at == spdlog::log_clock::time_point{}) at = spdlog::log_clock::now();
+        if (std::chrono::duration_cast<std::chrono::nanoseconds>(at.time_since_epoch()).count() >= nextRotateNs_) {
+            armInterval_(at);
+            if (current_size_ > 0) {   // 빈 파일은 그대로 다음 간격에 사용
+                file_->flush();
+                rotate_();
+                return;
+            }
+        }
+    }
+    if (max_size_ > 0 && current_size_ + incoming > max_size_ && current_size_ > 0) {
+        file_->flush();
+        rotate_();
+    }
+}
+
+// 밖에서 잘린 파일을 기록기가 따라간 뒤: 회전 크기와 색인을 새 끝 기준으로(이전 offset의 색인은 버림)
+void RotatingFileSink::followTruncate_() {
+    truncSeen_ = file_->truncations();
+    current_size_ = file_->size();
+    if (sidecar_) sidecar_->open(file_->filename(), true, current_size_);
+}
+
+void RotatingFileSink::writeRaw_(const spdlog::memory_buf_t& buf) {
+    file_->write(buf);
+    current_size_ += buf.size();
+    bytes_.fetch_add(buf.size(), std::memory_order_relaxed);
+}
+
+void RotatingFileSink::writeRecord_(const spdlog::details::log_msg& msg, const spdlog::memory_buf_t& buf) {
+    const std::size_t offset = current_size_;
+    writeRaw_(buf);
+    if (sidecar_) sidecar_->note(offset, buf.size(), msg.time, msg.level);
+}
+
+void RotatingFileSink::flush_() {
+    if (handedOff()) {
+        forwardFlush();
+        return;
+    }
+    file_->flush();
+    if (sidecar_) sidecar_->flush();
+}
+
+void RotatingFileSink::sync() {
+    FileWriter::SyncTicket ticket;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (!handedOff()) ticket = file_->beginSync();
+    }
+    if (handedOff()) forwardSync();
+    else             file_->endSync(ticket);
+}
+
+// 남은 버퍼/진행 중인 기록을 끝내고 닫은 뒤(이 싱크가 아직 파일 소유자) 새 싱크 생성.
+// 이후 이 싱크로 들어오는 기록은 새 싱크로 전달(스냅샷 교체 전까지)
+spdlog::sink_ptr RotatingFileSink::handOff(const std::function<spdlog::sink_ptr()>& make) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::string current = file_->filename();
+    closeFile_();
+    spdlog::sink_ptr next;
+    try {
+        next = make();
+    } catch (...) {
+        openFile_(current, false);
+        throw;
+    }
+    setSuccessor_(next);
+    return next;
+}
+
+// 로깅 스레드 부담: close + rename 1회 + open(index 규칙: close + open + 링크 교체). 나머지는 worker로 넘김
+void RotatingFileSink::rotate_() {
+    rotations_.fetch_add(1, std::memory_order_relaxed);
+    if (policy_.naming == RotateNaming::index) {
+        closeFile_();
+        const std::size_t closed = index_++;
+        openFile_(RotationWorker::indexedName(base_filename_, index_, RotateCompress::none), true);
+        updateLink_();
+        if (worker_) {
+            RotationWorker::Job job{RotationWorker::indexedName(base_filename_, closed, RotateCompress::none),
+                                    base_filename_, max_files_, compress_};
+            job.naming = RotateNaming::index;
+            job.index = closed;
+            worker_->post(std::move(job));
+        }
+        onFileOpened_();
+        return;
+    }
+    if (max_files_ == 0 || !worker_) {
+        closeFile_();
+        openFile_(base_filename_, true);
+        onFileOpened_();
+        return;
+    }
+
+    closeFile_();
+    std::string staged = RotationWorker::stagedName(base_filename_, stage_seq_++);
+    std::error_code ec;
+    std::filesystem::rename(base_filename_, staged, ec);
+    if (ec) {
+        // 이름 변경 실패(잠금 등) 시 기존 파일에 계속 기록
+        openFile_(base_filename_, false);
+        return;
+    }
+    if (sidecar_) {
+        // 색인도 staged 이름으로(작업자가 백업 번호와 함께 옮김)
+        std::filesystem::rename(LogIndexWriter::pathFor(base_filename_), LogIndexWriter::pathFor(staged), ec);
+    }
+    openFile_(base_filename_, true);
+
+    worker_->post({staged, base_filename_, max_files_, compress_});
+    onFileOpened_();
+}
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,340 @@
+#include "j2/RotationWorker.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <spdlog/details/file_helper.h>
+#include "j2/LogIndex.hpp"
+
+#ifdef J2_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef J2_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace j2 {
+namespace sinks {
+
+namespace {
+const char* kStagedTag = ".rotating.";
+
+constexpr RotateCompress kAllVariants[] = {
+    RotateCompress::none, RotateCompress::gzip, RotateCompress::zstd};
+
+const char* compressExt(RotateCompress c) {
+    switch (c) {
+    case RotateCompress::gzip: return ".gz";
+    case RotateCompress::zstd: return ".zst";
+    case RotateCompress::none:
+    default:                   return "";
+    }
+}
+
+bool exists(const std::string& p) {
+    std::error_code ec;
+    return std::filesystem::exists(p, ec);
+}
+
+bool removeFile(const std::string& p) {
+    std::error_code ec;
+    return std::filesystem::remove(p, ec);
+}
+
+bool renameFile(const std::string& from, const std::string& to) {
+    std::error_code ec;
+    std::filesystem::rename(from, to, ec);
+    return !ec;
+}
+
+// FILE_INDEX 사이드카(all.1.log.idx): 압축 여부와 무관하게 로그 파일 하나에 하나, 파일과 함께 이동/삭제
+std::string sidecar(const std::string& logPath) {
+    return LogIndexWriter::pathFor(logPath);
+}
+
+bool isSidecar(const std::string& name) {
+    return name.size() > 4 && name.compare(name.size() - 4, 4, ".idx") == 0;
+}
+
+// base 디렉터리에서 "stem.<번호><ext>[.gz|.zst]" 중 nameOf(번호, 압축)와 이름이 정확히 같은 파일, 번호 순
+// (all.1.log와 all.000001.log처럼 두 규칙의 자릿수가 달라 서로 섞이지 않음)
+template <typename NameOf>
+std::vector<RotationWorker::IndexedFile> scanNumbered(const std::string& base, NameOf nameOf) {
+    spdlog::filename_t stem, ext;
+    std::tie(stem, ext) = spdlog::details::file_helper::split_by_extension(base);
+    std::filesystem::path sp(stem);
+    std::filesystem::path dir = sp.has_parent_path() ? sp.parent_path() : std::filesystem::path(".");
+    const std::string prefix = sp.filename().string() + ".";
+
+    std::vector<RotationWorker::IndexedFile> out;
+    std::error_code ec;
+    for (const auto& e : std::filesystem::directory_iterator(dir, ec)) {
+        std::string name = e.path().filename().string();
+        if (name.compare(0, prefix.size(), prefix) != 0) continue;
+        std::size_t pos = prefix.size(), end = pos;
+        while (end < name.size() && std::isdigit(static_cast<unsigned char>(name[end]))) ++end;
+        if (end == pos || end - pos > 18) continue;
+        const auto index = static_cast<std::size_t>(std::stoull(name.substr(pos, end - pos)));
+        for (auto c : kAllVariants) {
+            if (std::filesystem::path(nameOf(index, c)).filename().string() == name) {
+                out.push_back({index, c, e.path().string()});
+                break;
+            }
+        }
+    }
+    std::sort(out.begin(), out.end(),
+              [](const RotationWorker::IndexedFile& a, const RotationWorker::IndexedFile& b) { return a.index < b.index; });
+    return out;
+}
+} // anonymous namespace
+
+RotationWorker::RotationWorker() : thread_([this]() { run(); }) {}
+
+RotationWorker::~RotationWorker() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void RotationWorker::post(Job job) {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        queue_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+}
+
+void RotationWorker::drain() {
+    std::unique_lock<std::mutex> lk(mu_);
+    idleCv_.wait(lk, [this]() { return queue_.empty() && !busy_; });
+}
+
+void RotationWorker::run() {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+        cv_.wait(lk, [this]() { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) break;  // stop_ && 큐 비었음
+
+        Job job = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+        lk.unlock();
+        try {
+            process(job);
+        } catch (...) {
+        }
+        lk.lock();
+        busy_ = false;
+        if (queue_.empty()) idleCv_.notify_all();
+    }
+    idleCv_.notify_all();
+}
+
+// 1) 보존 개수를 넘는 백업 삭제  2) 백업 번호 밀기  3) staged → .1  4) 선택적 압축
+void RotationWorker::process(const Job& job) {
+    if (job.naming == RotateNaming::index) {
+        processIndexed(job);
+        return;
+    }
+    if (job.maxFiles == 0) {
+        removeFile(job.staged);
+        removeFile(sidecar(job.staged));
+        return;
+    }
+
+    for (std::size_t i = job.maxFiles;; ++i) {
+        bool any = false;
+        for (auto c : kAllVariants) any |= removeFile(backupName(job.base, i, c));
+        any |= removeFile(sidecar(backupName(job.base, i, RotateCompress::none)));
+        if (!any) break;
+    }
+
+    for (std::size_t i = job.maxFiles - 1; i >= 1; --i) {
+        for (auto c : kAllVariants) {
+            std::string src = backupName(job.base, i, c);
+            if (exists(src)) renameFile(src, backupName(job.base, i + 1, c));
+        }
+        std::string idx = sidecar(backupName(job.base, i, RotateCompress::none));
+        if (exists(idx)) renameFile(idx, sidecar(backupName(job.base, i + 1, RotateCompress::none)));
+    }
+
+    std::string first = backupName(job.base, 1, RotateCompress::none);
+    if (!renameFile(job.staged, first)) {
+        std::cerr << "[LoggerManager] rotate: failed to rename " << job.staged << " -> " << first << "\n";
+        return;
+    }
+    if (exists(sidecar(job.staged))) renameFile(sidecar(job.staged), sidecar(first));
+
+    if (job.compress != RotateCompress::none) {
+        std::string packed = backupName(job.base, 1, job.compress);
+        if (compressFile(first, packed, job.compress)) {
+            removeFile(first);
+        } else {
+            removeFile(packed);
+        }
+    }
+}
+
+// index 규칙: 닫힌 파일 압축 + (보존 개수 밖으로 밀려난) 가장 오래된 번호 1개 삭제
+void RotationWorker::processIndexed(const Job& job) {
+    if (job.sweep) {
+        // 현재 파일(job.index) 앞의 닫힌 파일 중 최근 maxFiles개만 남김
+        for (const auto& f : scanIndexed(job.base)) {
+            if (f.index >= job.index) continue;
+            if (f.index + job.maxFiles < job.index) {
+                removeFile(f.path);
+                removeFile(sidecar(f.path));
+            } else if (f.compress == RotateCompress::none && job.compress != RotateCompress::none) {
+                std::string packed = indexedName(job.base, f.index, job.compress);
+                if (compressFile(f.path, packed, job.compress)) removeFile(f.path);
+                else removeFile(packed);
+            }
+        }
+        return;
+    }
+
+    if (job.maxFiles == 0) {
+        removeFile(job.staged);
+        removeFile(sidecar(job.staged));
+        return;
+    }
+    if (job.compress != RotateCompress::none) {
+        std::string packed = indexedName(job.base, job.index, job.compress);
+        if (compressFile(job.staged, packed, job.compress)) removeFile(job.staged);
+        else removeFile(packed);
+    }
+    if (job.index > job.maxFiles) {
+        for (auto c : kAllVariants) removeFile(indexedName(job.base, job.index - job.maxFiles, c));
+        removeFile(sidecar(indexedName(job.base, job.index - job.maxFiles, RotateCompress::none)));
+    }
+}
+
+void RotationWorker::recoverStaged(const std::string& base, std::size_t maxFiles, RotateCompress compress) {
+    std::filesystem::path bp(base);
+    std::filesystem::path dir = bp.has_parent_path() ? bp.parent_path() : std::filesystem::path(".");
+    std::string prefix = bp.filename().string() + kStagedTag;
+
+    std::vector<std::string> found;
+    std::error_code ec;
+    for (const auto& e : std::filesystem::directory_iterator(dir, ec)) {
+        std::string name = e.path().filename().string();
+        if (name.compare(0, prefix.size(), prefix) == 0 && !isSidecar(name)) {
+            found.push_back(e.path().string());
+        }
+    }
+    std::sort(found.begin(), found.end());
+    for (auto& f : found) {
+        post({f, base, maxFiles, compress});
+    }
+}
+
+std::string RotationWorker::stagedName(const std::string& base, std::size_t seq) {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%020lld.%06zu", static_cast<long long>(ns), seq % 1000000);
+    return base + kStagedTag + buf;
+}
+
+std::string RotationWorker::backupName(const std::string& base, std::size_t index, RotateCompress c) {
+    spdlog::filename_t stem, ext;
+    std::tie(stem, ext) = spdlog::details::file_helper::split_by_extension(base);
+    return stem + "." + std::to_string(index) + ext + compressExt(c);
+}
+
+std::string RotationWorker::indexedName(const std::string& base, std::size_t index, RotateCompress c) {
+    spdlog::filename_t stem, ext;
+    std::tie(stem, ext) = spdlog::details::file_helper::split_by_extension(base);
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), ".%06zu", index);
+    return stem + buf + ext + compressExt(c);
+}
+
+std::vector<RotationWorker::IndexedFile> RotationWorker::scanIndexed(const std::string& base) {
+    return scanNumbered(base, [&](std::size_t i, RotateCompress c) { return indexedName(base, i, c); });
+}
+
+// 6자리 이상 번호(all.123456.log)는 index 규칙 이름과 겹치므로 index 쪽으로 봄
+std::vector<RotationWorker::IndexedFile> RotationWorker::scanShifted(const std::string& base) {
+    auto out = scanNumbered(base, [&](std::size_t i, RotateCompress c) { return backupName(base, i, c); });
+    out.erase(std::remove_if(out.begin(), out.end(), [](const IndexedFile& f) { return f.index >= 100000; }),
+              out.end());
+    return out;
+}
+
+bool RotationWorker::compressionAvailable(RotateCompress c) {
+    switch (c) {
+    case RotateCompress::none: return true;
+#ifdef J2_HAVE_ZLIB
+    case RotateCompress::gzip: return true;
+#endif
+#ifdef J2_HAVE_ZSTD
+    case RotateCompress::zstd: return true;
+#endif
+    default: return false;
+    }
+}
+
+bool RotationWorker::compressFile(const std::string& src, const std::string& dst, RotateCompress c) {
+    std::ifstream in(src, std::ios::binary);
+    if (!in) return false;
+    std::vector<char> buf(256 * 1024);
+
+    switch (c) {
+#ifdef J2_HAVE_ZLIB
+    case RotateCompress::gzip: {
+        gzFile gz = gzopen(dst.c_str(), "wb6");
+        if (!gz) return false;
+        bool ok = true;
+        while (ok && in) {
+            in.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+            auto n = static_cast<unsigned>(in.gcount());
+            if (n > 0 && gzwrite(gz, buf.data(), n) != static_cast<int>(n)) ok = false;
+        }
+        return (gzclose(gz) == Z_OK) && ok;
+    }
+#endif
+#ifdef J2_HAVE_ZSTD
+    case RotateCompress::zstd: {
+        std::FILE* out = std::fopen(dst.c_str(), "wb");
+        if (!out) return false;
+        ZSTD_CCtx* cctx = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, 3);
+        std::vector<char> obuf(ZSTD_CStreamOutSize());
+        bool ok = true;
+        bool last = false;
+        while (ok && !last) {
+            in.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+            std::size_t n = static_cast<std::size_t>(in.gcount());
+            last = !in;
+            ZSTD_inBuffer ib{buf.data(), n, 0};
+            ZSTD_EndDirective mode = last ? ZSTD_e_end : ZSTD_e_continue;
+            bool done = false;
+            while (!done) {
+                ZSTD_outBuffer ob{obuf.data(), obuf.size(), 0};
+                std::size_t rem = ZSTD_compressStream2(cctx, &ob, &ib, mode);
+                if (ZSTD_isError(rem)) { ok = false; break; }
+                if (std::fwrite(obuf.data(), 1, ob.pos, out) != ob.pos) { ok = false; break; }
+                done = last ? (rem == 0) : (ib.pos == ib.size);
+            }
+        }
+        ZSTD_freeCCtx(cctx);
+        return (std::fclose(out) == 0) && ok;
+    }
+#endif
+    default:
+        (void)dst;
+        return false;
+    }
+}
+
+} // namespace sinks
+} // namespace j2
@@ -0,0 +1,383 @@
+#include "j2/ShmRing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define J2_SHM_RING_POSIX 1
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace j2 {
+
+namespace {
+constexpr char kMagic[8] = {'J', '2', 'S', 'H', 'M', 'R', 'G', '\0'};
+constexpr std::uint32_t kVersion = 2;
+constexpr std::uint8_t kTruncated = 1;
+// 포기했지만 생산자가 아직 쓰고 있을 수 있는 슬롯: seq = 예약 위치 | kPoisoned
+// (생산자는 "가득 참"으로 처리해 다음 바퀴 예약을 막음)
+constexpr std::uint64_t kPoisoned = 1ull << 63;
+// 사망 확인이 안 되는 poisoned 슬롯을 강제로 풀기까지(stall 배수)
+constexpr int kPoisonReleaseFactor = 30;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shm ring needs lock-free 64-bit atomics");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shm ring needs lock-free 32-bit atomics");
+
+std::size_t roundPow2(std::size_t v) {
+    std::size_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+#ifdef J2_SHM_RING_POSIX
+// 같은 pid 네임스페이스 안에서만 의미 있음(호출 쪽에서 네임스페이스 id 비교)
+bool processAlive(std::uint32_t pid) {
+    return pid != 0 && (::kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH);
+}
+
+std::uint32_t pidNamespaceId() {
+#if defined(__linux__)
+    struct stat st {};
+    if (::stat("/proc/self/ns/pid", &st) == 0) return static_cast<std::uint32_t>(st.st_ino);
+#endif
+    return 0;
+}
+#endif
+} // anonymous namespace
+
+// 세그먼트 레이아웃: [SegHeader (캐시 줄 정렬)][슬롯 × slots]
+struct ShmRing::SegHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t slotBytes;
+    std::uint64_t slots;
+    std::atomic<std::uint32_t> ready;
+    std::atomic<std::uint32_t> consumer;           // 소비자 pid(0: 없음)
+    alignas(64) std::atomic<std::uint64_t> head;    // 생산자 예약 위치
+    alignas(64) std::atomic<std::uint64_t> tail;    // 소비 위치
+    std::atomic<std::uint64_t> dropped;
+    std::atomic<std::uint64_t> abandoned;
+};
+
+// 슬롯: seq == pos 이면 pos 차례 생산자가 쓸 수 있음, pos + 1 이면 게시됨, pos | kPoisoned 이면 포기됨
+struct ShmRing::SlotHeader {
+    std::atomic<std::uint64_t> seq;
+    std::atomic<std::uint32_t> owner;   // 예약한 생산자 pid(0: 모름)
+    std::atomic<std::uint32_t> ownerNs; // 예약한 생산자의 pid 네임스페이스 id
+    std::uint32_t pid;
+    std::int64_t ns;
+    std::uint64_t tid;
+    std::uint32_t payloadLen;
+    std::uint16_t nameLen;
+    std::uint8_t level;
+    std::uint8_t flags;
+};
+
+namespace {
+constexpr std::size_t kHeaderBytes = 256;   // SegHeader 자리(캐시 줄 배수, 여유 포함)
+} // anonymous namespace
+
+ShmRing::~ShmRing() { close(); }
+
+bool ShmRing::supported() {
+#ifdef J2_SHM_RING_POSIX
+    return true;
+#else
+    return false;
+#endif
+}
+
+ShmRing::SegHeader* ShmRing::header() const { return static_cast<SegHeader*>(base_); }
+
+ShmRing::SlotHeader* ShmRing::slotAt(std::uint64_t pos) const {
+    auto* p = static_cast<char*>(base_) + kHeaderBytes + (pos & (slots_ - 1)) * slotBytes_;
+    return reinterpret_cast<SlotHeader*>(p);
+}
+
+bool ShmRing::open(const Options& opt) {
+    close();
+#ifdef J2_SHM_RING_POSIX
+    static_assert(sizeof(SegHeader) <= kHeaderBytes, "SegHeader does not fit");
+    stall_ = opt.stall;
+    pid_ = static_cast<std::uint32_t>(::getpid());
+    pidNs_ = pidNamespaceId();
+
+    int fd = ::shm_open(opt.name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    bool created = fd >= 0;
+    if (!created) {
+        if (errno != EEXIST) {
+            error_ = std::string("shm_open failed: ") + std::strerror(errno);
+            return false;
+        }
+        fd = ::shm_open(opt.name.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            error_ = std::string("shm_open failed: ") + std::strerror(errno);
+            return false;
+        }
+    }
+
+    std::size_t slotBytes = 0, slots = 0;
+    if (created) {
+        slotBytes = (std::max(opt.slotBytes, sizeof(SlotHeader) + 64) + 63) / 64 * 64;
+        slots = roundPow2(std::max<std::size_t>(opt.slots, 2));
+        if (::ftruncate(fd, static_cast<off_t>(kHeaderBytes + slots * slotBytes)) != 0) {
+            error_ = std::string("ftruncate failed: ") + std::strerror(errno);
+            ::close(fd);
+            ::shm_unlink(opt.name.c_str());
+            return false;
+        }
+    } else {
+        // 다른 프로세스가 만드는 중이면 초기화가 끝날 때까지 잠시 대기
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        for (;;) {
+            struct stat st {};
+            if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= kHeaderBytes) {
+                void* h = ::mmap(nullptr, kHeaderBytes, PROT_READ, MAP_SHARED, fd, 0);
+                if (h != MAP_FAILED) {
+                    auto* sh = static_cast<SegHeader*>(h);
+                    bool ok = sh->ready.load(std::memory_order_acquire) == 1;
+                    bool magic = std::memcmp(sh->magic, kMagic, sizeof(kMagic)) == 0 && sh->version == kVersion;
+                    slotBytes = sh->slotBytes;
+                    slots = sh->slots;
+                    ::munmap(h, kHeaderBytes);
+                    if (ok && !magic) {
+                        error_ = "shm segment has an unknown layout";
+                        ::close(fd);
+                        return false;
+                    }
+                    if (ok) break;
+                }
+            }
+            if (std::chrono::steady_clock::now() > deadline) {
+                error_ = "shm segment was not initialised in time";
+                ::close(fd);
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+    const std::size_t size = kHeaderBytes + slots * slotBytes;
+    void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        error_ = std::string("mmap failed: ") + std::strerror(errno);
+        return false;
+    }
+    base_ = p;
+    mapped_ = size;
+    slots_ = slots;
+    slotBytes_ = slotBytes;
+
+    if (created) {
+        auto* h = new (base_) SegHeader{};
+        std::memcpy(h->magic, kMagic, sizeof(kMagic));
+        h->version = kVersion;
+        h->slotBytes = static_cast<std::uint32_t>(slotBytes_);
+        h->slots = slots_;
+        for (std::size_t i = 0; i < slots_; ++i) {
+            auto* s = new (slotAt(i)) SlotHeader{};
+            s->seq.store(i, std::memory_order_relaxed);
+        }
+        h->ready.store(1, std::memory_order_release);
+    }
+    return true;
+#else
+    (void)opt;
+    error_ = "shared memory transport is not supported on this platform";
+    return false;
+#endif
+}
+
+void ShmRing::close() {
+#ifdef J2_SHM_RING_POSIX
+    if (base_) {
+        std::uint32_t self = pid_;
+        header()->consumer.compare_exchange_strong(self, 0, std::memory_order_acq_rel);
+        ::munmap(base_, mapped_);
+    }
+#endif
+    base_ = nullptr;
+    mapped_ = 0;
+}
+
+bool ShmRing::unlink(const std::string& name) {
+#ifdef J2_SHM_RING_POSIX
+    return ::shm_unlink(name.c_str()) == 0;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+bool ShmRing::push(spdlog::level::level_enum level, std::int64_t ns, std::uint64_t tid,
+                   std::string_view logger, std::string_view payload) {
+    if (!base_) return false;
+    SegHeader* h = header();
+
+    std::uint64_t pos = h->head.load(std::memory_order_relaxed);
+    SlotHeader* s = nullptr;
+    for (;;) {
+        s = slotAt(pos);
+        std::uint64_t seq = s->seq.load(std::memory_order_acquire);
+        auto diff = static_cast<std::int64_t>(seq - pos);
+        if (seq & kPoisoned) diff = -1;   // 지난 바퀴의 포기된 슬롯이 아직 안 풀림: 가득 찬 것과 같음
+        if (diff == 0) {
+            if (h->head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            h->dropped.fetch_add(1, std::memory_order_relaxed);   // 가득 참
+            return false;
+        } else {
+            pos = h->head.load(std::memory_order_relaxed);
+        }
+    }
+    s->owner.store(pid_, std::memory_order_relaxed);
+    s->ownerNs.store(pidNs_, std::memory_order_relaxed);
+
+    const std::size_t room = slotBytes_ - sizeof(SlotHeader);
+    const std::size_t nameLen = std::min<std::size_t>(logger.size(), std::min<std::size_t>(room / 4, 0xFFFF));
+    const std::size_t payloadLen = std::min(payload.size(), room - nameLen);
+    char* body = reinterpret_cast<char*>(s) + sizeof(SlotHeader);
+    std::memcpy(body, logger.data(), nameLen);
+    std::memcpy(body + nameLen, payload.data(), payloadLen);
+    s->pid = pid_;
+    s->ns = ns;
+    s->tid = tid;
+    s->nameLen = static_cast<std::uint16_t>(nameLen);
+    s->payloadLen = static_cast<std::uint32_t>(payloadLen);
+    s->level = static_cast<std::uint8_t>(level);
+    s->flags = payloadLen < payload.size() ? kTruncated : 0;
+
+    // 수집기가 이미 포기한 슬롯이면 게시하지 않고, 복사를 끝냈으니 다음 바퀴용으로 풀어 줌
+    std::uint64_t expected = pos;
+    if (s->seq.compare_exchange_strong(expected, pos + 1, std::memory_order_release, std::memory_order_relaxed)) {
+        return true;
+    }
+    if (expected == (pos | kPoisoned)) {
+        s->owner.store(0, std::memory_order_relaxed);
+        s->seq.compare_exchange_strong(expected, pos + slots_, std::memory_order_release, std::memory_order_relaxed);
+    }
+    return false;
+}
+
+// 예약한 생산자가 죽은 것이 확실할 때만 true(다른 pid 네임스페이스/모르는 pid는 살아 있다고 봄)
+bool ShmRing::ownerDead(const SlotHeader* s) const {
+#ifdef J2_SHM_RING_POSIX
+    const std::uint32_t owner = s->owner.load(std::memory_order_relaxed);
+    return owner != 0 && s->ownerNs.load(std::memory_order_relaxed) == pidNs_ && !processAlive(owner);
+#else
+    (void)s;
+    return false;
+#endif
+}
+
+bool ShmRing::attachConsumer() {
+    if (!base_) return false;
+#ifdef J2_SHM_RING_POSIX
+    auto& c = header()->consumer;
+    std::uint32_t cur = c.load(std::memory_order_acquire);
+    for (;;) {
+        if (cur == pid_) return true;
+        if (cur != 0 && processAlive(cur)) {
+            error_ = "another collector (pid " + std::to_string(cur) + ") is attached";
+            return false;
+        }
+        if (c.compare_exchange_weak(cur, pid_, std::memory_order_acq_rel)) return true;
+    }
+#else
+    return false;
+#endif
+}
+
+std::size_t ShmRing::poll(const std::function<void(const Record&)>& fn, std::size_t max) {
+    if (!base_) return 0;
+    SegHeader* h = header();
+    std::uint64_t pos = h->tail.load(std::memory_order_relaxed);
+    const std::size_t room = slotBytes_ - sizeof(SlotHeader);
+    std::size_t n = 0;
+
+    while (n < max) {
+        SlotHeader* s = slotAt(pos);
+        std::uint64_t seq = s->seq.load(std::memory_order_acquire);
+        if (seq == pos + 1) {
+            Record r;
+            r.ns = s->ns;
+            r.tid = s->tid;
+            r.pid = s->pid;
+            r.level = static_cast<spdlog::level::level_enum>(std::min<std::uint8_t>(s->level, spdlog::level::off));
+            r.truncated = (s->flags & kTruncated) != 0;
+            // 늦게 쓴 생산자와 겹친 경우에도 슬롯 밖을 읽지 않도록 길이 제한
+            const char* body = reinterpret_cast<const char*>(s) + sizeof(SlotHeader);
+            std::size_t nameLen = std::min<std::size_t>(s->nameLen, room);
+            std::size_t payloadLen = std::min<std::size_t>(s->payloadLen, room - nameLen);
+            r.logger = std::string_view(body, nameLen);
+            r.payload = std::string_view(body + nameLen, payloadLen);
+            fn(r);
+
+            s->owner.store(0, std::memory_order_relaxed);
+            s->seq.store(pos + slots_, std::memory_order_release);
+            h->tail.store(++pos, std::memory_order_release);
+            ++n;
+            continue;
+        }
+
+        // 예약됐지만 아직 게시되지 않은 슬롯: 생산자가 죽었으면 바로 재사용, 너무 오래 걸리면 poisoned로 건너뜀
+        if (seq == pos && h->head.load(std::memory_order_acquire) > pos) {
+            auto now = std::chrono::steady_clock::now();
+            if (stallPos_ != pos) {
+                stallPos_ = pos;
+                stallSince_ = now;
+            }
+            const bool dead = ownerDead(s);
+            if (dead || now - stallSince_ >= stall_) {
+                // 살아 있을 수 있는 생산자가 아직 복사 중이면 슬롯을 넘겨주지 않음(늦은 게시가 풀어 줌)
+                std::uint64_t expected = pos;
+                const std::uint64_t next = dead ? pos + slots_ : (pos | kPoisoned);
+                if (s->seq.compare_exchange_strong(expected, next, std::memory_order_acq_rel)) {
+                    if (dead) s->owner.store(0, std::memory_order_relaxed);
+                    h->abandoned.fetch_add(1, std::memory_order_relaxed);
+                    h->tail.store(++pos, std::memory_order_release);
+                }
+                continue;   // 방금 게시됐으면 다시 읽음
+            }
+        }
+
+        // 지난 바퀴에 poisoned로 남은 슬롯: 생산자가 풀어 주기 전에 죽었으면(또는 너무 오래면) 여기서 풂.
+        // 생산자는 이 슬롯을 "가득 참"으로 보므로 head가 pos를 넘지 않음
+        const std::uint64_t prev = pos - slots_;
+        if (seq == (prev | kPoisoned)) {
+            auto now = std::chrono::steady_clock::now();
+            if (stallPos_ != pos) {
+                stallPos_ = pos;
+                stallSince_ = now;
+            }
+            if (ownerDead(s) || now - stallSince_ >= stall_ * kPoisonReleaseFactor) {
+                std::uint64_t expected = seq;
+                if (s->seq.compare_exchange_strong(expected, pos, std::memory_order_acq_rel)) {
+                    s->owner.store(0, std::memory_order_relaxed);
+                }
+                continue;
+            }
+        }
+        break;
+    }
+    return n;
+}
+
+std::uint64_t ShmRing::dropped() const {
+    return base_ ? header()->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+std::uint64_t ShmRing::abandoned() const {
+    return base_ ? header()->abandoned.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace j2
@@ -0,0 +1,25 @@
+#include "j2/ShmSink.hpp"
+
+#include <chrono>
+
+namespace j2 {
+namespace sinks {
+
+ShmSink::ShmSink(std::shared_ptr<ShmRing> ring) : ring_(std::move(ring)) {
+    set_level(spdlog::level::trace);
+}
+
+void ShmSink::log(const spdlog::details::log_msg& msg) {
+    if (!should_log(msg.level)) return;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+    std::string_view name(msg.logger_name.data(), msg.logger_name.size());
+    std::string_view payload(msg.payload.data(), msg.payload.size());
+    if (ring_->push(msg.level, ns, msg.thread_id, name, payload)) {
+        bytes_.fetch_add(payload.size(), std::memory_order_relaxed);
+    } else {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace sinks
+} // namespace j2
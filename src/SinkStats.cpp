@@ -0,0 +1,121 @@
+#include "j2/SinkStats.hpp"
+
+#include <algorithm>
+
+namespace j2 {
+
+namespace {
+std::size_t bucketOf(std::uint64_t ns) {
+    std::size_t b = 0;
+    while (ns > 1 && b + 1 < LatencyHistogram::kBuckets) {
+        ns >>= 1;
+        ++b;
+    }
+    return b;
+}
+
+void storeMax(std::atomic<std::uint64_t>& m, std::uint64_t v) {
+    std::uint64_t cur = m.load(std::memory_order_relaxed);
+    while (v > cur && !m.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+} // anonymous namespace
+
+std::uint64_t LatencyHistogram::percentileNs(double q) const {
+    if (count == 0) return 0;
+    auto target = static_cast<std::uint64_t>(q * static_cast<double>(count) + 0.5);
+    if (target == 0) target = 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets[i];
+        if (seen >= target) return std::min<std::uint64_t>(std::uint64_t(1) << (i + 1), maxNs ? maxNs : ~0ull);
+    }
+    return maxNs;
+}
+
+LatencyHistogram LatencyHistogram::since(const LatencyHistogram& earlier) const {
+    LatencyHistogram d;
+    for (std::size_t i = 0; i < kBuckets; ++i) d.buckets[i] = buckets[i] - earlier.buckets[i];
+    d.count = count - earlier.count;
+    d.sumNs = sumNs - earlier.sumNs;
+    d.maxNs = intervalMaxNs;
+    d.intervalMaxNs = intervalMaxNs;
+    return d;
+}
+
+// 스레드마다 고정 샤드(SnapshotDistSink 읽기 카운터와 같은 방식)
+unsigned SinkStats::shardIndex() noexcept {
+    static std::atomic<unsigned> next{0};
+    thread_local unsigned idx = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return idx;
+}
+
+void SinkStats::onFiltered() noexcept {
+    shards_[shardIndex()].filtered.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SinkStats::onWrite(std::uint64_t ns) noexcept {
+    Shard& s = shards_[shardIndex()];
+    s.messages.fetch_add(1, std::memory_order_relaxed);
+    s.writeSum.fetch_add(ns, std::memory_order_relaxed);
+    s.writeHist[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    storeMax(s.writeMax, ns);
+    storeMax(s.writeIntervalMax, ns);
+}
+
+void SinkStats::onFlush(std::uint64_t ns) noexcept {
+    Shard& s = shards_[shardIndex()];
+    s.flushCount.fetch_add(1, std::memory_order_relaxed);
+    s.flushSum.fetch_add(ns, std::memory_order_relaxed);
+    s.flushHist[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    storeMax(s.flushMax, ns);
+    storeMax(s.flushIntervalMax, ns);
+}
+
+void SinkStats::absorb(const SinkCounters* retired) noexcept {
+    if (!retired) return;
+    carriedBytes_.fetch_add(retired->bytesWritten(), std::memory_order_relaxed);
+    carriedRotations_.fetch_add(retired->rotationCount(), std::memory_order_relaxed);
+    carriedDropped_.fetch_add(retired->droppedCount(), std::memory_order_relaxed);
+    carriedTruncated_.fetch_add(retired->truncatedCount(), std::memory_order_relaxed);
+    carriedDirect_.fetch_add(retired->directMessages(), std::memory_order_relaxed);
+}
+
+SinkStatsSnapshot SinkStats::snapshot(const SinkCounters* current, bool endInterval) const {
+    SinkStatsSnapshot out;
+    out.name = name_;
+    auto intervalMax = [endInterval](std::atomic<std::uint64_t>& m) {
+        return endInterval ? m.exchange(0, std::memory_order_relaxed) : m.load(std::memory_order_relaxed);
+    };
+    for (auto& s : shards_) {
+        out.messages += s.messages.load(std::memory_order_relaxed);
+        out.filtered += s.filtered.load(std::memory_order_relaxed);
+        out.write.sumNs += s.writeSum.load(std::memory_order_relaxed);
+        out.write.maxNs = std::max(out.write.maxNs, s.writeMax.load(std::memory_order_relaxed));
+        out.write.intervalMaxNs = std::max(out.write.intervalMaxNs, intervalMax(s.writeIntervalMax));
+        out.flush.count += s.flushCount.load(std::memory_order_relaxed);
+        out.flush.sumNs += s.flushSum.load(std::memory_order_relaxed);
+        out.flush.maxNs = std::max(out.flush.maxNs, s.flushMax.load(std::memory_order_relaxed));
+        out.flush.intervalMaxNs = std::max(out.flush.intervalMaxNs, intervalMax(s.flushIntervalMax));
+        for (std::size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+            out.write.buckets[i] += s.writeHist[i].load(std::memory_order_relaxed);
+            out.flush.buckets[i] += s.flushHist[i].load(std::memory_order_relaxed);
+        }
+    }
+    out.write.count = out.messages;
+
+    out.bytes     = carriedBytes_.load(std::memory_order_relaxed);
+    out.rotations = carriedRotations_.load(std::memory_order_relaxed);
+    out.dropped   = carriedDropped_.load(std::memory_order_relaxed);
+    out.truncated = carriedTruncated_.load(std::memory_order_relaxed);
+    out.messages += carriedDirect_.load(std::memory_order_relaxed);
+    if (current) {
+        out.bytes     += current->bytesWritten();
+        out.rotations += current->rotationCount();
+        out.dropped   += current->droppedCount();
+        out.truncated += current->truncatedCount();
+        out.messages  += current->directMessages();
+    }
+    return out;
+}
+
+} // namespace j2
@@ -0,0 +1,270 @@
+#include "j2/SnapshotDistSink.hpp"
+#include "j2/DedupSink.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/formatter.h>
+
+namespace j2 {
+namespace sinks {
+
+namespace {
+// 상위 분배 싱크가 같은 그룹 커밋을 맡은 레코드(하위 분배 싱크는 바이트 누적/대기를 건너뜀)
+thread_local const FlushScheduler* tlCommitByParent = nullptr;
+
+struct CommitByParentScope {
+    explicit CommitByParentScope(const FlushScheduler* f) { tlCommitByParent = f; }
+    ~CommitByParentScope() { tlCommitByParent = nullptr; }
+};
+
+std::uint64_t elapsedNs(SnapshotDistSink::Clock::time_point t0) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(SnapshotDistSink::Clock::now() - t0).count());
+}
+} // anonymous namespace
+
+// 스레드마다 고정 샤드를 배정해 읽기 카운터의 캐시라인 경합을 분산
+unsigned SnapshotDistSink::shardIndex() {
+    static std::atomic<unsigned> next{0};
+    thread_local unsigned idx = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return idx;
+}
+
+SnapshotDistSink::ReadGuard::ReadGuard(const SnapshotDistSink& owner)
+    : counter_(owner.readers_[owner.epoch_.load(std::memory_order_acquire) & 1u][shardIndex()].n) {
+    // 카운터 증가가 스냅샷 로드보다 먼저 보이도록 seq_cst
+    counter_.fetch_add(1, std::memory_order_seq_cst);
+    set_ = owner.current_.load(std::memory_order_seq_cst);
+}
+
+SnapshotDistSink::ReadGuard::~ReadGuard() {
+    counter_.fetch_sub(1, std::memory_order_release);
+}
+
+SnapshotDistSink::SinkSet::SinkSet(std::vector<spdlog::sink_ptr> s, std::vector<std::shared_ptr<SinkStats>> st)
+    : sinks(std::move(s)), stats(std::move(st)) {
+    stats.resize(sinks.size());
+    std::size_t n = 0;
+    shared.reserve(sinks.size());
+    levelFlush.reserve(sinks.size());
+    for (const auto& sink : sinks) {
+        auto* sh = dynamic_cast<SharedFormatSink*>(sink.get());
+        shared.push_back(sh);
+        if (sh) ++n;
+        if (dynamic_cast<SnapshotDistSink*>(sink.get())) nested = true;
+        // 파일(DurableSink, alerts 앞의 DedupSink)은 제외, 하위 분배 싱크는 레코드를 받을 때 스스로 처리
+        auto* p = sink.get();
+        levelFlush.push_back(!dynamic_cast<DurableSink*>(p) && !dynamic_cast<DedupSink*>(p) &&
+                             !dynamic_cast<SnapshotDistSink*>(p));
+    }
+    grouped = n >= 2;
+}
+
+SnapshotDistSink::SnapshotDistSink() : current_(new SinkSet()) {}
+
+SnapshotDistSink::SnapshotDistSink(bool childLevels) : childLevels_(childLevels), current_(new SinkSet()) {}
+
+SnapshotDistSink::SnapshotDistSink(std::vector<spdlog::sink_ptr> sinks)
+    : current_(new SinkSet(std::move(sinks), {})) {}
+
+SnapshotDistSink::~SnapshotDistSink() {
+    delete current_.load(std::memory_order_acquire);
+}
+
+void SnapshotDistSink::log(const spdlog::details::log_msg& msg) {
+    std::shared_ptr<FlushScheduler> waitOn;
+    {
+        ReadGuard g(*this);
+        const SinkSet& set = g.set();
+        // 하위 분배 싱크(카테고리의 SINKS=shared)는 커밋을 이 싱크에 맡김: 레코드당 바이트 누적·커밋 대기 1회
+        const bool byParent = set.commit && set.commit.get() == tlCommitByParent;
+        if (set.nested && set.commit && !byParent) {
+            CommitByParentScope scope(set.commit.get());
+            logTo(set, msg);
+        } else {
+            logTo(set, msg);
+        }
+        if (set.commit) {
+            if (set.commit->groupBytes() && !byParent) set.commit->addBytes(msg.payload.size());
+            if (msg.level >= set.commitOn) {
+                if (set.commit->waitsOnCommit()) {
+                    if (!byParent) waitOn = set.commit;
+                } else {
+                    // DURABILITY=none: 파일 버퍼는 그대로 두고 콘솔/UDP 등은 예전 flush_on처럼 바로 내보냄
+                    for (std::size_t i = 0; i < set.sinks.size(); ++i) {
+                        if (set.levelFlush[i]) set.sinks[i]->flush();
+                    }
+                }
+            }
+        }
+    }
+    // 읽기 구간 밖에서 대기(구성 교체가 커밋을 기다리는 스레드를 기다리지 않게)
+    if (waitOn) waitOn->commitAndWait();
+}
+
+void SnapshotDistSink::logTo(const SinkSet& set, const spdlog::details::log_msg& msg) {
+    if (!set.grouped) {
+        for (std::size_t i = 0; i < set.sinks.size(); ++i) {
+            const auto& s = set.sinks[i];
+            SinkStats* st = set.stats[i].get();
+            if (childLevels_ && !s->should_log(msg.level)) {
+                if (st) st->onFiltered();
+                continue;
+            }
+            if (!st) {
+                s->log(msg);
+                continue;
+            }
+            auto t0 = Clock::now();
+            s->log(msg);
+            st->onWrite(elapsedNs(t0));
+        }
+        return;
+    }
+
+    // 키별로 처음 기록하는 싱크가 포맷한 버퍼를 같은 키의 나머지 싱크가 재사용
+    Rendered rendered[kMaxFormats];
+    std::size_t nRendered = 0;
+
+    for (std::size_t i = 0; i < set.sinks.size(); ++i) {
+        const auto& s = set.sinks[i];
+        SinkStats* st = set.stats[i].get();
+        if (childLevels_ && !s->should_log(msg.level)) {
+            if (st) st->onFiltered();
+            continue;
+        }
+        auto t0 = st ? Clock::now() : Clock::time_point{};
+
+        SharedFormatSink* sh = set.shared[i];
+        std::size_t key = sh ? sh->formatKey() : 0;
+        if (key == 0) {
+            s->log(msg);
+        } else {
+            logShared(msg, *s, *sh, key, rendered, nRendered);
+        }
+        if (st) st->onWrite(elapsedNs(t0));
+    }
+}
+
+// 같은 키로 이미 포맷한 버퍼가 있으면 재사용, 없으면 이 싱크가 포맷해 남김
+void SnapshotDistSink::logShared(const spdlog::details::log_msg& msg, spdlog::sinks::sink& s,
+                                 SharedFormatSink& sh, std::size_t key,
+                                 Rendered* rendered, std::size_t& nRendered) {
+    for (std::size_t k = 0; k < nRendered; ++k) {
+        if (rendered[k].key == key) {
+            sh.logRendered(msg, rendered[k].buf);
+            return;
+        }
+    }
+    if (nRendered < kMaxFormats) {
+        Rendered& r = rendered[nRendered++];
+        r.key = key;
+        sh.logRender(msg, r.buf);
+    } else {
+        s.log(msg);
+    }
+}
+
+void SnapshotDistSink::flush() {
+    ReadGuard g(*this);
+    const SinkSet& set = g.set();
+    for (std::size_t i = 0; i < set.sinks.size(); ++i) {
+        SinkStats* st = set.stats[i].get();
+        auto t0 = st ? Clock::now() : Clock::time_point{};
+        set.sinks[i]->flush();
+        if (st) st->onFlush(elapsedNs(t0));
+    }
+}
+
+void SnapshotDistSink::set_pattern(const std::string& pattern) {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    for (const auto& s : current_.load(std::memory_order_acquire)->sinks) {
+        s->set_pattern(pattern);
+    }
+}
+
+void SnapshotDistSink::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    for (const auto& s : current_.load(std::memory_order_acquire)->sinks) {
+        s->set_formatter(sink_formatter->clone());
+    }
+}
+
+void SnapshotDistSink::add_sink(std::shared_ptr<spdlog::sinks::sink> sub_sink) {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    const SinkSet* cur = current_.load(std::memory_order_acquire);
+    auto sinks = cur->sinks;
+    auto stats = cur->stats;
+    sinks.push_back(std::move(sub_sink));
+    stats.push_back(nullptr);
+    publish(new SinkSet(std::move(sinks), std::move(stats)));
+}
+
+void SnapshotDistSink::remove_sink(std::shared_ptr<spdlog::sinks::sink> sub_sink) {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    const SinkSet* cur = current_.load(std::memory_order_acquire);
+    std::vector<spdlog::sink_ptr> sinks;
+    std::vector<std::shared_ptr<SinkStats>> stats;
+    for (std::size_t i = 0; i < cur->sinks.size(); ++i) {
+        if (cur->sinks[i] == sub_sink) continue;
+        sinks.push_back(cur->sinks[i]);
+        stats.push_back(cur->stats[i]);
+    }
+    publish(new SinkSet(std::move(sinks), std::move(stats)));
+}
+
+void SnapshotDistSink::set_sinks(std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks,
+                                 std::vector<std::shared_ptr<SinkStats>> stats) {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    publish(new SinkSet(std::move(sinks), std::move(stats)));
+}
+
+void SnapshotDistSink::set_commit(std::shared_ptr<FlushScheduler> scheduler, spdlog::level::level_enum commitOn) {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    const SinkSet* cur = current_.load(std::memory_order_acquire);
+    if (cur->commit == scheduler && cur->commitOn == commitOn) return;
+    auto* next = new SinkSet(cur->sinks, cur->stats);
+    next->commit = std::move(scheduler);
+    next->commitOn = commitOn;
+    publish(next, false);
+}
+
+std::vector<std::shared_ptr<spdlog::sinks::sink>> SnapshotDistSink::sinks() const {
+    ReadGuard g(*this);
+    return g.set().sinks;
+}
+
+// 새 스냅샷 게시 후 epoch를 두 번 뒤집으며 양쪽 슬롯의 읽기 구간이 끝나길 기다린다.
+// 교체 이전에 카운터를 올린 독자는 어느 슬롯이든 둘 중 한 번은 반드시 기다려진다.
+void SnapshotDistSink::publish(SinkSet* next, bool keepCommit) {
+    if (keepCommit) {
+        const SinkSet* cur = current_.load(std::memory_order_acquire);
+        next->commit = cur->commit;
+        next->commitOn = cur->commitOn;
+    }
+    const SinkSet* old = current_.exchange(next, std::memory_order_seq_cst);
+    for (int i = 0; i < 2; ++i) {
+        unsigned slot = epoch_.fetch_add(1, std::memory_order_seq_cst) & 1u;
+        waitForReaders(slot);
+    }
+    delete old;  // 이전 싱크 참조 해제(마지막 참조면 여기서 파일 닫힘)
+}
+
+void SnapshotDistSink::waitForReaders(unsigned slot) const {
+    for (unsigned spins = 0;; ++spins) {
+        long active = 0;
+        // 게시(exchange) 후 카운터 읽기도 seq_cst: 독자의 "카운터 증가 → 스냅샷 읽기"와 짝을 이뤄
+        // 독자가 이전 스냅샷을 읽었다면 여기서 반드시 그 증가가 보임(acquire만으로는 보장 안 됨)
+        for (const auto& c : readers_[slot]) {
+            active += c.n.load(std::memory_order_seq_cst);
+        }
+        if (active == 0) return;
+        if (spins < 64) std::this_thread::yield();
+        else            std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+} // namespace sinks
+} // namespace j2
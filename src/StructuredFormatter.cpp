@@ -0,0 +1,234 @@
+#include "j2/StructuredFormatter.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <spdlog/details/fmt_helper.h>
+
+namespace j2 {
+
+namespace fh = spdlog::details::fmt_helper;
+
+namespace {
+constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+constexpr std::uint64_t kHigh = 0x8080808080808080ull;
+
+// 8바이트 중 하나라도 v 미만/같은 바이트가 있으면 0이 아님(SWAR, 0x80 이상 바이트는 제외)
+constexpr std::uint64_t hasLess(std::uint64_t w, std::uint8_t n) { return (w - kOnes * n) & ~w & kHigh; }
+constexpr std::uint64_t hasByte(std::uint64_t w, std::uint8_t c) { return hasLess(w ^ (kOnes * c), 1); }
+
+// JSON 이스케이프가 필요한 바이트: 제어 문자, '"', '\\'
+inline bool jsonClean(std::uint64_t w) { return (hasLess(w, 0x20) | hasByte(w, '"') | hasByte(w, '\\')) == 0; }
+// logfmt에서 따옴표가 필요한 바이트: 추가로 ' ', '='
+inline bool logfmtClean(std::uint64_t w) { return jsonClean(w) && (hasLess(w, 0x21) | hasByte(w, '=')) == 0; }
+
+constexpr char kHex[] = "0123456789abcdef";
+
+void escapeByte(spdlog::memory_buf_t& dest, unsigned char c) {
+    switch (c) {
+    case '"':  dest.append(std::string_view("\\\"")); break;
+    case '\\': dest.append(std::string_view("\\\\")); break;
+    case '\n': dest.append(std::string_view("\\n")); break;
+    case '\r': dest.append(std::string_view("\\r")); break;
+    case '\t': dest.append(std::string_view("\\t")); break;
+    default:
+        if (c < 0x20) {
+            const char u[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+            dest.append(u, u + 6);
+        } else {
+            dest.push_back(static_cast<char>(c));
+        }
+    }
+}
+
+// 깨끗한 구간은 8바이트씩 건너뛰며 한 번에 복사, 걸리는 바이트만 개별 처리
+template <typename Clean>
+void escapeInto(spdlog::memory_buf_t& dest, std::string_view s, Clean clean) {
+    const char* p = s.data();
+    const char* const end = p + s.size();
+    const char* run = p;
+    while (p < end) {
+        if (end - p >= 8) {
+            std::uint64_t w;
+            std::memcpy(&w, p, 8);
+            if (clean(w)) {
+                p += 8;
+                continue;
+            }
+        }
+        const auto c = static_cast<unsigned char>(*p);
+        if (c < 0x20 || c == '"' || c == '\\') {
+            dest.append(run, p);
+            escapeByte(dest, c);
+            run = p + 1;
+        }
+        ++p;
+    }
+    dest.append(run, end);
+}
+
+bool logfmtNeedsQuotes(std::string_view s) {
+    if (s.empty()) return true;
+    const char* p = s.data();
+    const char* const end = p + s.size();
+    for (; end - p >= 8; p += 8) {
+        std::uint64_t w;
+        std::memcpy(&w, p, 8);
+        if (!logfmtClean(w)) return true;
+    }
+    for (; p < end; ++p) {
+        const auto c = static_cast<unsigned char>(*p);
+        if (c <= ' ' || c == '"' || c == '\\' || c == '=') return true;
+    }
+    return false;
+}
+} // anonymous namespace
+
+void appendJsonEscaped(spdlog::memory_buf_t& dest, std::string_view s) {
+    escapeInto(dest, s, jsonClean);
+}
+
+void appendLogfmtValue(spdlog::memory_buf_t& dest, std::string_view s) {
+    if (!logfmtNeedsQuotes(s)) {
+        dest.append(s.data(), s.data() + s.size());
+        return;
+    }
+    dest.push_back('"');
+    escapeInto(dest, s, jsonClean);
+    dest.push_back('"');
+}
+
+void appendFieldValue(spdlog::memory_buf_t& dest, const Field& f, bool json) {
+    switch (f.kind) {
+    case Field::Kind::i64: fh::append_int(f.i, dest); break;
+    case Field::Kind::u64: fh::append_int(f.u, dest); break;
+    case Field::Kind::f64:
+        // JSON에는 nan/inf 표기가 없으므로 null
+        if (json && !std::isfinite(f.d)) dest.append(std::string_view("null"));
+        else fmt::format_to(fmt::appender(dest), "{}", f.d);
+        break;
+    case Field::Kind::boolean: dest.append(std::string_view(f.b ? "true" : "false")); break;
+    case Field::Kind::str:
+        if (json) {
+            dest.push_back('"');
+            appendJsonEscaped(dest, f.s);
+            dest.push_back('"');
+        } else {
+            appendLogfmtValue(dest, f.s);
+        }
+        break;
+    }
+}
+
+FieldContext& fieldContext() {
+    static thread_local FieldContext ctx;
+    return ctx;
+}
+
+StructuredFormatter::StructuredFormatter(Style style, spdlog::pattern_time_type timeType, std::string eol)
+    : style_(style), timeType_(timeType), eol_(std::move(eol)) {}
+
+std::unique_ptr<spdlog::formatter> StructuredFormatter::clone() const {
+    return std::make_unique<StructuredFormatter>(style_, timeType_, eol_);
+}
+
+void StructuredFormatter::renderSeconds_(std::time_t secs) {
+    const bool utc = timeType_ == spdlog::pattern_time_type::utc;
+    std::tm tm = utc ? spdlog::details::os::gmtime(secs) : spdlog::details::os::localtime(secs);
+    spdlog::memory_buf_t buf;
+    fh::append_int(tm.tm_year + 1900, buf);
+    buf.push_back('-');
+    fh::pad2(tm.tm_mon + 1, buf);
+    buf.push_back('-');
+    fh::pad2(tm.tm_mday, buf);
+    buf.push_back('T');
+    fh::pad2(tm.tm_hour, buf);
+    buf.push_back(':');
+    fh::pad2(tm.tm_min, buf);
+    buf.push_back(':');
+    fh::pad2(tm.tm_sec, buf);
+    cachedDate_.assign(buf.data(), buf.size());
+
+    int offset = utc ? 0 : spdlog::details::os::utc_minutes_offset(tm);
+    if (offset == 0 && utc) {
+        cachedZone_ = "Z";
+    } else {
+        buf.clear();
+        buf.push_back(offset < 0 ? '-' : '+');
+        if (offset < 0) offset = -offset;
+        fh::pad2(offset / 60, buf);
+        buf.push_back(':');
+        fh::pad2(offset % 60, buf);
+        cachedZone_.assign(buf.data(), buf.size());
+    }
+    cachedSec_ = secs;
+}
+
+void StructuredFormatter::format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) {
+    using namespace std::chrono;
+    const auto since = msg.time.time_since_epoch();
+    const auto secs = duration_cast<seconds>(since);
+    const auto t = static_cast<std::time_t>(secs.count());
+    if (t != cachedSec_) renderSeconds_(t);
+
+    // hX_kv 레코드면 메시지/필드를 나눠서 출력
+    std::string_view text(msg.payload.data(), msg.payload.size());
+    const Field* fields = nullptr;
+    std::size_t count = 0;
+    const FieldContext& ctx = fieldContext();
+    if (ctx.payload == msg.payload.data() && ctx.msgLen <= text.size()) {
+        text = text.substr(0, ctx.msgLen);
+        fields = ctx.fields;
+        count = ctx.count;
+    }
+    const auto level = spdlog::level::to_string_view(msg.level);
+    const std::string_view logger(msg.logger_name.data(), msg.logger_name.size());
+    const auto millis = static_cast<std::uint32_t>(duration_cast<milliseconds>(since - secs).count());
+
+    if (style_ == Style::json) {
+        dest.append(std::string_view("{\"ts\":\""));
+        dest.append(cachedDate_.data(), cachedDate_.data() + cachedDate_.size());
+        dest.push_back('.');
+        fh::pad3(millis, dest);
+        dest.append(cachedZone_.data(), cachedZone_.data() + cachedZone_.size());
+        dest.append(std::string_view("\",\"level\":\""));
+        dest.append(level.data(), level.data() + level.size());
+        dest.append(std::string_view("\",\"thread\":"));
+        fh::append_int(msg.thread_id, dest);
+        dest.append(std::string_view(",\"logger\":\""));
+        appendJsonEscaped(dest, logger);
+        dest.append(std::string_view("\",\"msg\":\""));
+        appendJsonEscaped(dest, text);
+        dest.push_back('"');
+        for (std::size_t i = 0; i < count; ++i) {
+            dest.append(std::string_view(",\""));
+            appendJsonEscaped(dest, fields[i].key);
+            dest.append(std::string_view("\":"));
+            appendFieldValue(dest, fields[i], true);
+        }
+        dest.push_back('}');
+    } else {
+        dest.append(std::string_view("ts="));
+        dest.append(cachedDate_.data(), cachedDate_.data() + cachedDate_.size());
+        dest.push_back('.');
+        fh::pad3(millis, dest);
+        dest.append(cachedZone_.data(), cachedZone_.data() + cachedZone_.size());
+        dest.append(std::string_view(" level="));
+        dest.append(level.data(), level.data() + level.size());
+        dest.append(std::string_view(" thread="));
+        fh::append_int(msg.thread_id, dest);
+        dest.append(std::string_view(" logger="));
+        appendLogfmtValue(dest, logger);
+        dest.append(std::string_view(" msg=\""));
+        appendJsonEscaped(dest, text);
+        dest.push_back('"');
+        for (std::size_t i = 0; i < count; ++i) {
+            dest.push_back(' ');
+            dest.append(fields[i].key.data(), fields[i].key.data() + fields[i].key.size());
+            dest.push_back('=');
+            appendFieldValue(dest, fields[i], false);
+        }
+    }
+    dest.append(eol_.data(), eol_.data() + eol_.size());
+}
+
+} // namespace j2
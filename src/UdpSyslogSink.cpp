@@ -0,0 +1,138 @@
+#include "j2/UdpSyslogSink.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <spdlog/details/os.h>
+#include <spdlog/fmt/fmt.h>
+
+namespace j2 {
+namespace sinks {
+
+namespace {
+// spdlog 레벨 → syslog severity
+int severityOf(spdlog::level::level_enum lvl) {
+    switch (lvl) {
+    case spdlog::level::critical: return 2;
+    case spdlog::level::err:      return 3;
+    case spdlog::level::warn:     return 4;
+    case spdlog::level::info:     return 6;
+    case spdlog::level::debug:
+    case spdlog::level::trace:
+    default:                      return 7;
+    }
+}
+
+// RFC 5424 HOSTNAME/APP-NAME: 공백 없는 출력 가능 ASCII, 비어 있으면 "-"
+std::string headerToken(const std::string& s, std::size_t maxLen) {
+    std::string out;
+    for (unsigned char c : s) {
+        if (out.size() >= maxLen) break;
+        if (c > 32 && c < 127) out.push_back(static_cast<char>(c));
+    }
+    return out.empty() ? std::string("-") : out;
+}
+} // anonymous namespace
+
+UdpSyslogSink::UdpSyslogSink(Options opt)
+    : opt_(std::move(opt))
+    , transport_(opt_.maxQueued)
+    , timer_(transport_.context()) {
+    if (opt_.mtu < 64) opt_.mtu = 64;
+    boost::system::error_code ec;
+    hostname_ = headerToken(boost::asio::ip::host_name(ec), 255);
+    procId_   = std::to_string(spdlog::details::os::pid());
+    opt_.appName = headerToken(opt_.appName, 48);
+    transport_.setTarget(opt_.host, opt_.port);
+    if (opt_.flushInterval.count() > 0) {
+        boost::asio::post(transport_.context(), [this]() { armTimer(); });
+    }
+}
+
+UdpSyslogSink::~UdpSyslogSink() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sendBatch_();
+    }
+    transport_.shutdown();  // 타이머 핸들러가 더 이상 실행되지 않음을 보장
+}
+
+void UdpSyslogSink::sink_it_(const spdlog::details::log_msg& msg) {
+    spdlog::memory_buf_t body;
+    formatter_->format(msg, body);
+    std::size_t n = body.size();
+    while (n > 0 && (body[n - 1] == '\n' || body[n - 1] == '\r')) --n;
+
+    record_.clear();
+    int pri = opt_.facility * 8 + severityOf(msg.level);
+    fmt::format_to(fmt::appender(record_), "<{}>1 ", pri);
+    appendTimestamp_(record_, msg.time);
+    fmt::format_to(fmt::appender(record_), " {} {} {} - - ", hostname_, opt_.appName, procId_);
+    record_.append(body.data(), body.data() + n);
+
+    std::size_t len = std::min(record_.size(), opt_.mtu);  // MTU보다 긴 레코드는 잘라서 전송
+    if (batch_.size() > 0 && batch_.size() + 1 + len > opt_.mtu) sendBatch_();
+    if (batch_.size() > 0) batch_.push_back('\n');
+    batch_.append(record_.data(), record_.data() + len);
+}
+
+void UdpSyslogSink::flush_() {
+    sendBatch_();
+}
+
+void UdpSyslogSink::sendBatch_() {
+    if (batch_.size() == 0) return;
+    if (transport_.send(std::string(batch_.data(), batch_.size()))) {
+        bytes_.fetch_add(batch_.size(), std::memory_order_relaxed);
+    }
+    batch_.clear();
+}
+
+// io 스레드: 묶음이 오래 머물지 않도록 주기적으로 전송
+void UdpSyslogSink::armTimer() {
+    timer_.expires_after(opt_.flushInterval);
+    timer_.async_wait([this](const boost::system::error_code& ec) {
+        if (ec) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sendBatch_();
+        }
+        armTimer();
+    });
+}
+
+// 2025-01-31T12:00:00.123456Z (초 부분은 캐시)
+void UdpSyslogSink::appendTimestamp_(spdlog::memory_buf_t& dest, spdlog::log_clock::time_point tp) {
+    auto since = tp.time_since_epoch();
+    auto secs = std::chrono::duration_cast<std::chrono::seconds>(since);
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(since - secs).count();
+    std::time_t t = static_cast<std::time_t>(secs.count());
+    if (t != cachedSec_) {
+        std::tm tm = spdlog::details::os::gmtime(t);
+        std::strftime(cachedTs_, sizeof(cachedTs_), "%Y-%m-%dT%H:%M:%S", &tm);
+        cachedSec_ = t;
+    }
+    dest.append(cachedTs_, cachedTs_ + std::strlen(cachedTs_));
+    fmt::format_to(fmt::appender(dest), ".{:06}Z", micros);
+}
+
+int UdpSyslogSink::parseFacility(const std::string& s, int def) {
+    static const struct { const char* name; int code; } kNames[] = {
+        {"kern", 0}, {"user", 1}, {"mail", 2}, {"daemon", 3}, {"auth", 4}, {"syslog", 5},
+        {"lpr", 6}, {"news", 7}, {"uucp", 8}, {"cron", 9}, {"authpriv", 10}, {"ftp", 11},
+        {"local0", 16}, {"local1", 17}, {"local2", 18}, {"local3", 19},
+        {"local4", 20}, {"local5", 21}, {"local6", 22}, {"local7", 23}};
+    std::string v;
+    for (unsigned char c : s) v.push_back(static_cast<char>(std::tolower(c)));
+    for (const auto& e : kNames) {
+        if (v == e.name) return e.code;
+    }
+    if (!v.empty() && std::all_of(v.begin(), v.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        int n = std::stoi(v);
+        if (n >= 0 && n <= 23) return n;
+    }
+    return def;
+}
+
+} // namespace sinks
+} // namespace j2
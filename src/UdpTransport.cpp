@@ -0,0 +1,110 @@
+#include "j2/UdpTransport.hpp"
+
+#include <chrono>
+#include <iostream>
+
+namespace j2 {
+
+UdpTransport::UdpTransport(std::size_t maxQueued)
+    : work_(boost::asio::make_work_guard(io_))
+    , socket_(io_)
+    , maxQueued_(maxQueued == 0 ? 1 : maxQueued)
+    , thread_([this]() {
+          for (;;) {
+              try {
+                  io_.run();
+                  break;
+              } catch (...) {
+                  // 핸들러 예외로 스레드가 죽지 않도록 계속 실행
+              }
+          }
+      }) {}
+
+UdpTransport::~UdpTransport() { shutdown(); }
+
+void UdpTransport::shutdown() {
+    if (stopped_.exchange(true)) return;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    while (pending_.load(std::memory_order_acquire) > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    work_.reset();
+    io_.stop();
+    if (thread_.joinable()) thread_.join();
+    boost::system::error_code ec;
+    socket_.close(ec);
+}
+
+void UdpTransport::setTarget(const std::string& host, unsigned short port) {
+    boost::asio::post(io_, [this, host, port]() {
+        boost::system::error_code ec;
+        boost::asio::ip::udp::endpoint ep;
+        auto addr = boost::asio::ip::make_address(host, ec);
+        if (!ec) {
+            ep = boost::asio::ip::udp::endpoint(addr, port);
+        } else {
+            boost::asio::ip::udp::resolver resolver(io_);
+            auto results = resolver.resolve(host, std::to_string(port), ec);
+            if (ec || results.empty()) {
+                std::cerr << "[LoggerManager] UDP: cannot resolve " << host << ": " << ec.message() << "\n";
+                haveEndpoint_ = false;
+                return;
+            }
+            ep = *results.begin();
+        }
+
+        if (socket_.is_open() && endpoint_.protocol() != ep.protocol()) socket_.close(ec);
+        if (!socket_.is_open()) {
+            socket_.open(ep.protocol(), ec);
+            if (ec) {
+                std::cerr << "[LoggerManager] UDP: socket open failed: " << ec.message() << "\n";
+                haveEndpoint_ = false;
+                return;
+            }
+        }
+        endpoint_ = ep;
+        haveEndpoint_ = true;
+    });
+}
+
+bool UdpTransport::send(std::string datagram) {
+    if (stopped_.load(std::memory_order_relaxed) ||
+        pending_.fetch_add(1, std::memory_order_acq_rel) >= maxQueued_) {
+        if (!stopped_.load(std::memory_order_relaxed)) pending_.fetch_sub(1, std::memory_order_acq_rel);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    boost::asio::post(io_, [this, d = std::move(datagram)]() mutable {
+        queue_.push_back(std::move(d));
+        if (!sending_) startSend();
+    });
+    return true;
+}
+
+void UdpTransport::startSend() {
+    if (queue_.empty()) {
+        sending_ = false;
+        return;
+    }
+    if (!haveEndpoint_) {
+        // 대상 미확정: 쌓아 두지 않고 버림
+        dropped_.fetch_add(queue_.size(), std::memory_order_relaxed);
+        pending_.fetch_sub(queue_.size(), std::memory_order_acq_rel);
+        queue_.clear();
+        sending_ = false;
+        return;
+    }
+
+    sending_ = true;
+    socket_.async_send_to(boost::asio::buffer(queue_.front()), endpoint_,
+                          [this](const boost::system::error_code& ec, std::size_t) {
+                              if (ec) dropped_.fetch_add(1, std::memory_order_relaxed);
+                              else    sent_.fetch_add(1, std::memory_order_relaxed);
+                              queue_.pop_front();
+                              pending_.fetch_sub(1, std::memory_order_acq_rel);
+                              startSend();
+                          });
+}
+
+} // namespace j2
@@ -0,0 +1,520 @@
+#include "j2/UringFileWriter.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <spdlog/details/os.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define J2_URING_SUPPORTED 1
+#include <linux/io_uring.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace j2 {
+namespace sinks {
+
+namespace {
+constexpr std::uint64_t kFsyncTag = 1ull << 62;
+constexpr std::uint64_t kWakeTag  = 1ull << 63;
+constexpr unsigned kEntries = 32;   // 버퍼 8 + fsync 보다 넉넉히
+// 완료 대기 상한(빈 버퍼, drain, fsync). 넘으면 spdlog_ex
+constexpr std::chrono::seconds kCompletionWait{10};
+// io_uring_enter가 EAGAIN/EBUSY(커널 자원, CQ 넘침)일 때 재시도 횟수(1 ms 간격)
+constexpr int kEnterRetries = 100;
+// 수거 스레드가 완료를 기다리는 최대 시간(종료 플래그 확인 주기)
+constexpr long kReapPollNs = 100L * 1000 * 1000;
+// 수거 스레드의 외부 truncate 확인 주기(로깅 스레드는 fstat 하지 않음)
+constexpr std::chrono::seconds kTruncateCheck{1};
+} // anonymous namespace
+
+#ifdef J2_URING_SUPPORTED
+
+namespace {
+int uringSetup(unsigned entries, io_uring_params* p) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+int uringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags,
+               const void* arg = nullptr, std::size_t argSize = 0) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+}
+int uringRegister(int fd, unsigned op, const void* arg, unsigned n) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, op, arg, n));
+}
+
+// 남은 부분을 동기 pwrite로 마저 기록(짧은 기록/오류 복구용)
+bool pwriteAll(int fd, const char* data, std::size_t len, std::uint64_t offset) {
+    while (len > 0) {
+        ssize_t n = ::pwrite(fd, data, len, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        len -= static_cast<std::size_t>(n);
+        offset += static_cast<std::uint64_t>(n);
+    }
+    return true;
+}
+} // anonymous namespace
+
+// SQ/CQ 링 매핑(단일 생산자: 싱크 mutex 보유 스레드, 단일 소비자: 수거 스레드)
+struct UringFileWriter::Ring {
+    int fd = -1;
+    void* sqMap = MAP_FAILED;
+    std::size_t sqMapLen = 0;
+    void* cqMap = MAP_FAILED;
+    std::size_t cqMapLen = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    std::size_t sqesLen = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned sqEntries = 0;
+    unsigned pending = 0;          // 준비했지만 아직 enter 하지 않은 SQE 수
+    bool fixed = false;            // 버퍼 등록 성공(WRITE_FIXED 사용)
+
+    ~Ring() {
+        if (sqes != MAP_FAILED) ::munmap(sqes, sqesLen);
+        if (cqMap != MAP_FAILED && cqMap != sqMap) ::munmap(cqMap, cqMapLen);
+        if (sqMap != MAP_FAILED) ::munmap(sqMap, sqMapLen);
+        if (fd >= 0) ::close(fd);
+    }
+
+    bool setup(unsigned entries) {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        fd = uringSetup(entries, &p);
+        if (fd < 0) return false;
+        // 수거 스레드의 시간 제한 대기(IORING_ENTER_EXT_ARG, 5.11+)가 없으면 사용 안 함
+        if (!(p.features & IORING_FEAT_EXT_ARG)) return false;
+        sqEntries = p.sq_entries;
+
+        sqMapLen = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cqMapLen = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) sqMapLen = cqMapLen = std::max(sqMapLen, cqMapLen);
+
+        sqMap = ::mmap(nullptr, sqMapLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sqMap == MAP_FAILED) return false;
+        cqMap = single ? sqMap
+                       : ::mmap(nullptr, cqMapLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                                IORING_OFF_CQ_RING);
+        if (cqMap == MAP_FAILED) return false;
+        sqesLen = p.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, sqesLen, PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+        if (sqes == MAP_FAILED) return false;
+
+        auto* sq = static_cast<char*>(sqMap);
+        auto* cq = static_cast<char*>(cqMap);
+        sqHead  = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        sqTail  = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sqMask  = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        cqHead  = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cqTail  = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cqMask  = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes    = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    // 다음 SQE를 비워서 반환(게시는 enter 전에 tail 갱신으로). SQ가 차 있으면 nullptr
+    io_uring_sqe* prepare() {
+        const unsigned tail = *sqTail + pending;
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) return nullptr;
+        const unsigned idx = tail & *sqMask;
+        io_uring_sqe* sqe = &sqes[idx];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqArray[idx] = idx;
+        ++pending;
+        return sqe;
+    }
+
+    // 준비한 SQE 게시 후 SQ가 빌 때까지 제출. EAGAIN/EBUSY는 잠시 뒤 재시도,
+    // 실패하면 -errno(제출 못 한 SQE는 SQ에 남음 → takeUnsubmitted)
+    int enter() {
+        const unsigned tail = *sqTail + pending;
+        if (pending) __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+        pending = 0;
+        int retries = 0;
+        for (;;) {
+            const unsigned n = tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+            if (n == 0) return 0;
+            const int r = uringEnter(fd, n, 0, 0);
+            if (r > 0) continue;
+            const int err = r < 0 ? errno : EAGAIN;
+            if (err == EINTR) continue;
+            if ((err == EAGAIN || err == EBUSY) && ++retries < kEnterRetries) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            return -err;
+        }
+    }
+
+    // 커널이 가져가지 않은 SQE를 SQ에서 거둬 user_data 목록으로 반환
+    // (SQPOLL 없이 제출은 이 스레드의 enter로만 일어나므로 tail을 head로 되돌려도 안전)
+    std::vector<std::uint64_t> takeUnsubmitted() {
+        std::vector<std::uint64_t> tags;
+        const unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        const unsigned tail = *sqTail;
+        for (unsigned i = head; i != tail; ++i) tags.push_back(sqes[sqArray[i & *sqMask]].user_data);
+        __atomic_store_n(sqTail, head, __ATOMIC_RELEASE);
+        return tags;
+    }
+};
+
+bool UringFileWriter::supported() {
+    static const bool ok = []() {
+        Ring r;
+        return r.setup(4);
+    }();
+    return ok;
+}
+
+UringFileWriter::UringFileWriter() : ring_(std::make_unique<Ring>()) {
+    if (!ring_->setup(kEntries)) {
+        spdlog::throw_spdlog_ex("io_uring_setup failed", errno);
+    }
+    pool_.resize(kBuffers * kBufferBytes);
+    slots_.resize(kBuffers);
+    std::vector<iovec> iov(kBuffers);
+    for (std::size_t i = 0; i < kBuffers; ++i) {
+        slots_[i].data = pool_.data() + i * kBufferBytes;
+        iov[i].iov_base = slots_[i].data;
+        iov[i].iov_len = kBufferBytes;
+        free_.push_back(static_cast<int>(kBuffers - 1 - i));
+    }
+    // 등록 실패(RLIMIT_MEMLOCK 등)면 일반 WRITE로 같은 버퍼 사용
+    ring_->fixed = uringRegister(ring_->fd, IORING_REGISTER_BUFFERS, iov.data(), kBuffers) == 0;
+    reaper_ = std::thread([this]() { reap_(); });
+}
+
+UringFileWriter::~UringFileWriter() {
+    try { close(); } catch (...) {}
+    // 수거 스레드는 kReapPollNs마다 종료 플래그를 확인. NOP은 바로 깨우기 위한 것(제출 실패해도 상한 안에 종료)
+    stop_.store(true, std::memory_order_release);
+    if (io_uring_sqe* sqe = ring_->prepare()) {
+        sqe->opcode = IORING_OP_NOP;
+        sqe->user_data = kWakeTag;
+        if (ring_->enter() < 0) (void)ring_->takeUnsubmitted();
+    }
+    if (reaper_.joinable()) reaper_.join();
+}
+
+void UringFileWriter::open(const std::string& fname, bool truncate) {
+    close();
+    spdlog::details::os::create_dir(spdlog::details::os::dir_name(fname));
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+    fd_ = ::open(fname.c_str(), flags, 0644);
+    if (fd_ < 0) {
+        spdlog::throw_spdlog_ex("Failed opening file " + fname + " for writing", errno);
+    }
+    const off_t end = ::lseek(fd_, 0, SEEK_END);
+    offset_ = end > 0 ? static_cast<std::uint64_t>(end) : 0;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        writtenEnd_ = offset_;
+        watchFd_ = fd_;
+    }
+    truncated_.store(false, std::memory_order_relaxed);
+    filename_ = fname;
+}
+
+void UringFileWriter::reopen(bool truncate) {
+    if (filename_.empty()) {
+        spdlog::throw_spdlog_ex("Failed re opening file - was not opened before");
+    }
+    const std::string name = filename_;
+    open(name, truncate);
+}
+
+void UringFileWriter::write(const spdlog::memory_buf_t& buf) {
+    // 잘린 파일은 다음 기록에서 바로 따라감(size()가 싱크의 회전 크기/색인에 바로 반영되도록)
+    if (fd_ >= 0 && truncated_.load(std::memory_order_relaxed)) followTruncate_();
+    const char* p = buf.data();
+    std::size_t n = buf.size();
+    while (n > 0) {
+        if (cur_ < 0) {
+            cur_ = acquire_();
+            curLen_ = 0;
+        }
+        const std::size_t k = std::min(n, kBufferBytes - curLen_);
+        std::memcpy(slots_[cur_].data + curLen_, p, k);
+        curLen_ += k;
+        p += k;
+        n -= k;
+        if (curLen_ == kBufferBytes) {
+            submitCurrent_(false);
+            submit_();
+        }
+    }
+}
+
+// 채우던 버퍼를 WRITE(_FIXED) SQE로 준비(enter는 호출 측). linkNext: 다음 SQE(fsync)와 연결
+void UringFileWriter::submitCurrent_(bool linkNext) {
+    if (cur_ < 0 || curLen_ == 0 || fd_ < 0) return;
+    if (truncated_.load(std::memory_order_relaxed)) followTruncate_();
+    Slot& s = slots_[cur_];
+    s.len = curLen_;
+    s.offset = offset_;
+    io_uring_sqe* sqe = nextSqe_();
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        ++inflight_;
+    }
+    sqe->opcode = ring_->fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    sqe->fd = fd_;
+    sqe->addr = reinterpret_cast<std::uint64_t>(s.data);
+    sqe->len = static_cast<std::uint32_t>(s.len);
+    sqe->off = s.offset;
+    if (ring_->fixed) sqe->buf_index = static_cast<std::uint16_t>(cur_);
+    if (linkNext) sqe->flags |= IOSQE_IO_LINK;
+    sqe->user_data = static_cast<std::uint64_t>(cur_);
+    offset_ += curLen_;
+    cur_ = -1;
+    curLen_ = 0;
+}
+
+void UringFileWriter::flush() {
+    submitCurrent_(false);
+    submit_();
+}
+
+// 다음 SQE(SQ가 차 있으면 먼저 제출해 비움)
+io_uring_sqe* UringFileWriter::nextSqe_() {
+    io_uring_sqe* sqe = ring_->prepare();
+    if (!sqe) {
+        submit_();
+        sqe = ring_->prepare();
+    }
+    return sqe;
+}
+
+// 준비한 SQE 제출. 끝내 실패하면 SQ에서 거둬 이 스레드에서 동기로 처리(pwrite/fdatasync):
+// 기록을 먼저 끝내고, fsync는 커널에 들어간 기록이 끝난 뒤(최대 kCompletionWait)
+void UringFileWriter::submit_() {
+    const int r = ring_->enter();
+    if (r == 0) return;
+    const std::vector<std::uint64_t> tags = ring_->takeUnsubmitted();
+    reportOnce_("submit", -r);
+    std::size_t fsyncs = 0;
+    for (std::uint64_t tag : tags) {
+        if (tag & kFsyncTag) ++fsyncs;
+        else                 complete_(tag, r);
+    }
+    if (fsyncs == 0) return;
+    {
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait_for(lk, kCompletionWait, [&]() { return inflight_ <= fsyncs; });
+    }
+    for (std::uint64_t tag : tags) {
+        if (tag & kFsyncTag) complete_(tag, r);
+    }
+}
+
+// 수거 스레드가 외부 truncate(copytruncate 등)를 알린 뒤 첫 제출: 진행 중인 기록을 끝내고
+// 현재 파일 끝부터 이어 씀(O_APPEND 없이 직접 지정한 오프셋이 NUL 구멍을 만들지 않게)
+void UringFileWriter::followTruncate_() {
+    drain_();
+    truncated_.store(false, std::memory_order_relaxed);
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) return;
+    offset_ = static_cast<std::uint64_t>(st.st_size);
+    ++truncations_;
+    std::lock_guard<std::mutex> lk(mu_);
+    writtenEnd_ = offset_;
+}
+
+// 수거 스레드에서 kTruncateCheck마다: 끝난 기록보다 파일이 짧으면 truncated_ 표시
+// (mu_ 안에서 fstat: close가 watchFd_를 비운 뒤에 fd를 닫으므로 닫힌 fd를 보지 않음)
+void UringFileWriter::checkTruncate_() {
+    std::lock_guard<std::mutex> lk(mu_);
+    struct stat st;
+    if (watchFd_ < 0 || ::fstat(watchFd_, &st) != 0) return;
+    if (static_cast<std::uint64_t>(st.st_size) < writtenEnd_) truncated_.store(true, std::memory_order_relaxed);
+}
+
+void UringFileWriter::reportOnce_(const char* what, int err) {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (errorReported_) return;
+        errorReported_ = true;
+    }
+    std::cerr << "[LoggerManager] io_uring " << what << " failed for " << filename_ << ": " << std::strerror(err)
+              << "\n";
+}
+
+FileWriter::SyncTicket UringFileWriter::beginSync() {
+    if (fd_ < 0) return SyncTicket{filename_, -1, 0};
+    const bool linked = cur_ >= 0 && curLen_ > 0;
+    submitCurrent_(linked);
+    const std::uint64_t seq = ++fsyncSeq_;
+    io_uring_sqe* sqe = nextSqe_();
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        ++inflight_;
+    }
+    sqe->opcode = IORING_OP_FSYNC;
+    sqe->fd = fd_;
+    sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+    sqe->flags |= IOSQE_IO_DRAIN;     // 앞서 제출한 기록이 모두 끝난 뒤
+    sqe->user_data = kFsyncTag | seq;
+    submit_();
+    return SyncTicket{filename_, -1, seq};  // 같은 링의 번호로 대기(close는 이 fsync까지 끝낸 뒤 닫음)
+}
+
+// 완료되지 않았거나 이 번호 이후 fdatasync가 실패했으면 spdlog_ex
+void UringFileWriter::endSync(const SyncTicket& t) {
+    if (t.seq == 0) return;
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!cv_.wait_for(lk, kCompletionWait, [&]() { return fsyncDone_ >= t.seq; })) {
+        spdlog::throw_spdlog_ex("io_uring fdatasync did not complete in time for " + t.path);
+    }
+    if (fsyncFailed_ >= t.seq) {
+        spdlog::throw_spdlog_ex("io_uring fdatasync failed for " + t.path, fsyncErrno_);
+    }
+}
+
+// drain_이 시간 안에 끝나지 않으면 fd를 닫지 않고 spdlog_ex(완료 처리가 아직 fd_를 씀)
+void UringFileWriter::close() {
+    if (fd_ < 0) return;
+    submitCurrent_(false);
+    submit_();
+    drain_();
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (cur_ >= 0) free_.push_back(cur_);
+        watchFd_ = -1;
+    }
+    cur_ = -1;
+    curLen_ = 0;
+    ::close(fd_);
+    fd_ = -1;
+}
+
+int UringFileWriter::acquire_() {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!cv_.wait_for(lk, kCompletionWait, [this]() { return !free_.empty(); })) {
+        spdlog::throw_spdlog_ex("io_uring writes did not complete in time for " + filename_);
+    }
+    int idx = free_.back();
+    free_.pop_back();
+    return idx;
+}
+
+void UringFileWriter::drain_() {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!cv_.wait_for(lk, kCompletionWait, [this]() { return inflight_ == 0; })) {
+        spdlog::throw_spdlog_ex("io_uring writes did not complete in time for " + filename_);
+    }
+}
+
+void UringFileWriter::reap_() {
+    __kernel_timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = kReapPollNs;
+    io_uring_getevents_arg arg;
+    std::memset(&arg, 0, sizeof(arg));
+    arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+    auto nextCheck = std::chrono::steady_clock::now() + kTruncateCheck;
+    while (!stop_.load(std::memory_order_acquire)) {
+        int r = uringEnter(ring_->fd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+        if (r < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY && errno != ETIME) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        unsigned head = *ring_->cqHead;
+        const unsigned tail = __atomic_load_n(ring_->cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const io_uring_cqe& cqe = ring_->cqes[head & *ring_->cqMask];
+            const std::uint64_t tag = cqe.user_data;
+            const int res = cqe.res;
+            ++head;
+            if (tag != kWakeTag) complete_(tag, res);
+        }
+        __atomic_store_n(ring_->cqHead, head, __ATOMIC_RELEASE);
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= nextCheck) {
+            nextCheck = now + kTruncateCheck;
+            checkTruncate_();
+        }
+    }
+}
+
+// 완료 1건 처리: 짧은 기록/실패/취소된 fsync는 여기서 동기 호출로 마저 처리
+// (inflight_를 줄이기 전까지는 fd_/filename_이 바뀌지 않음: open/close가 drain_ 후에 교체)
+void UringFileWriter::complete_(std::uint64_t tag, int res) {
+    const bool fsync = (tag & kFsyncTag) != 0;
+    bool ok = true;
+    if (fsync) {
+        ok = res >= 0 || ::fdatasync(fd_) == 0;
+    } else {
+        const Slot& s = slots_[tag];
+        const std::size_t done = res > 0 ? static_cast<std::size_t>(res) : 0;
+        ok = done >= s.len || pwriteAll(fd_, s.data + done, s.len - done, s.offset + done);
+    }
+    const int err = ok ? 0 : errno;
+    if (!ok) reportOnce_(fsync ? "fdatasync" : "write", err);
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (fsync) {
+            const std::uint64_t seq = tag & ~kFsyncTag;
+            fsyncDone_ = std::max(fsyncDone_, seq);
+            if (!ok && seq > fsyncFailed_) {
+                fsyncFailed_ = seq;
+                fsyncErrno_ = err;
+            }
+        } else {
+            const Slot& s = slots_[tag];
+            if (ok) writtenEnd_ = std::max(writtenEnd_, s.offset + s.len);
+            free_.push_back(static_cast<int>(tag));
+        }
+        --inflight_;
+    }
+    cv_.notify_all();
+}
+
+#else  // J2_URING_SUPPORTED
+
+struct UringFileWriter::Ring {};
+
+bool UringFileWriter::supported() { return false; }
+UringFileWriter::UringFileWriter() { spdlog::throw_spdlog_ex("io_uring is not supported on this platform"); }
+UringFileWriter::~UringFileWriter() = default;
+void UringFileWriter::open(const std::string&, bool) {}
+void UringFileWriter::reopen(bool) {}
+void UringFileWriter::write(const spdlog::memory_buf_t&) {}
+void UringFileWriter::flush() {}
+void UringFileWriter::close() {}
+FileWriter::SyncTicket UringFileWriter::beginSync() { return {}; }
+void UringFileWriter::endSync(const SyncTicket&) {}
+void UringFileWriter::submitCurrent_(bool) {}
+void UringFileWriter::submit_() {}
+void UringFileWriter::followTruncate_() {}
+void UringFileWriter::checkTruncate_() {}
+void UringFileWriter::reportOnce_(const char*, int) {}
+int UringFileWriter::acquire_() { return -1; }
+void UringFileWriter::drain_() {}
+void UringFileWriter::reap_() {}
+void UringFileWriter::complete_(std::uint64_t, int) {}
+
+#endif // J2_URING_SUPPORTED
+
+} // namespace sinks
+} // namespace j2
@@ -6,16 +6,166 @@
 #endif
 
 #include <spdlog/spdlog.h>
+#include "j2/LoggerHandle.hpp"
+#include "j2/BinaryLog.hpp"
+#include "j2/RateLimit.hpp"
+#include "j2/Backtrace.hpp"
+#include "j2/StructuredFormatter.hpp"
 
 // hello_logger 전용 초단축 로깅 매크로
 #ifndef hname
 #define hname "hello_logger"
 #endif
 
-#define ht(...) SPDLOG_LOGGER_TRACE   (spdlog::get(hname), __VA_ARGS__)  // trace
-#define hd(...) SPDLOG_LOGGER_DEBUG   (spdlog::get(hname), __VA_ARGS__)  // debug
-#define hi(...) SPDLOG_LOGGER_INFO    (spdlog::get(hname), __VA_ARGS__)  // info
-#define hw(...) SPDLOG_LOGGER_WARN    (spdlog::get(hname), __VA_ARGS__)  // warn
-#define he(...) SPDLOG_LOGGER_ERROR   (spdlog::get(hname), __VA_ARGS__)  // error
-#define hc(...) SPDLOG_LOGGER_CRITICAL(spdlog::get(hname), __VA_ARGS__)  // critical
+// 호출 지점마다 thread_local 핸들을 두고, 레벨 검사 후에만 포맷/싱크로 진입
+// (로거 미등록 시 조용히 무시, FILE_FORMAT=binary 면 ALL 파일은 텍스트 포맷 없이 기록)
+// BACKTRACE_DEPTH > 0 이면 걸러진 레코드는 원시 형태로 스레드 링에 보관, 트리거 레벨이면 링부터 기록
+#define J2_HLOG_(lvl, ...)                                                          \
+    do {                                                                            \
+        static thread_local ::j2::LoggerHandle j2_handle_(hname);                   \
+        static thread_local ::j2::binlog::CallSite j2_site_;                        \
+        spdlog::logger* j2_logger_ = j2_handle_.get();                              \
+        if (!j2_logger_) break;                                                     \
+        spdlog::source_loc j2_loc_{__FILE__, __LINE__, SPDLOG_FUNCTION};            \
+        if (!j2_logger_->should_log(lvl)) {                                         \
+            if (auto* j2_bt_ = j2_handle_.backtrace())                              \
+                ::j2::backtrace::capture(*j2_bt_, lvl, j2_loc_, __VA_ARGS__);       \
+            break;                                                                  \
+        }                                                                           \
+        if (auto* j2_bt_ = j2_handle_.backtrace())                                  \
+            ::j2::backtrace::onEmit(*j2_bt_, lvl);                                  \
+        if (auto* j2_bin_ = j2_handle_.binary())                                    \
+            ::j2::binlog::dispatch(*j2_bin_, j2_site_, lvl, j2_loc_, __VA_ARGS__);  \
+        else                                                                        \
+            j2_logger_->log(j2_loc_, lvl, __VA_ARGS__);                             \
+    } while (0)
 
+// 출력 제한 변형: 호출 지점마다 static SiteLimiter(스레드 공유, 원자 연산만) 하나.
+// n이 0이면 INI 기본값(RATE_LIMIT_*). 억제된 수는 다음 출력 줄 끝에 " [N similar suppressed]"
+// 백트레이스: 레벨로 걸러진 호출은 링에 보관(제한 전), 실제로 출력되는 레코드만 트리거(억제분은 출력이 아님)
+#define J2_HLOG_LIMITED_(lvl, kind, n, ...)                                                 \
+    do {                                                                                    \
+        static thread_local ::j2::LoggerHandle j2_handle_(hname);                           \
+        static thread_local ::j2::binlog::CallSite j2_site_;                                \
+        static ::j2::SiteLimiter j2_limit_(__FILE__, __LINE__);                             \
+        spdlog::logger* j2_logger_ = j2_handle_.get();                                      \
+        if (!j2_logger_) break;                                                             \
+        spdlog::source_loc j2_loc_{__FILE__, __LINE__, SPDLOG_FUNCTION};                    \
+        if (!j2_logger_->should_log(lvl)) {                                                 \
+            if (auto* j2_bt_ = j2_handle_.backtrace())                                      \
+                ::j2::backtrace::capture(*j2_bt_, lvl, j2_loc_, __VA_ARGS__);               \
+            break;                                                                          \
+        }                                                                                   \
+        std::uint64_t j2_suppressed_ = 0;                                                   \
+        if (!j2_limit_.allow(::j2::SiteLimiter::Kind::kind, (n), j2_suppressed_)) break;    \
+        if (auto* j2_bt_ = j2_handle_.backtrace())                                          \
+            ::j2::backtrace::onEmit(*j2_bt_, lvl);                                          \
+        if (j2_suppressed_)                                                                 \
+            ::j2::logSuppressed(*j2_logger_, j2_loc_, lvl, j2_suppressed_, __VA_ARGS__);    \
+        else if (auto* j2_bin_ = j2_handle_.binary())                                       \
+            ::j2::binlog::dispatch(*j2_bin_, j2_site_, lvl, j2_loc_, __VA_ARGS__);          \
+        else                                                                                \
+            j2_logger_->log(j2_loc_, lvl, __VA_ARGS__);                                     \
+    } while (0)
+
+// 키/값 필드 변형: hX_kv(j2::fields("user", id, "ms", ms), "fmt", args...)
+// FILE_FORMAT=json|logfmt 파일에는 필드로, 그 외 싱크에는 메시지 뒤 " key=value" 텍스트로 기록
+// (바이너리 채널은 거치지 않음). 걸러진 호출은 BACKTRACE_DEPTH 링에 메시지만 보관(필드는 평가하지 않음),
+// 출력되는 레코드는 트리거 레벨이면 링부터 기록
+#define J2_HLOG_KV_(lvl, fieldsExpr, ...)                                          \
+    do {                                                                            \
+        static thread_local ::j2::LoggerHandle j2_handle_(hname);                   \
+        spdlog::logger* j2_logger_ = j2_handle_.get();                              \
+        if (!j2_logger_) break;                                                     \
+        spdlog::source_loc j2_loc_{__FILE__, __LINE__, SPDLOG_FUNCTION};            \
+        if (!j2_logger_->should_log(lvl)) {                                         \
+            if (auto* j2_bt_ = j2_handle_.backtrace())                              \
+                ::j2::backtrace::capture(*j2_bt_, lvl, j2_loc_, __VA_ARGS__);       \
+            break;                                                                  \
+        }                                                                           \
+        if (auto* j2_bt_ = j2_handle_.backtrace())                                  \
+            ::j2::backtrace::onEmit(*j2_bt_, lvl);                                  \
+        ::j2::logFields(*j2_logger_, j2_loc_, lvl, fieldsExpr, __VA_ARGS__);        \
+    } while (0)
+
+// 레벨별 변형: X_every(n, ...) n번째마다, X_rate(n, ...) 초당 n개(토큰 버킷), X_first(n, ...) 처음 n개만,
+//             X_kv(fields, ...) 키/값 필드
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define ht(...) J2_HLOG_(spdlog::level::trace,    __VA_ARGS__)  // trace
+#define ht_every(n, ...) J2_HLOG_LIMITED_(spdlog::level::trace,    everyN, n, __VA_ARGS__)
+#define ht_rate(n, ...)  J2_HLOG_LIMITED_(spdlog::level::trace,    perSecond, n, __VA_ARGS__)
+#define ht_first(n, ...) J2_HLOG_LIMITED_(spdlog::level::trace,    firstN, n, __VA_ARGS__)
+#define ht_kv(f, ...)    J2_HLOG_KV_(spdlog::level::trace,    f, __VA_ARGS__)
+#else
+#define ht(...) (void)0
+#define ht_every(n, ...) (void)0
+#define ht_rate(n, ...)  (void)0
+#define ht_first(n, ...) (void)0
+#define ht_kv(f, ...)    (void)0
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define hd(...) J2_HLOG_(spdlog::level::debug,    __VA_ARGS__)  // debug
+#define hd_every(n, ...) J2_HLOG_LIMITED_(spdlog::level::debug,    everyN, n, __VA_ARGS__)
+#define hd_rate(n, ...)  J2_HLOG_LIMITED_(spdlog::level::debug,    perSecond, n, __VA_ARGS__)
+#define hd_first(n, ...) J2_HLOG_LIMITED_(spdlog::level::debug,    firstN, n, __VA_ARGS__)
+#define hd_kv(f, ...)    J2_HLOG_KV_(spdlog::level::debug,    f, __VA_ARGS__)
+#else
+#define hd(...) (void)0
+#define hd_every(n, ...) (void)0
+#define hd_rate(n, ...)  (void)0
+#define hd_first(n, ...) (void)0
+#define hd_kv(f, ...)    (void)0
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define hi(...) J2_HLOG_(spdlog::level::info,     __VA_ARGS__)  // info
+#define hi_every(n, ...) J2_HLOG_LIMITED_(spdlog::level::info,     everyN, n, __VA_ARGS__)
+#define hi_rate(n, ...)  J2_HLOG_LIMITED_(spdlog::level::info,     perSecond, n, __VA_ARGS__)
+#define hi_first(n, ...) J2_HLOG_LIMITED_(spdlog::level::info,     firstN, n, __VA_ARGS__)
+#define hi_kv(f, ...)    J2_HLOG_KV_(spdlog::level::info,     f, __VA_ARGS__)
+#else
+#define hi(...) (void)0
+#define hi_every(n, ...) (void)0
+#define hi_rate(n, ...)  (void)0
+#define hi_first(n, ...) (void)0
+#define hi_kv(f, ...)    (void)0
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define hw(...) J2_HLOG_(spdlog::level::warn,     __VA_ARGS__)  // warn
+#define hw_every(n, ...) J2_HLOG_LIMITED_(spdlog::level::warn,     everyN, n, __VA_ARGS__)
+#define hw_rate(n, ...)  J2_HLOG_LIMITED_(spdlog::level::warn,     perSecond, n, __VA_ARGS__)
+#define hw_first(n, ...) J2_HLOG_LIMITED_(spdlog::level::warn,     firstN, n, __VA_ARGS__)
+#define hw_kv(f, ...)    J2_HLOG_KV_(spdlog::level::warn,     f, __VA_ARGS__)
+#else
+#define hw(...) (void)0
+#define hw_every(n, ...) (void)0
+#define hw_rate(n, ...)  (void)0
+#define hw_first(n, ...) (void)0
+#define hw_kv(f, ...)    (void)0
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define he(...) J2_HLOG_(spdlog::level::err,      __VA_ARGS__)  // error
+#define he_every(n, ...) J2_HLOG_LIMITED_(spdlog::level::err,      everyN, n, __VA_ARGS__)
+#define he_rate(n, ...)  J2_HLOG_LIMITED_(spdlog::level::err,      perSecond, n, __VA_ARGS__)
+#define he_first(n, ...) J2_HLOG_LIMITED_(spdlog::level::err,      firstN, n, __VA_ARGS__)
+#define he_kv(f, ...)    J2_HLOG_KV_(spdlog::level::err,      f, __VA_ARGS__)
+#else
+#define he(...) (void)0
+#define he_every(n, ...) (void)0
+#define he_rate(n, ...)  (void)0
+#define he_first(n, ...) (void)0
+#define he_kv(f, ...)    (void)0
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_CRITICAL
+#define hc(...) J2_HLOG_(spdlog::level::critical, __VA_ARGS__)  // critical
+#define hc_every(n, ...) J2_HLOG_LIMITED_(spdlog::level::critical, everyN, n, __VA_ARGS__)
+#define hc_rate(n, ...)  J2_HLOG_LIMITED_(spdlog::level::critical, perSecond, n, __VA_ARGS__)
+#define hc_first(n, ...) J2_HLOG_LIMITED_(spdlog::level::critical, firstN, n, __VA_ARGS__)
+#define hc_kv(f, ...)    J2_HLOG_KV_(spdlog::level::critical, f, __VA_ARGS__)
+#else
+#define hc(...) (void)0
+#define hc_every(n, ...) (void)0
+#define hc_rate(n, ...)  (void)0
+#define hc_first(n, ...) (void)0
+#define hc_kv(f, ...)    (void)0
+#endif
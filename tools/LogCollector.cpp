@@ -0,0 +1,125 @@
+// SHM_ROLE=collector: 공유 메모리 링(SHM_NAME)에 모인 여러 프로세스의 레코드를 LoggerManager 싱크로 기록
+//
+// 사용법:
+//   j2_log_collector --ini config.ini [--section Log] [--name collector] [--env VAR]
+//                    [--no-pid] [--unlink]
+//
+// - 싱크/패턴/회전/디스크 감시/자동 리로드는 --ini 섹션 설정을 그대로 사용(섹션에 SHM_ROLE=collector 필요)
+// - 레코드는 생산자 시각/스레드 id/로거 이름(%n) 그대로, 본문 앞에 "[pid N] " (--no-pid로 끔)
+// - 생산자가 슬롯을 잡은 채 죽으면 SHM_STALL_MS 뒤(또는 pid가 없어지면 즉시) 건너뜀
+// - SIGINT/SIGTERM: 남은 레코드를 모두 기록하고 종료, --unlink 이면 세그먼트 삭제
+
+#include "j2/LoggerManager.hpp"
+#include "j2/ShmRing.hpp"
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/fmt/fmt.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::atomic<bool> g_stop{false};
+
+void onSignal(int) { g_stop.store(true); }
+
+void usage() {
+    std::cerr << "usage: j2_log_collector --ini file [--section Log] [--name collector] [--env VAR]\n"
+                 "                        [--no-pid] [--unlink]\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    std::string ini, section = "Log", name = "collector", env;
+    bool tagPid = true, unlinkAtExit = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) { usage(); std::exit(2); }
+            return argv[++i];
+        };
+        if (a == "--ini") ini = next();
+        else if (a == "--section") section = next();
+        else if (a == "--name") name = next();
+        else if (a == "--env") env = next();
+        else if (a == "--no-pid") tagPid = false;
+        else if (a == "--unlink") unlinkAtExit = true;
+        else if (a == "-h" || a == "--help") { usage(); return 0; }
+        else { usage(); return 2; }
+    }
+    if (ini.empty()) { usage(); return 2; }
+
+    j2::LoggerManager mgr;
+    if (!mgr.init(ini, section, name, env)) return 2;
+    auto log = mgr.getLogger();
+
+    if (mgr.shmRole() != j2::LoggerManager::ShmRole::collector) {
+        std::cerr << "j2_log_collector: [" << section << "] needs SHM_NAME and SHM_ROLE=collector\n";
+        return 2;
+    }
+    const auto opts = mgr.shmOptions();
+    j2::ShmRing ring;
+    if (!ring.open(opts) || !ring.attachConsumer()) {
+        std::cerr << "j2_log_collector: " << opts.name << ": " << ring.error() << "\n";
+        return 1;
+    }
+    log->info("Collecting from shared memory {} ({} slots x {} bytes).", opts.name, ring.slots(), ring.slotBytes());
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    spdlog::memory_buf_t text;
+    auto write = [&](const j2::ShmRing::Record& r) {
+        text.clear();
+        if (tagPid) fmt::format_to(fmt::appender(text), "[pid {}] ", r.pid);
+        text.append(r.payload.data(), r.payload.data() + r.payload.size());
+        if (r.truncated) text.append(std::string_view(" [truncated]"));
+
+        auto tp = spdlog::log_clock::time_point(
+            std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(r.ns)));
+        spdlog::details::log_msg msg(tp, spdlog::source_loc{},
+                                     spdlog::string_view_t(r.logger.data(), r.logger.size()), r.level,
+                                     spdlog::string_view_t(text.data(), text.size()));
+        msg.thread_id = static_cast<std::size_t>(r.tid);
+        mgr.forward(msg);
+    };
+
+    // 비어 있으면 짧게 쉬고, 주기적으로 버림/포기 수 보고
+    constexpr std::size_t kBatch = 1024;
+    std::uint64_t droppedSeen = ring.dropped(), abandonedSeen = ring.abandoned();
+    auto nextReport = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!g_stop.load()) {
+        if (ring.poll(write, kBatch) == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now < nextReport) continue;
+        nextReport = now + std::chrono::seconds(5);
+        std::uint64_t dropped = ring.dropped(), abandoned = ring.abandoned();
+        if (dropped > droppedSeen) {
+            log->warn("Shared memory ring full: {} records dropped by producers (total {}).",
+                      dropped - droppedSeen, dropped);
+        }
+        if (abandoned > abandonedSeen) {
+            log->warn("Skipped {} unpublished slots from stalled or crashed producers (total {}).",
+                      abandoned - abandonedSeen, abandoned);
+        }
+        droppedSeen = dropped;
+        abandonedSeen = abandoned;
+    }
+
+    while (ring.poll(write, kBatch) > 0) {}
+    log->info("Collector stopped (dropped {}, abandoned {}).", ring.dropped(), ring.abandoned());
+    log->flush();
+    ring.close();
+    if (unlinkAtExit) j2::ShmRing::unlink(opts.name);
+    return 0;
+}
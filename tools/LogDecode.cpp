@@ -0,0 +1,308 @@
+// FILE_FORMAT=binary 로 기록된 ALL 로그를 텍스트로 복원
+//
+// 사용법:
+//   j2_log_decode [--ini config.ini [--section Log]] [--pattern "<PATTERN_FILE>"] [--utc|--local]
+//                 [--from "2025-01-31 12:00:00"] [--to "2025-01-31 13:00:00"]
+//                 [--level warn] <file|-> ...
+//
+// - 패턴/시간 모드는 --ini의 PATTERN_FILE/TIME_MODE를 기본으로 하고, --pattern/--utc/--local로 덮어씀
+// - --from/--to 는 TIME_MODE 기준 시각(또는 epoch 초), --level 은 해당 레벨 이상만 출력
+// - 압축된 백업은 zcat all.1.log.gz | j2_log_decode - 처럼 표준 입력으로 전달
+
+#include "j2/BinaryLog.hpp"
+#include "j2/FastPatternFormatter.hpp"
+#include "SimpleIni.h"
+#include "TimeParse.hpp"
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/pattern_formatter.h>
+#include <fmt/args.h>
+
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+namespace bl = j2::binlog;
+namespace jt = j2::tools;
+
+struct Options {
+    std::string pattern = "[%Y-%m-%d %H:%M:%S.%e] [%l] [%t] %v";
+    bool utc = false;
+    std::int64_t fromNs = std::numeric_limits<std::int64_t>::min();
+    std::int64_t toNs   = std::numeric_limits<std::int64_t>::max();
+    spdlog::level::level_enum minLevel = spdlog::level::trace;
+    std::vector<std::string> files;
+};
+
+void usage() {
+    std::cerr << "usage: j2_log_decode [--ini file [--section Log]] [--pattern P] [--utc|--local]\n"
+                 "                     [--from TIME] [--to TIME] [--level LEVEL] <file|-> ...\n"
+                 "  TIME: \"YYYY-MM-DD HH:MM:SS\" (TIME_MODE) or epoch seconds\n";
+}
+
+// 레코드 단위 읽기(잘린 마지막 레코드는 false)
+class Reader {
+public:
+    explicit Reader(std::istream& in) : in_(in) {}
+
+    template <typename T>
+    bool get(T& v) {
+        return static_cast<bool>(in_.read(reinterpret_cast<char*>(&v), sizeof(T)));
+    }
+
+    bool str(std::string& s, std::size_t n) {
+        s.resize(n);
+        return n == 0 || static_cast<bool>(in_.read(&s[0], static_cast<std::streamsize>(n)));
+    }
+
+    template <typename Len>
+    bool lenStr(std::string& s) {
+        Len n = 0;
+        return get(n) && str(s, n);
+    }
+
+private:
+    std::istream& in_;
+};
+
+class Decoder {
+public:
+    explicit Decoder(const Options& opt) : opt_(opt) {
+        auto tt = opt.utc ? spdlog::pattern_time_type::utc : spdlog::pattern_time_type::local;
+        formatter_ = j2::makePatternFormatter(opt.pattern, tt, opt.utc, std::string("\n"));
+    }
+
+    // 0: 정상, 1: 형식 오류/잘림
+    int run(std::istream& in, const std::string& name) {
+        Reader r(in);
+        sites_.clear();
+        logger_.clear();
+        bool first = true;
+
+        for (;;) {
+            std::uint8_t type = 0;
+            if (!r.get(type)) return 0;  // EOF
+
+            if (first && type != bl::kSession) {
+                std::cerr << "j2_log_decode: " << name << ": not a binary log (FILE_FORMAT=binary)\n";
+                return 1;
+            }
+            first = false;
+
+            bool ok = true;
+            switch (type) {
+            case bl::kSession: ok = readSession(r); break;
+            case bl::kSite:    ok = readSite(r);    break;
+            case bl::kEvent:   ok = readEvent(r);   break;
+            case bl::kText:    ok = readText(r);    break;
+            default:
+                std::cerr << "j2_log_decode: " << name << ": unknown record type " << unsigned(type) << "\n";
+                return 1;
+            }
+            if (!ok) {
+                std::cerr << "j2_log_decode: " << name << ": truncated record (stopped)\n";
+                return 1;
+            }
+        }
+    }
+
+private:
+    struct Site {
+        std::string fmt, file, func;
+        std::uint32_t line = 0;
+    };
+
+    bool readSession(Reader& r) {
+        char magic[4];
+        std::uint16_t ver = 0;
+        if (!r.get(magic) || !r.get(ver) || !r.lenStr<std::uint16_t>(logger_)) return false;
+        if (std::string(magic, 4) != std::string(bl::kMagic, 4) || ver != bl::kVersion) return false;
+        sites_.clear();  // 세션마다 사전 재시작(다른 프로세스가 이어 쓴 경우)
+        return true;
+    }
+
+    bool readSite(Reader& r) {
+        std::uint32_t id = 0;
+        Site s;
+        if (!r.get(id) || !r.get(s.line) || !r.lenStr<std::uint16_t>(s.file) ||
+            !r.lenStr<std::uint16_t>(s.func) || !r.lenStr<std::uint32_t>(s.fmt)) {
+            return false;
+        }
+        sites_[id] = std::move(s);
+        return true;
+    }
+
+    bool readHead(Reader& r, std::int64_t& ns, std::uint8_t& lvl, std::uint64_t& tid) {
+        return r.get(ns) && r.get(lvl) && r.get(tid);
+    }
+
+    bool readEvent(Reader& r) {
+        std::int64_t ns = 0;
+        std::uint8_t lvl = 0;
+        std::uint64_t tid = 0;
+        std::uint32_t id = 0;
+        std::uint8_t argc = 0;
+        if (!readHead(r, ns, lvl, tid) || !r.get(id) || !r.get(argc)) return false;
+
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+        std::vector<std::string> shown;  // 포맷 실패 시 원시 출력용
+        for (unsigned i = 0; i < argc; ++i) {
+            std::uint8_t tag = 0;
+            if (!r.get(tag)) return false;
+            switch (tag) {
+            case bl::kI64:  { std::int64_t v;  if (!r.get(v)) return false; store.push_back(v); shown.push_back(std::to_string(v)); break; }
+            case bl::kU64:  { std::uint64_t v; if (!r.get(v)) return false; store.push_back(v); shown.push_back(std::to_string(v)); break; }
+            case bl::kF64:  { double v;        if (!r.get(v)) return false; store.push_back(v); shown.push_back(fmt::format("{}", v)); break; }
+            case bl::kBool: { std::uint8_t v;  if (!r.get(v)) return false; store.push_back(v != 0); shown.push_back(v ? "true" : "false"); break; }
+            case bl::kChar: { char v;          if (!r.get(v)) return false; store.push_back(v); shown.push_back(std::string(1, v)); break; }
+            case bl::kPtr:  { std::uint64_t v; if (!r.get(v)) return false;
+                              store.push_back(reinterpret_cast<const void*>(static_cast<std::uintptr_t>(v)));
+                              shown.push_back(fmt::format("{:#x}", v)); break; }
+            case bl::kStr:  { std::string v;   if (!r.lenStr<std::uint32_t>(v)) return false; store.push_back(v); shown.push_back(std::move(v)); break; }
+            default: return false;
+            }
+        }
+
+        if (!wanted(ns, lvl)) return true;
+
+        auto it = sites_.find(id);
+        if (it == sites_.end()) {
+            emit(ns, lvl, tid, fmt::format("<unknown site {}>", id), {});
+            return true;
+        }
+        const Site& s = it->second;
+        std::string text;
+        try {
+            text = fmt::vformat(s.fmt, store);
+        } catch (const std::exception&) {
+            text = s.fmt;
+            for (auto& a : shown) text += " | " + a;
+        }
+        emit(ns, lvl, tid, text, spdlog::source_loc{s.file.c_str(), static_cast<int>(s.line), s.func.c_str()});
+        return true;
+    }
+
+    bool readText(Reader& r) {
+        std::int64_t ns = 0;
+        std::uint8_t lvl = 0;
+        std::uint64_t tid = 0;
+        std::string text;
+        if (!readHead(r, ns, lvl, tid) || !r.lenStr<std::uint32_t>(text)) return false;
+        if (wanted(ns, lvl)) emit(ns, lvl, tid, text, {});
+        return true;
+    }
+
+    bool wanted(std::int64_t ns, std::uint8_t lvl) const {
+        return ns >= opt_.fromNs && ns <= opt_.toNs && lvl >= static_cast<std::uint8_t>(opt_.minLevel);
+    }
+
+    void emit(std::int64_t ns, std::uint8_t lvl, std::uint64_t tid, const std::string& text,
+              spdlog::source_loc loc) {
+        auto tp = spdlog::log_clock::time_point(
+            std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(ns)));
+        auto level = lvl < spdlog::level::n_levels ? static_cast<spdlog::level::level_enum>(lvl)
+                                                   : spdlog::level::off;
+        spdlog::details::log_msg msg(tp, loc, logger_, level, text);
+        msg.thread_id = static_cast<std::size_t>(tid);
+
+        buf_.clear();
+        formatter_->format(msg, buf_);
+        std::fwrite(buf_.data(), 1, buf_.size(), stdout);
+    }
+
+    const Options& opt_;
+    std::unique_ptr<spdlog::formatter> formatter_;
+    std::unordered_map<std::uint32_t, Site> sites_;
+    std::string logger_;
+    spdlog::memory_buf_t buf_;
+};
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    std::string ini, section = "Log", pattern, from, to;
+    int timeMode = -1;  // -1: INI/기본, 0: local, 1: utc
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) { usage(); std::exit(2); }
+            return argv[++i];
+        };
+        if (a == "--ini") ini = next();
+        else if (a == "--section") section = next();
+        else if (a == "--pattern") pattern = next();
+        else if (a == "--utc") timeMode = 1;
+        else if (a == "--local") timeMode = 0;
+        else if (a == "--from") from = next();
+        else if (a == "--to") to = next();
+        else if (a == "--level") {
+            auto lv = spdlog::level::from_str(next());
+            opt.minLevel = lv;
+        }
+        else if (a == "-h" || a == "--help") { usage(); return 0; }
+        else if (a.size() > 1 && a[0] == '-' && a != "-") { usage(); return 2; }
+        else opt.files.push_back(a);
+    }
+    if (opt.files.empty()) { usage(); return 2; }
+
+    if (!ini.empty()) {
+        CSimpleIniA cfg;
+        cfg.SetUnicode();
+        if (cfg.LoadFile(ini.c_str()) < 0) {
+            std::cerr << "j2_log_decode: failed to load " << ini << "\n";
+            return 2;
+        }
+        opt.pattern = cfg.GetValue(section.c_str(), "PATTERN_FILE", opt.pattern.c_str());
+        std::string tm = cfg.GetValue(section.c_str(), "TIME_MODE", "local");
+        opt.utc = (tm == "utc" || tm == "UTC");
+    }
+    if (!pattern.empty()) opt.pattern = pattern;
+    if (timeMode >= 0) opt.utc = (timeMode == 1);
+
+    if (!from.empty() && !jt::parseTime(from, opt.utc, opt.fromNs)) {
+        std::cerr << "j2_log_decode: invalid --from: " << from << "\n";
+        usage();
+        return 2;
+    }
+    if (!to.empty()) {
+        if (!jt::parseTime(to, opt.utc, opt.toNs)) {
+            std::cerr << "j2_log_decode: invalid --to: " << to << "\n";
+            usage();
+            return 2;
+        }
+        opt.toNs += 999999999LL;  // 초 단위 입력: 해당 초 끝까지 포함
+    }
+
+    Decoder dec(opt);
+    int rc = 0;
+    for (const auto& f : opt.files) {
+        if (f == "-") {
+            rc |= dec.run(std::cin, "<stdin>");
+            continue;
+        }
+        std::ifstream in(f, std::ios::binary);
+        if (!in) {
+            std::cerr << "j2_log_decode: cannot open " << f << "\n";
+            rc |= 1;
+            continue;
+        }
+        rc |= dec.run(in, f);
+    }
+    std::fflush(stdout);
+    return rc;
+}
@@ -0,0 +1,408 @@
+// FILE_INDEX 사이드카 색인(*.idx)으로 회전 로그 묶음에서 시간/레벨 범위의 줄만 빠르게 출력
+//
+// 사용법:
+//   j2_log_query [--ini config.ini [--section Log]] [--alerts] [--utc|--local]
+//                [--from "2025-01-31 12:00:00"] [--to "2025-01-31 12:00:30"]
+//                [--level warn] [--stats] [file ...]
+//
+// - 파일을 주지 않으면 --ini의 ALL_PATH(--alerts: ALERTS_PATH)와 ALL_MAX_FILES/ALERT_MAX_FILES,
+//   ROTATE_NAMING으로 회전 묶음 전체를 오래된 파일부터 조회(.gz/.zst 백업 포함)
+// - 색인 블록의 시각 범위가 --from/--to 밖이거나 --level 이상 레벨이 없으면 읽지 않고,
+//   블록 전체가 조건 안이면 그대로 출력. 일부만 걸친 블록과 색인이 없는 구간은 줄 단위로 거름
+// - 줄 해석: 앞부분의 "YYYY-MM-DD HH:MM:SS[.fff]"(RFC 3339의 T/Z/+hh:mm 포함, 그 외는 TIME_MODE)와
+//   처음 나오는 레벨 이름. 시각이 없는 줄(여러 줄 메시지)은 앞 줄을 따르고, 레벨 이름이 없는 줄은 통과
+// - --stats: 읽은 블록/바이트를 표준 에러로 출력
+
+#include "j2/LogIndex.hpp"
+#include "j2/RotationWorker.hpp"
+#include "SimpleIni.h"
+#include "TimeParse.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace js = j2::sinks;
+namespace jt = j2::tools;
+
+struct Options {
+    bool utc = false;
+    std::int64_t fromNs = std::numeric_limits<std::int64_t>::min();
+    std::int64_t toNs   = std::numeric_limits<std::int64_t>::max();
+    int minLevel = 0;   // spdlog::level::level_enum 값
+    bool stats = false;
+    std::vector<std::string> files;
+};
+
+struct Stats {
+    std::size_t files = 0;
+    std::size_t blocks = 0;
+    std::size_t skipped = 0;
+    std::uint64_t bytesRead = 0;
+    std::uint64_t bytesTotal = 0;
+};
+
+void usage() {
+    std::cerr << "usage: j2_log_query [--ini file [--section Log]] [--alerts] [--utc|--local]\n"
+                 "                    [--from TIME] [--to TIME] [--level LEVEL] [--stats] [file ...]\n"
+                 "  TIME: \"YYYY-MM-DD HH:MM:SS\" (TIME_MODE) or epoch seconds\n";
+}
+
+// 레벨 이름(spdlog 이름 + 흔한 줄임말), 짧은 이름이 긴 이름의 앞부분이면 긴 것을 먼저
+struct LevelName {
+    const char* name;
+    int level;
+};
+constexpr LevelName kLevelNames[] = {
+    {"trace", 0}, {"debug", 1}, {"info", 2}, {"warning", 3}, {"warn", 3},
+    {"error", 4}, {"err", 4}, {"critical", 5}, {"crit", 5},
+};
+
+int parseLevel(std::string s) {
+    for (auto& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    for (const auto& l : kLevelNames) {
+        if (s == l.name) return l.level;
+    }
+    return -1;
+}
+
+// 줄 단위 필터: 시각/레벨 해석(시각 없는 줄은 앞 줄을 따름, 구간 시작은 통과)
+class LineFilter {
+public:
+    explicit LineFilter(const Options& opt) : opt_(opt) {}
+
+    void reset() { keep_ = true; }
+
+    bool keep(const char* p, std::size_t n) {
+        std::int64_t ns = 0;
+        if (lineTime(p, std::min<std::size_t>(n, 64), ns)) {
+            const int lvl = lineLevel(p, std::min<std::size_t>(n, 160));
+            keep_ = ns >= opt_.fromNs && ns <= opt_.toNs && (lvl < 0 || lvl >= opt_.minLevel);
+        }
+        return keep_;
+    }
+
+private:
+    static int num(const char* p, int len) {
+        int v = 0;
+        for (int i = 0; i < len; ++i) v = v * 10 + (p[i] - '0');
+        return v;
+    }
+
+    static bool digitsAt(const char* p, std::size_t n, std::size_t at, int len) {
+        if (at + static_cast<std::size_t>(len) > n) return false;
+        for (int i = 0; i < len; ++i) {
+            if (!std::isdigit(static_cast<unsigned char>(p[at + i]))) return false;
+        }
+        return true;
+    }
+
+    bool lineTime(const char* p, std::size_t n, std::int64_t& ns) {
+        for (std::size_t i = 0; i + 19 <= n; ++i) {
+            const char* s = p + i;
+            if (!digitsAt(p, n, i, 4) || s[4] != '-' || !digitsAt(p, n, i + 5, 2) || s[7] != '-' ||
+                !digitsAt(p, n, i + 8, 2) || (s[10] != ' ' && s[10] != 'T') || !digitsAt(p, n, i + 11, 2) ||
+                s[13] != ':' || !digitsAt(p, n, i + 14, 2) || s[16] != ':' || !digitsAt(p, n, i + 17, 2)) {
+                continue;
+            }
+            const int Y = num(s, 4), M = num(s + 5, 2), D = num(s + 8, 2);
+            const int h = num(s + 11, 2), m = num(s + 14, 2), sec = num(s + 17, 2);
+
+            std::size_t k = i + 19;
+            std::int64_t frac = 0;
+            if (k < n && p[k] == '.') {
+                int digits = 0;
+                for (++k; k < n && std::isdigit(static_cast<unsigned char>(p[k])); ++k) {
+                    if (digits < 9) { frac = frac * 10 + (p[k] - '0'); ++digits; }
+                }
+                for (; digits < 9; ++digits) frac *= 10;
+            }
+
+            std::int64_t secs = 0;
+            bool zoned = false;
+            std::int64_t offset = 0;
+            if (k < n && p[k] == 'Z') {
+                zoned = true;
+            } else if (k + 3 <= n && (p[k] == '+' || p[k] == '-') && digitsAt(p, n, k + 1, 2)) {
+                std::size_t mm = k + 3;
+                if (mm < n && p[mm] == ':') ++mm;
+                if (digitsAt(p, n, mm, 2)) {
+                    zoned = true;
+                    offset = (num(p + k + 1, 2) * 60 + num(p + mm, 2)) * 60;
+                    if (p[k] == '-') offset = -offset;
+                }
+            }
+            const std::int64_t hourSecs = static_cast<std::int64_t>(m) * 60 + sec;
+            if (zoned || opt_.utc) {
+                secs = jt::daysFromCivil(Y, static_cast<unsigned>(M), static_cast<unsigned>(D)) * 86400 +
+                       h * 3600 + hourSecs - offset;
+            } else {
+                secs = localHour(Y, M, D, h) + hourSecs;
+            }
+            ns = secs * 1000000000LL + frac;
+            return true;
+        }
+        return false;
+    }
+
+    // 로컬 시각의 정시 epoch(시간 단위 캐시: mktime 호출을 줄임)
+    std::int64_t localHour(int Y, int M, int D, int h) {
+        const std::int64_t key = ((static_cast<std::int64_t>(Y) * 100 + M) * 100 + D) * 100 + h;
+        if (key != hourKey_) {
+            std::tm tm{};
+            tm.tm_year = Y - 1900;
+            tm.tm_mon = M - 1;
+            tm.tm_mday = D;
+            tm.tm_hour = h;
+            tm.tm_isdst = -1;
+            hourKey_ = key;
+            hourEpoch_ = static_cast<std::int64_t>(std::mktime(&tm));
+        }
+        return hourEpoch_;
+    }
+
+    // 처음 나오는 레벨 이름(앞뒤가 영숫자가 아닌 단어), 없으면 -1
+    static int lineLevel(const char* p, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i > 0 && std::isalnum(static_cast<unsigned char>(p[i - 1]))) continue;
+            const char c = static_cast<char>(std::tolower(static_cast<unsigned char>(p[i])));
+            if (c != 't' && c != 'd' && c != 'i' && c != 'w' && c != 'e' && c != 'c') continue;
+            for (const auto& l : kLevelNames) {
+                const std::size_t len = std::strlen(l.name);
+                if (i + len > n) continue;
+                bool match = true;
+                for (std::size_t j = 0; j < len && match; ++j) {
+                    match = std::tolower(static_cast<unsigned char>(p[i + j])) == l.name[j];
+                }
+                if (match && (i + len == n || !std::isalnum(static_cast<unsigned char>(p[i + len])))) {
+                    return l.level;
+                }
+            }
+        }
+        return -1;
+    }
+
+    const Options& opt_;
+    bool keep_ = true;
+    std::int64_t hourKey_ = -1;
+    std::int64_t hourEpoch_ = 0;
+};
+
+class Query {
+public:
+    explicit Query(const Options& opt) : opt_(opt), filter_(opt) {
+        for (int l = opt.minLevel; l < 16; ++l) wantMask_ |= static_cast<std::uint16_t>(1u << l);
+    }
+
+    const Stats& stats() const { return stats_; }
+
+    // 0: 정상, 1: 열 수 없음
+    int run(const std::string& path) {
+        js::LogFileReader reader;
+        if (!reader.open(path)) {
+            std::cerr << "j2_log_query: cannot open " << path << "\n";
+            return 1;
+        }
+        ++stats_.files;
+        const std::uint64_t size = reader.size();
+
+        std::vector<js::LogIndexBlock> blocks;
+        js::loadLogIndex(path, size, blocks);
+        stats_.blocks += blocks.size();
+        // 압축 파일은 풀린 크기를 모르므로 색인이 덮는 범위로 셈
+        if (size != UINT64_MAX)  stats_.bytesTotal += size;
+        else if (!blocks.empty()) stats_.bytesTotal += blocks.back().offset + blocks.back().length;
+
+        std::uint64_t pos = 0;
+        for (const auto& b : blocks) {
+            if (b.offset > pos) scan(reader, pos, b.offset - pos, true);   // 색인이 없는 구간
+            pos = b.offset + b.length;
+            if (b.maxNs < opt_.fromNs || b.minNs > opt_.toNs || (b.levels & wantMask_) == 0) {
+                ++stats_.skipped;
+                continue;
+            }
+            const bool whole = b.minNs >= opt_.fromNs && b.maxNs <= opt_.toNs && (b.levels & ~wantMask_) == 0;
+            scan(reader, b.offset, b.length, !whole);
+        }
+        if (pos < size) scan(reader, pos, size - pos, true);   // 마지막 flush 이후(압축 파일은 EOF까지)
+        return 0;
+    }
+
+private:
+    // [offset, offset+len) 읽기. filter면 줄 단위로 거르고 아니면 그대로 출력(블록은 레코드 경계에서 시작/끝)
+    void scan(js::LogFileReader& reader, std::uint64_t offset, std::uint64_t len, bool filter) {
+        if (!reader.skipTo(offset)) return;
+        carry_.clear();
+        filter_.reset();
+        while (len > 0) {
+            const std::size_t want = static_cast<std::size_t>(std::min<std::uint64_t>(len, kChunk));
+            const std::size_t base = carry_.size();
+            carry_.resize(base + want);
+            const std::size_t got = reader.read(&carry_[base], want);
+            carry_.resize(base + got);
+            if (got == 0) break;
+            stats_.bytesRead += got;
+            len -= got;
+            if (!filter) {
+                std::fwrite(carry_.data(), 1, carry_.size(), stdout);
+                carry_.clear();
+                continue;
+            }
+            std::size_t start = 0;
+            for (;;) {
+                const char* nl = static_cast<const char*>(
+                    std::memchr(carry_.data() + start, '\n', carry_.size() - start));
+                if (!nl) break;
+                const std::size_t end = static_cast<std::size_t>(nl - carry_.data()) + 1;
+                if (filter_.keep(carry_.data() + start, end - start)) {
+                    std::fwrite(carry_.data() + start, 1, end - start, stdout);
+                }
+                start = end;
+            }
+            carry_.erase(0, start);
+        }
+        // 줄바꿈 없이 끝난 마지막 줄(기록 중이던 파일)
+        if (!carry_.empty() && (!filter || filter_.keep(carry_.data(), carry_.size()))) {
+            std::fwrite(carry_.data(), 1, carry_.size(), stdout);
+            std::fputc('\n', stdout);
+        }
+        carry_.clear();
+    }
+
+    static constexpr std::size_t kChunk = 1024 * 1024;
+
+    const Options& opt_;
+    LineFilter filter_;
+    std::uint16_t wantMask_ = 0;
+    std::string carry_;
+    Stats stats_;
+};
+
+bool exists(const std::string& p) {
+    std::error_code ec;
+    return std::filesystem::exists(p, ec);
+}
+
+// 회전 묶음(오래된 것부터): shift는 base.N … base.1, base / index는 번호 순(base 링크 제외)
+std::vector<std::string> rotatedSet(const std::string& base, std::size_t maxFiles, js::RotateNaming naming) {
+    std::vector<std::string> out;
+    if (naming == js::RotateNaming::index) {
+        for (const auto& f : js::RotationWorker::scanIndexed(base)) out.push_back(f.path);
+        return out;
+    }
+    constexpr js::RotateCompress variants[] = {js::RotateCompress::none, js::RotateCompress::gzip,
+                                               js::RotateCompress::zstd};
+    for (std::size_t i = maxFiles; i >= 1; --i) {
+        for (auto c : variants) {
+            std::string p = js::RotationWorker::backupName(base, i, c);
+            if (exists(p)) {
+                out.push_back(p);
+                break;
+            }
+        }
+    }
+    if (exists(base)) out.push_back(base);
+    return out;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    std::string ini, section = "Log", from, to;
+    int timeMode = -1;  // -1: INI/기본, 0: local, 1: utc
+    bool alerts = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) { usage(); std::exit(2); }
+            return argv[++i];
+        };
+        if (a == "--ini") ini = next();
+        else if (a == "--section") section = next();
+        else if (a == "--alerts") alerts = true;
+        else if (a == "--utc") timeMode = 1;
+        else if (a == "--local") timeMode = 0;
+        else if (a == "--from") from = next();
+        else if (a == "--to") to = next();
+        else if (a == "--stats") opt.stats = true;
+        else if (a == "--level") {
+            std::string v = next();
+            opt.minLevel = parseLevel(v);
+            if (opt.minLevel < 0) {
+                std::cerr << "j2_log_query: invalid --level: " << v << "\n";
+                return 2;
+            }
+        }
+        else if (a == "-h" || a == "--help") { usage(); return 0; }
+        else if (a.size() > 1 && a[0] == '-') { usage(); return 2; }
+        else opt.files.push_back(a);
+    }
+    if (opt.files.empty() && ini.empty()) { usage(); return 2; }
+
+    if (!ini.empty()) {
+        CSimpleIniA cfg;
+        cfg.SetUnicode();
+        if (cfg.LoadFile(ini.c_str()) < 0) {
+            std::cerr << "j2_log_query: failed to load " << ini << "\n";
+            return 2;
+        }
+        std::string tm = cfg.GetValue(section.c_str(), "TIME_MODE", "local");
+        opt.utc = (tm == "utc" || tm == "UTC");
+        if (opt.files.empty()) {
+            const std::string base = cfg.GetValue(section.c_str(), alerts ? "ALERTS_PATH" : "ALL_PATH",
+                                                  alerts ? "logs/alerts.log" : "logs/all.log");
+            const long maxFiles = cfg.GetLongValue(section.c_str(), alerts ? "ALERT_MAX_FILES" : "ALL_MAX_FILES",
+                                                   alerts ? 10 : 5);
+            std::string naming = cfg.GetValue(section.c_str(), "ROTATE_NAMING", "shift");
+            for (auto& c : naming) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            opt.files = rotatedSet(base, maxFiles > 0 ? static_cast<std::size_t>(maxFiles) : 0,
+                                   naming == "index" ? js::RotateNaming::index : js::RotateNaming::shift);
+            if (opt.files.empty()) {
+                std::cerr << "j2_log_query: no log files for " << base << "\n";
+                return 1;
+            }
+        }
+    }
+    if (timeMode >= 0) opt.utc = (timeMode == 1);
+
+    if (!from.empty() && !jt::parseTime(from, opt.utc, opt.fromNs)) {
+        std::cerr << "j2_log_query: invalid --from: " << from << "\n";
+        usage();
+        return 2;
+    }
+    if (!to.empty()) {
+        if (!jt::parseTime(to, opt.utc, opt.toNs)) {
+            std::cerr << "j2_log_query: invalid --to: " << to << "\n";
+            usage();
+            return 2;
+        }
+        opt.toNs += 999999999LL;  // 초 단위 입력: 해당 초 끝까지 포함
+    }
+
+    Query q(opt);
+    int rc = 0;
+    for (const auto& f : opt.files) rc |= q.run(f);
+    std::fflush(stdout);
+
+    if (opt.stats) {
+        const Stats& s = q.stats();
+        std::cerr << "j2_log_query: files " << s.files << ", index blocks " << s.blocks << " (skipped "
+                  << s.skipped << "), read " << s.bytesRead << " of " << s.bytesTotal << " bytes\n";
+    }
+    return rc;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cctype>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// 도구 공용 시각 해석(j2_log_decode, j2_log_query의 --from/--to)
+namespace j2 {
+namespace tools {
+
+// 1970-01-01 기준 일수(그레고리력)
+inline std::int64_t daysFromCivil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+// "YYYY-MM-DD HH:MM:SS" / "YYYY-MM-DDTHH:MM:SS" / epoch 초 → ns (범위를 벗어나면 false)
+inline bool parseTime(const std::string& s, bool utc, std::int64_t& ns) {
+    // --to 는 999999999ns를 더하므로 1초 여유
+    constexpr std::int64_t kMaxSecs = std::numeric_limits<std::int64_t>::max() / 1000000000LL - 1;
+    bool digits = !s.empty();
+    for (unsigned char c : s) digits &= (std::isdigit(c) != 0);
+    if (digits) {
+        long long secs = 0;
+        try {
+            secs = std::stoll(s);
+        } catch (const std::exception&) {
+            return false;
+        }
+        if (secs > kMaxSecs) return false;
+        ns = static_cast<std::int64_t>(secs) * 1000000000LL;
+        return true;
+    }
+
+    std::string v = s;
+    for (auto& c : v) if (c == 'T') c = ' ';
+    std::tm tm{};
+    std::istringstream in(v);
+    in >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (in.fail()) {
+        in.clear();
+        in.str(v);
+        tm = std::tm{};
+        in >> std::get_time(&tm, "%Y-%m-%d");
+        if (in.fail()) return false;
+    }
+    std::int64_t t = 0;
+    if (utc) {
+        // timegm은 표준이 아님(MSVC 없음)
+        t = daysFromCivil(tm.tm_year + 1900, static_cast<unsigned>(tm.tm_mon + 1),
+                          static_cast<unsigned>(tm.tm_mday)) * 86400 +
+            tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+    } else {
+        tm.tm_isdst = -1;
+        const std::time_t lt = std::mktime(&tm);
+        if (lt == static_cast<std::time_t>(-1)) return false;
+        t = static_cast<std::int64_t>(lt);
+    }
+    if (t > kMaxSecs || t < -kMaxSecs) return false;
+    ns = t * 1000000000LL;
+    return true;
+}
+
+} // namespace tools
+} // namespace j2